@@ -0,0 +1,188 @@
+#include "AnalogSensors.h"
+
+static_assert((ANALOG_SENSORS_RING & (ANALOG_SENSORS_RING - 1)) == 0 && ANALOG_SENSORS_RING <= 128,
+              "ANALOG_SENSORS_RING must be a power of two up to 128");
+static_assert(ANALOG_SENSORS_MEDIAN >= 1 && ANALOG_SENSORS_MEDIAN <= ANALOG_SENSORS_RING,
+              "ANALOG_SENSORS_MEDIAN must fit in the ring");
+
+std::atomic<bool> AnalogSensors::frameReady{false};
+
+// --- setup -------------------------------------------------------------------
+
+int8_t AnalogSensors::addChannel(uint8_t pin, uint16_t lowThreshold, uint16_t highThreshold, uint8_t smoothingShift) {
+  if (channelCount >= ANALOG_SENSORS_MAX_CHANNELS || started) return -1;
+  Channel& c = channels[channelCount];
+  c = Channel();
+  c.pin   = pin;
+  c.level = Level::Unknown;
+  const int8_t id = (int8_t)channelCount++;
+  setThresholds(id, lowThreshold, highThreshold);
+  setSmoothing(id, smoothingShift);
+  return id;
+}
+
+bool AnalogSensors::begin(uint32_t sampleHz) {
+  if (!channelCount) return false;
+  started = true;
+#if ANALOG_SENSORS_DMA
+  uint8_t pins[ANALOG_SENSORS_MAX_CHANNELS];
+  for (uint8_t i = 0; i < channelCount; ++i) pins[i] = channels[i].pin;
+  // The driver's rate is total conversions per second, shared by all channels
+  uint32_t hz = sampleHz * channelCount;
+  hz = constrain(hz, (uint32_t)SOC_ADC_SAMPLE_FREQ_THRES_LOW, (uint32_t)SOC_ADC_SAMPLE_FREQ_THRES_HIGH);
+  framePeriodUs = uint32_t(1000000ULL * ANALOG_SENSORS_CONVERSIONS * channelCount / hz);
+  if (analogContinuous(pins, channelCount, ANALOG_SENSORS_CONVERSIONS, hz, &AnalogSensors::onFrame) &&
+      analogContinuousStart()) {
+    dmaRunning  = true;
+    lastDrainUs = micros();
+  } else {
+    analogContinuousDeinit();          // e.g. a pin on ADC2: poll instead
+  }
+#else
+  (void)sampleHz;
+#endif
+  return dmaRunning;
+}
+
+void AnalogSensors::end() {
+#if ANALOG_SENSORS_DMA
+  if (dmaRunning) {
+    analogContinuousStop();
+    analogContinuousDeinit();
+  }
+#endif
+  dmaRunning = false;
+  started    = false;
+}
+
+void AnalogSensors::setThresholds(uint8_t channel, uint16_t lowThreshold, uint16_t highThreshold) {
+  if (channel >= channelCount) return;
+  Channel& c = channels[channel];
+  c.lowThreshold  = min(lowThreshold, highThreshold);
+  c.highThreshold = max(lowThreshold, highThreshold);
+}
+
+void AnalogSensors::setSmoothing(uint8_t channel, uint8_t shift) {
+  if (channel >= channelCount) return;
+  channels[channel].shift = min<uint8_t>(shift, 8);
+}
+
+void AnalogSensors::setEventHandler(EventFn fn, void* ctx) {
+  eventFn  = fn;
+  eventCtx = ctx;
+}
+
+// --- acquisition -----------------------------------------------------------------
+
+void IRAM_ATTR AnalogSensors::onFrame() {
+  frameReady.store(true, std::memory_order_release);
+}
+
+bool AnalogSensors::push(Channel& c, uint16_t sample) {
+  if (uint8_t(c.head - c.tail) >= ANALOG_SENSORS_RING) { c.overruns++; return false; }
+  c.ring[c.head & (ANALOG_SENSORS_RING - 1)] = sample;
+  c.head++;
+  return true;
+}
+
+bool AnalogSensors::inject(uint8_t channel, const uint16_t* samples, uint16_t count) {
+  if (channel >= channelCount) return false;
+  for (uint16_t i = 0; i < count; ++i) {
+    if (!push(channels[channel], samples[i])) return false;
+  }
+  return true;
+}
+
+void AnalogSensors::readDmaFrames() {
+#if ANALOG_SENSORS_DMA
+  if (!frameReady.exchange(false, std::memory_order_acquire)) return;
+  const uint32_t now = micros();
+  uint32_t frames = 0;
+  adc_continuous_data_t* frame = nullptr;
+  while (analogContinuousRead(&frame, 0) && frame != nullptr) {
+    frames++;
+    // One driver-averaged result per pin; match by pin rather than trusting the order
+    for (uint8_t j = 0; j < channelCount; ++j) {
+      for (uint8_t i = 0; i < channelCount; ++i) {
+        if (channels[i].pin == frame[j].pin) { push(channels[i], (uint16_t)frame[j].avg_read_mv); break; }
+      }
+    }
+  }
+  // Frames converted since the last drain that never reached us were dropped by the driver
+  const uint32_t converted = (now - lastDrainUs) / framePeriodUs;
+  if (converted > frames) {
+    for (uint8_t i = 0; i < channelCount; ++i) channels[i].overruns += converted - frames;
+  }
+  lastDrainUs = now;
+#endif
+}
+
+void AnalogSensors::service() {
+  if (dmaRunning) {
+    readDmaFrames();
+  } else if (started) {
+    for (uint8_t i = 0; i < channelCount; ++i) {
+#if defined(ARDUINO_ARCH_ESP32)
+      push(channels[i], (uint16_t)analogReadMilliVolts(channels[i].pin));
+#else
+      push(channels[i], (uint16_t)analogRead(channels[i].pin));
+#endif
+    }
+  }
+
+  for (uint8_t i = 0; i < channelCount; ++i) {
+    Channel& c = channels[i];
+    while (uint8_t(c.head - c.tail) >= ANALOG_SENSORS_MEDIAN) filterBatch(i, c);
+  }
+}
+
+// --- filtering -----------------------------------------------------------------
+
+void AnalogSensors::filterBatch(uint8_t index, Channel& c) {
+  // Median of the batch: a single spike (valve switching, pump start) never reaches the IIR
+  uint16_t batch[ANALOG_SENSORS_MEDIAN];
+  for (uint8_t n = 0; n < ANALOG_SENSORS_MEDIAN; ++n) {
+    const uint16_t v = c.ring[c.tail & (ANALOG_SENSORS_RING - 1)];
+    c.tail++;
+    uint8_t k = n;
+    while (k > 0 && batch[k - 1] > v) { batch[k] = batch[k - 1]; --k; }
+    batch[k] = v;
+  }
+  const int32_t median = (int32_t)batch[ANALOG_SENSORS_MEDIAN / 2] << 8;
+
+  // IIR in Q8: y += (x - y) / 2^shift
+  if (!c.primed) { c.iir = median; c.primed = true; }
+  else           c.iir += (median - c.iir) >> c.shift;
+  c.value = (uint16_t)((c.iir + 128) >> 8);
+
+  // Schmitt trigger between the two thresholds
+  Level next = c.level;
+  if (c.value >= c.highThreshold)      next = Level::High;
+  else if (c.value <= c.lowThreshold)  next = Level::Low;
+  else if (next == Level::Unknown)     next = (c.value >= (c.lowThreshold + c.highThreshold) / 2) ? Level::High : Level::Low;
+  if (next == c.level) return;
+
+  const bool first = (c.level == Level::Unknown);
+  c.level = next;
+  if (first) return;                   // initial reading, not a change
+  c.events++;
+  if (eventFn) eventFn(eventCtx, index, next);
+}
+
+// --- published results -----------------------------------------------------------
+
+uint16_t AnalogSensors::getValue(uint8_t channel) const {
+  return (channel < channelCount) ? channels[channel].value : 0;
+}
+
+AnalogSensors::Level AnalogSensors::getLevel(uint8_t channel) const {
+  return (channel < channelCount) ? channels[channel].level : Level::Unknown;
+}
+
+uint32_t AnalogSensors::getEventCount(uint8_t channel) const {
+  return (channel < channelCount) ? channels[channel].events : 0;
+}
+
+uint32_t AnalogSensors::getOverruns(uint8_t channel) const {
+  return (channel < channelCount) ? channels[channel].overruns : 0;
+}
@@ -0,0 +1,98 @@
+#ifndef ANALOG_SENSORS_H
+#define ANALOG_SENSORS_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#if defined(ARDUINO_ARCH_ESP32) && __has_include(<soc/soc_caps.h>)
+  #include <soc/soc_caps.h>
+#endif
+#ifndef ANALOG_SENSORS_DMA
+  #if defined(ARDUINO_ARCH_ESP32) && ESP_ARDUINO_VERSION_MAJOR >= 3 && defined(SOC_ADC_DMA_SUPPORTED) && SOC_ADC_DMA_SUPPORTED
+    #define ANALOG_SENSORS_DMA 1   // analogContinuous(): ADC sampled by DMA, no loop-side conversions
+  #else
+    #define ANALOG_SENSORS_DMA 0   // polled analogRead() per service() call (2.x core / other boards)
+  #endif
+#endif
+
+#define ANALOG_SENSORS_MAX_CHANNELS 4
+#define ANALOG_SENSORS_RING         16 // samples buffered per channel between service() calls
+#define ANALOG_SENSORS_MEDIAN       5  // batch size: one median-of-N per published update (decimation)
+#define ANALOG_SENSORS_CONVERSIONS  16 // DMA conversions averaged by the driver into one sample
+
+/**
+ * Continuously sampled analog inputs (line pressure, soil moisture) for valve conditions.
+ * - ESP32 3.x: every channel is sampled by the ADC in DMA mode; the conversion-done
+ *   callback only raises a flag, service() moves every finished frame into per-channel rings.
+ *   The core's driver holds two frames (one per 8 ms at 2 kHz): frames it had to drop
+ *   because service() came too late are counted as overruns.
+ * - service() filters in batches: median of ANALOG_SENSORS_MEDIAN samples (spike rejection),
+ *   then a fixed-point IIR, then publishes value and threshold level (with hysteresis).
+ * - Readers (Valve, menu, control loop) only load the published value/level: O(1), no ADC access.
+ * - Samples are millivolts on ESP32 (driver calibrated), raw counts elsewhere.
+ * - inject() feeds recorded samples through the same path, to replay a capture on a bench
+ *   board or with the ADC not started.
+ */
+class AnalogSensors {
+public:
+  enum class Level : uint8_t { Unknown, Low, High };
+  typedef void (*EventFn)(void* ctx, uint8_t channel, Level level);
+
+  // Channel index, or -1 when the table is full. Level goes High above highThreshold, Low below lowThreshold.
+  int8_t addChannel(uint8_t pin, uint16_t lowThreshold, uint16_t highThreshold, uint8_t smoothingShift = 3);
+  bool   begin(uint32_t sampleHz = 2000);   // per channel; false = no DMA, service() polls instead
+  void   end();
+  void   service();                         // call from a scheduler task / loop()
+
+  void setThresholds(uint8_t channel, uint16_t lowThreshold, uint16_t highThreshold);
+  void setSmoothing(uint8_t channel, uint8_t shift); // IIR weight 1/2^shift per median batch (0 = none)
+  void setEventHandler(EventFn fn, void* ctx);       // level changes, called from service()
+
+  bool inject(uint8_t channel, const uint16_t* samples, uint16_t count); // false = ring full, rest dropped
+
+  // --- published results (O(1)) ---
+  uint16_t getValue(uint8_t channel) const;          // filtered
+  Level    getLevel(uint8_t channel) const;
+  uint32_t getEventCount(uint8_t channel) const;     // level changes since begin()
+  uint32_t getOverruns(uint8_t channel) const;       // samples lost to a full ring or driver (service() too slow)
+  uint8_t  getChannelCount() const { return channelCount; }
+  bool     usesDma() const { return dmaRunning; }
+
+private:
+  struct Channel {
+    uint8_t  pin;
+    uint16_t lowThreshold;
+    uint16_t highThreshold;
+    uint8_t  shift;
+    // Ring: written by push(), drained by service()
+    uint16_t ring[ANALOG_SENSORS_RING];
+    uint8_t  head;
+    uint8_t  tail;
+    uint32_t overruns;
+    // Filter state
+    int32_t  iir;                       // value << 8
+    bool     primed;                    // first batch seeds the IIR
+    // Published
+    uint16_t value;
+    Level    level;
+    uint32_t events;
+  };
+
+  bool push(Channel& c, uint16_t sample);
+  void filterBatch(uint8_t index, Channel& c);
+  void readDmaFrames();
+  static void onFrame();                // conversion-done callback (ISR context)
+
+  Channel  channels[ANALOG_SENSORS_MAX_CHANNELS];
+  uint8_t  channelCount = 0;
+  bool     started      = false;        // begin() called: DMA or polled sampling
+  bool     dmaRunning   = false;
+  uint32_t framePeriodUs = 0;           // one DMA frame: ANALOG_SENSORS_CONVERSIONS per channel
+  uint32_t lastDrainUs   = 0;
+  EventFn  eventFn      = nullptr;
+  void*    eventCtx     = nullptr;
+
+  static std::atomic<bool> frameReady;  // one continuous ADC per chip, so one flag
+};
+
+#endif // ANALOG_SENSORS_H
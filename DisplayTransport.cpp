@@ -0,0 +1,188 @@
+#include "DisplayTransport.h"
+
+#define SSD1306_CTRL_CMD_STREAM  0x00 // Co = 0, D/C = 0: every following byte is a command
+#define SSD1306_CTRL_CMD_SINGLE  0x80 // Co = 1, D/C = 0: one command, another control byte follows
+#define SSD1306_CTRL_DATA_STREAM 0x40 // Co = 0, D/C = 1: every following byte is GDDRAM data
+
+// --- framing ---------------------------------------------------------------
+
+bool DisplayTransport::sendCommands(const uint8_t* cmds, uint8_t count) {
+  static const uint8_t ctrl = SSD1306_CTRL_CMD_STREAM;
+  const uint16_t chunkMax = maxPayload ? uint16_t(maxPayload - 1) : count;
+  bool ok = true;
+  while (count) {
+    const uint8_t n = (uint8_t)min<uint16_t>(count, chunkMax);
+    const DisplaySpan segments[] = { { &ctrl, 1 }, { cmds, n } };
+    ok &= send(segments, 2);
+    cmds  += n;
+    count -= n;
+  }
+  return ok;
+}
+
+bool DisplayTransport::sendWindow(const uint8_t* cmds, uint8_t cmdCount, const DisplaySpan* spans, uint8_t spanCount) {
+  if (cmdCount > DISPLAY_TRANSPORT_MAX_CMDS || spanCount >= DISPLAY_TRANSPORT_MAX_SEGMENTS) return false;
+
+  uint32_t dataLen = 0;
+  for (uint8_t i = 0; i < spanCount; ++i) dataLen += spans[i].len;
+
+  if (maxPayload == 0 || 2u * cmdCount + 1 + dataLen <= maxPayload) {
+    // One transaction: 0x80 before each command, then one 0x40 and the whole window
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < cmdCount; ++i) {
+      header[n++] = SSD1306_CTRL_CMD_SINGLE;
+      header[n++] = cmds[i];
+    }
+    header[n++] = SSD1306_CTRL_DATA_STREAM;
+
+    DisplaySpan segments[DISPLAY_TRANSPORT_MAX_SEGMENTS];
+    uint8_t count = 0;
+    segments[count++] = { header, n };
+    for (uint8_t i = 0; i < spanCount; ++i) {
+      if (spans[i].len) segments[count++] = spans[i];
+    }
+    return send(segments, count);
+  }
+
+  // Small bus buffer: command transaction, then the data in 0x40-prefixed chunks
+  static const uint8_t ctrl = SSD1306_CTRL_DATA_STREAM;
+  const uint16_t chunkMax = uint16_t(maxPayload - 1);
+  bool ok = sendCommands(cmds, cmdCount);
+  for (uint8_t i = 0; i < spanCount; ++i) {
+    const uint8_t* src  = spans[i].data;
+    uint16_t       left = spans[i].len;
+    while (left) {
+      const uint16_t n = min<uint16_t>(left, chunkMax);
+      const DisplaySpan segments[] = { { &ctrl, 1 }, { src, n } };
+      ok &= send(segments, 2);
+      src  += n;
+      left -= n;
+    }
+  }
+  return ok;
+}
+
+bool DisplayTransport::send(const DisplaySpan* segments, uint8_t count) {
+  uint32_t bytes = 1; // address byte
+  for (uint8_t i = 0; i < count; ++i) bytes += segments[i].len;
+  transactions++;
+  bytesWritten += bytes;
+  if (transmit(segments, count)) return true;
+  failures++;
+  return false;
+}
+
+// --- Arduino Wire ------------------------------------------------------------
+
+#ifdef I2C_BUFFER_LENGTH
+  #define WIRE_TRANSPORT_PAYLOAD I2C_BUFFER_LENGTH
+#else
+  #define WIRE_TRANSPORT_PAYLOAD 32
+#endif
+
+WireDisplayTransport::WireDisplayTransport(TwoWire& w, uint32_t hz)
+  : DisplayTransport(WIRE_TRANSPORT_PAYLOAD),
+    wire(w),
+    clockHz(min<uint32_t>(hz, DISPLAY_TRANSPORT_MAX_HZ)) {}
+
+bool WireDisplayTransport::begin(uint8_t a) {
+  addr = a;
+  wire.setClock(clockHz); // Adafruit_SSD1306 leaves the bus at 100 kHz after its own writes
+  return true;
+}
+
+void WireDisplayTransport::setClock(uint32_t hz) {
+  clockHz = min<uint32_t>(hz, DISPLAY_TRANSPORT_MAX_HZ);
+  wire.setClock(clockHz);
+}
+
+bool WireDisplayTransport::transmit(const DisplaySpan* segments, uint8_t count) {
+  wire.beginTransmission(addr);
+  for (uint8_t i = 0; i < count; ++i) wire.write(segments[i].data, segments[i].len);
+  return wire.endTransmission() == 0;
+}
+
+// --- ESP-IDF I2C master ------------------------------------------------------
+
+#define IDF_TRANSPORT_TIMEOUT_MS 50 // a full 1 KB frame takes ~10 ms at 1 MHz, ~25 ms at 400 kHz
+
+IdfI2cDisplayTransport::IdfI2cDisplayTransport(uint8_t sda, uint8_t scl, uint32_t hz, uint8_t p)
+  : DisplayTransport(0),
+    sdaPin(sda),
+    sclPin(scl),
+    clockHz(min<uint32_t>(hz, DISPLAY_TRANSPORT_MAX_HZ)),
+    port(p) {}
+
+IdfI2cDisplayTransport::~IdfI2cDisplayTransport() {
+  if (!ready) return;
+#if DISPLAY_TRANSPORT_IDF == 2
+  i2c_master_bus_rm_device(device);
+  i2c_del_master_bus(bus);
+#elif DISPLAY_TRANSPORT_IDF == 1
+  i2c_driver_delete((i2c_port_t)port);
+#endif
+}
+
+bool IdfI2cDisplayTransport::begin(uint8_t a) {
+  addr = a;
+  if (ready) return true;
+#if DISPLAY_TRANSPORT_IDF == 2 && DISPLAY_TRANSPORT_MULTI_BUFFER
+  i2c_master_bus_config_t busConfig = {};
+  busConfig.i2c_port          = (i2c_port_num_t)port;
+  busConfig.sda_io_num        = (gpio_num_t)sdaPin;
+  busConfig.scl_io_num        = (gpio_num_t)sclPin;
+  busConfig.clk_source        = I2C_CLK_SRC_DEFAULT;
+  busConfig.glitch_ignore_cnt = 7;
+  busConfig.flags.enable_internal_pullup = true;
+  if (i2c_new_master_bus(&busConfig, &bus) != ESP_OK) return false;
+
+  i2c_device_config_t devConfig = {};
+  devConfig.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+  devConfig.device_address  = addr;
+  devConfig.scl_speed_hz    = clockHz;
+  if (i2c_master_bus_add_device(bus, &devConfig, &device) != ESP_OK) {
+    i2c_del_master_bus(bus);
+    bus = nullptr;
+    return false;
+  }
+  ready = true;
+#elif DISPLAY_TRANSPORT_IDF == 1
+  i2c_config_t config = {};
+  config.mode             = I2C_MODE_MASTER;
+  config.sda_io_num       = sdaPin;
+  config.scl_io_num       = sclPin;
+  config.sda_pullup_en    = GPIO_PULLUP_ENABLE;
+  config.scl_pullup_en    = GPIO_PULLUP_ENABLE;
+  config.master.clk_speed = clockHz;
+  if (i2c_param_config((i2c_port_t)port, &config) != ESP_OK) return false;
+  ready = (i2c_driver_install((i2c_port_t)port, config.mode, 0, 0, 0) == ESP_OK);
+#endif
+  return ready;
+}
+
+bool IdfI2cDisplayTransport::transmit(const DisplaySpan* segments, uint8_t count) {
+  if (!ready) return false;
+#if DISPLAY_TRANSPORT_IDF == 2 && DISPLAY_TRANSPORT_MULTI_BUFFER
+  i2c_master_transmit_multi_buffer_info_t buffers[DISPLAY_TRANSPORT_MAX_SEGMENTS];
+  for (uint8_t i = 0; i < count; ++i) {
+    buffers[i].write_buffer = const_cast<uint8_t*>(segments[i].data);
+    buffers[i].buffer_size  = segments[i].len;
+  }
+  return i2c_master_transmit_multi_buffer(device, buffers, count, IDF_TRANSPORT_TIMEOUT_MS) == ESP_OK;
+#elif DISPLAY_TRANSPORT_IDF == 1
+  // Static command link: the driver keeps pointers to the segments, no heap per frame
+  i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(linkBuffer, sizeof(linkBuffer));
+  if (cmd == nullptr) return false;
+  i2c_master_start(cmd);
+  i2c_master_write_byte(cmd, uint8_t((addr << 1) | I2C_MASTER_WRITE), true);
+  for (uint8_t i = 0; i < count; ++i) i2c_master_write(cmd, segments[i].data, segments[i].len, true);
+  i2c_master_stop(cmd);
+  const esp_err_t result = i2c_master_cmd_begin((i2c_port_t)port, cmd, pdMS_TO_TICKS(IDF_TRANSPORT_TIMEOUT_MS));
+  i2c_cmd_link_delete_static(cmd);
+  return result == ESP_OK;
+#else
+  (void)segments;
+  (void)count;
+  return false;
+#endif
+}
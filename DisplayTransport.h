@@ -0,0 +1,129 @@
+#ifndef DISPLAY_TRANSPORT_H
+#define DISPLAY_TRANSPORT_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#if defined(ARDUINO_ARCH_ESP32) && ESP_ARDUINO_VERSION_MAJOR >= 3 && __has_include(<driver/i2c_master.h>)
+  #include <driver/i2c_master.h>
+  #include <esp_idf_version.h>
+  #define DISPLAY_TRANSPORT_IDF 2   // i2c_master driver (the one Wire uses on 3.x)
+  #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+    #define DISPLAY_TRANSPORT_MULTI_BUFFER 1 // i2c_master_transmit_multi_buffer()
+  #endif
+#elif defined(ARDUINO_ARCH_ESP32) && __has_include(<driver/i2c.h>)
+  #include <driver/i2c.h>
+  #define DISPLAY_TRANSPORT_IDF 1   // legacy cmd-link driver (2.x core)
+#else
+  #define DISPLAY_TRANSPORT_IDF 0
+#endif
+
+#ifndef DISPLAY_TRANSPORT_MULTI_BUFFER
+  #define DISPLAY_TRANSPORT_MULTI_BUFFER 0
+#endif
+
+#define DISPLAY_TRANSPORT_MAX_CMDS     8  // commands in front of one data window
+#define DISPLAY_TRANSPORT_MAX_SEGMENTS 10 // header + one span per display page + spare
+#define DISPLAY_TRANSPORT_MAX_HZ       1000000
+
+/** Contiguous run of bytes taken straight from the frame buffer. */
+struct DisplaySpan {
+  const uint8_t* data;
+  uint16_t       len;
+};
+
+/**
+ * SSD1306 byte transport used by Menu for every panel write.
+ * - sendWindow() frames an address-window command list and its GDDRAM data as
+ *   one START..STOP when the bus allows it: each command behind a 0x80 control
+ *   byte, then a single 0x40 and all data. Buses with a small buffer fall back
+ *   to one command transaction plus 0x40-prefixed chunks.
+ * - Spans point into the frame buffer; nothing is copied on the way to the bus.
+ * - Transaction/byte counters (bytes include the address byte) make the framing
+ *   cost visible; CountingDisplayTransport measures without a panel.
+ */
+class DisplayTransport {
+public:
+  virtual ~DisplayTransport() {}
+
+  virtual bool begin(uint8_t addr) = 0;   // bus up, clock set; false = unusable
+  bool sendCommands(const uint8_t* cmds, uint8_t count);
+  bool sendWindow(const uint8_t* cmds, uint8_t cmdCount, const DisplaySpan* spans, uint8_t spanCount);
+
+  uint32_t getTransactionCount() const { return transactions; }
+  uint32_t getBytesWritten()     const { return bytesWritten; }
+  uint32_t getFailureCount()     const { return failures; }
+  void     resetCounters()             { transactions = 0; bytesWritten = 0; failures = 0; }
+
+protected:
+  explicit DisplayTransport(uint16_t payload) : maxPayload(payload) {}
+  virtual bool transmit(const DisplaySpan* segments, uint8_t count) = 0; // one START..STOP to addr
+
+  uint8_t  addr = 0x3C;
+
+private:
+  bool send(const DisplaySpan* segments, uint8_t count);
+
+  uint16_t maxPayload;                 // bytes per transaction after the address, 0 = unlimited
+  uint8_t  header[DISPLAY_TRANSPORT_MAX_CMDS * 2 + 1];
+  uint32_t transactions = 0;
+  uint32_t bytesWritten = 0;
+  uint32_t failures     = 0;
+};
+
+/** Arduino Wire: transactions limited to the Wire buffer; Menu's default. Call wire.begin() first. */
+class WireDisplayTransport : public DisplayTransport {
+public:
+  explicit WireDisplayTransport(TwoWire& wire, uint32_t clockHz = 400000);
+  bool begin(uint8_t addr) override;
+  void setClock(uint32_t hz);
+
+protected:
+  bool transmit(const DisplaySpan* segments, uint8_t count) override;
+
+private:
+  TwoWire& wire;
+  uint32_t clockHz;
+};
+
+/**
+ * ESP-IDF I2C master driver used directly: whole windows (up to the full 1 KB frame)
+ * in one transaction, clock up to 1 MHz.
+ * - Owns its port: do not Wire.begin() on the same port; move other I2C parts to Wire1.
+ * - begin() returns false where the driver can't do multi-buffer writes
+ *   (3.x core older than IDF 5.3); Menu then stays on Wire.
+ */
+class IdfI2cDisplayTransport : public DisplayTransport {
+public:
+  IdfI2cDisplayTransport(uint8_t sdaPin, uint8_t sclPin, uint32_t clockHz = DISPLAY_TRANSPORT_MAX_HZ, uint8_t port = 0);
+  ~IdfI2cDisplayTransport();
+  bool begin(uint8_t addr) override;
+
+protected:
+  bool transmit(const DisplaySpan* segments, uint8_t count) override;
+
+private:
+  uint8_t  sdaPin;
+  uint8_t  sclPin;
+  uint32_t clockHz;
+  uint8_t  port;
+  bool     ready = false;
+#if DISPLAY_TRANSPORT_IDF == 2
+  i2c_master_bus_handle_t bus    = nullptr;
+  i2c_master_dev_handle_t device = nullptr;
+#elif DISPLAY_TRANSPORT_IDF == 1
+  uint8_t linkBuffer[I2C_LINK_RECOMMENDED_SIZE(DISPLAY_TRANSPORT_MAX_SEGMENTS + 3)]; // + start, address, stop
+#endif
+};
+
+/** Discards the bytes and only counts them; maxPayload 0 models the IDF transport, 32/128 models Wire. */
+class CountingDisplayTransport : public DisplayTransport {
+public:
+  explicit CountingDisplayTransport(uint16_t payload = 0) : DisplayTransport(payload) {}
+  bool begin(uint8_t a) override { addr = a; return true; }
+
+protected:
+  bool transmit(const DisplaySpan*, uint8_t) override { return true; }
+};
+
+#endif // DISPLAY_TRANSPORT_H
@@ -0,0 +1,137 @@
+#include "FlowMeter.h"
+
+#if FLOW_METER_HAS_PCNT
+// PCNT counts in a signed 16-bit register; with accum_count the driver folds every
+// limit crossing into the value returned by pcnt_unit_get_count().
+#define FLOW_PCNT_HIGH_LIMIT 30000
+#define FLOW_PCNT_GLITCH_NS  1000   // well under the 100 us period of a 10 kHz pulse train
+#endif
+
+// --- ctor/dtor ---------------------------------------------------------------
+
+FlowMeter::FlowMeter(uint8_t p, uint16_t ppl)
+  : pin(p),
+    pulsesPerLitre(ppl ? ppl : 1) {}
+
+FlowMeter::~FlowMeter() {
+#if FLOW_METER_HAS_PCNT
+  if (pcntUnit) {
+    pcnt_unit_stop(pcntUnit);
+    pcnt_unit_disable(pcntUnit);
+    if (pcntChannel) pcnt_del_channel(pcntChannel);
+    pcnt_del_unit(pcntUnit);
+  }
+#endif
+  if (attached) detachInterrupt(digitalPinToInterrupt(pin));
+}
+
+// --- setup -------------------------------------------------------------------
+
+bool FlowMeter::begin() {
+  pinMode(pin, INPUT_PULLUP);
+
+#if FLOW_METER_HAS_PCNT
+  if (hardwareCounter) return true;   // already counting: a second unit would leak this one
+
+  pcnt_unit_config_t unitCfg = {};
+  unitCfg.low_limit  = -1;
+  unitCfg.high_limit = FLOW_PCNT_HIGH_LIMIT;
+  unitCfg.flags.accum_count = 1;
+
+  pcnt_chan_config_t chanCfg = {};
+  chanCfg.edge_gpio_num  = pin;
+  chanCfg.level_gpio_num = -1;
+
+  pcnt_glitch_filter_config_t filterCfg = {};
+  filterCfg.max_glitch_ns = FLOW_PCNT_GLITCH_NS;
+
+  if (pcnt_new_unit(&unitCfg, &pcntUnit) == ESP_OK &&
+      pcnt_new_channel(pcntUnit, &chanCfg, &pcntChannel) == ESP_OK &&
+      pcnt_channel_set_edge_action(pcntChannel, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_HOLD) == ESP_OK &&
+      pcnt_unit_set_glitch_filter(pcntUnit, &filterCfg) == ESP_OK &&
+      pcnt_unit_add_watch_point(pcntUnit, FLOW_PCNT_HIGH_LIMIT) == ESP_OK &&
+      pcnt_unit_enable(pcntUnit) == ESP_OK &&
+      pcnt_unit_clear_count(pcntUnit) == ESP_OK &&
+      pcnt_unit_start(pcntUnit) == ESP_OK) {
+    hardwareCounter = true;
+  } else {
+    // All units taken (or driver error): release what we got and use the ISR path
+    if (pcntUnit) {
+      pcnt_unit_disable(pcntUnit);    // delete needs it disabled; just an error if enable never ran
+      if (pcntChannel) { pcnt_del_channel(pcntChannel); pcntChannel = nullptr; }
+      pcnt_del_unit(pcntUnit);
+      pcntUnit = nullptr;
+    }
+  }
+#endif
+
+  if (!hardwareCounter) {
+    const int irq = digitalPinToInterrupt(pin);
+    if (irq < 0) return false;
+    if (!attached) attachInterruptArg(irq, &FlowMeter::onPulse, this, RISING);
+    attached = true;
+  }
+
+  rateWindowStartMs    = millis();
+  rateWindowStartCount = getPulseCount();
+  flowRateMlMin        = 0;
+  return true;
+}
+
+void IRAM_ATTR FlowMeter::onPulse(void* arg) {
+  static_cast<FlowMeter*>(arg)->isrCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// --- loop-side service ---------------------------------------------------------
+
+void FlowMeter::service() {
+  const uint32_t now = millis();
+  const uint32_t dt  = now - rateWindowStartMs;
+  if (dt < RATE_WINDOW_MS) return;
+
+  const uint32_t count = getPulseCount();
+  const uint32_t pulses = count - rateWindowStartCount;
+  rateWindowStartMs    = now;
+  rateWindowStartCount = count;
+
+  // mL/min over this window, then a light EWMA (alpha = 1/2) against meter jitter
+  const uint32_t windowRate = (uint32_t)(((uint64_t)pulsesToMillilitres(pulses) * 60000UL) / dt);
+  flowRateMlMin = (flowRateMlMin + windowRate) / 2;
+  if (pulses == 0) flowRateMlMin = 0; // stopped flow should read zero straight away
+}
+
+// --- readings ------------------------------------------------------------------
+
+uint32_t FlowMeter::getPulseCount() const {
+#if FLOW_METER_HAS_PCNT
+  if (hardwareCounter) {
+    int count = 0;
+    pcnt_unit_get_count(pcntUnit, &count);
+    return (uint32_t)count;
+  }
+#endif
+  return isrCount.load(std::memory_order_relaxed);
+}
+
+uint32_t FlowMeter::getMillilitres() const {
+  return pulsesToMillilitres(getPulseCount());
+}
+
+uint32_t FlowMeter::pulsesToMillilitres(uint32_t pulses) const {
+  return (uint32_t)(((uint64_t)pulses * 1000UL) / pulsesPerLitre);
+}
+
+uint32_t FlowMeter::getFlowRate() const { return flowRateMlMin; }
+
+// --- calibration ---------------------------------------------------------------
+
+void FlowMeter::setPulsesPerLitre(uint16_t ppl) { pulsesPerLitre = ppl ? ppl : 1; }
+uint16_t FlowMeter::getPulsesPerLitre() const   { return pulsesPerLitre; }
+
+void FlowMeter::calibrate(uint32_t pulses, uint32_t measuredMillilitres) {
+  if (!measuredMillilitres) return;
+  const uint32_t ppl = (uint32_t)(((uint64_t)pulses * 1000UL + measuredMillilitres / 2) / measuredMillilitres);
+  setPulsesPerLitre(ppl > 0xFFFF ? 0xFFFF : (uint16_t)ppl);
+}
+
+bool FlowMeter::usesHardwareCounter() const { return hardwareCounter; }
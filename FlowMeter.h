@@ -0,0 +1,63 @@
+#ifndef FLOW_METER_H
+#define FLOW_METER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#if defined(ARDUINO_ARCH_ESP32) && __has_include(<driver/pulse_cnt.h>)
+  #include <driver/pulse_cnt.h>
+  #define FLOW_METER_HAS_PCNT 1
+#else
+  #define FLOW_METER_HAS_PCNT 0
+#endif
+
+/**
+ * Hall-effect flow-meter pulse counter.
+ * - ESP32: PCNT hardware unit (glitch filtered, accumulates across its 16-bit limit),
+ *   so pulses keep counting while loop() is busy flushing the display.
+ * - Elsewhere (or when no PCNT unit is free): GPIO interrupt bumping an atomic counter.
+ * - Pulse counts are free-running uint32_t; take differences, they are wrap-safe.
+ */
+class FlowMeter {
+public:
+  FlowMeter(uint8_t pin, uint16_t pulsesPerLitre = 450); // 450 p/L ~ YF-S201
+  ~FlowMeter();
+
+  bool begin();                           // returns false if neither counter could be set up
+  void service();                         // call from loop(): updates the flow-rate estimate
+
+  uint32_t getPulseCount() const;         // total pulses since begin()
+  uint32_t getMillilitres() const;        // total volume since begin()
+  uint32_t pulsesToMillilitres(uint32_t pulses) const;
+  uint32_t getFlowRate() const;           // smoothed estimate in mL/min
+
+  void     setPulsesPerLitre(uint16_t ppl);
+  uint16_t getPulsesPerLitre() const;
+  void     calibrate(uint32_t pulses, uint32_t measuredMillilitres); // from a bucket test
+  bool     usesHardwareCounter() const;
+
+private:
+  static void IRAM_ATTR onPulse(void* arg);
+
+  uint8_t  pin;
+  uint16_t pulsesPerLitre;
+  bool     hardwareCounter = false;
+  bool     attached        = false;       // GPIO interrupt installed by begin()
+  std::atomic<uint32_t> isrCount{0};
+
+#if FLOW_METER_HAS_PCNT
+  pcnt_unit_handle_t    pcntUnit    = nullptr;
+  pcnt_channel_handle_t pcntChannel = nullptr;
+#endif
+
+  // Flow-rate estimate (updated once per window from service())
+  uint32_t rateWindowStartMs    = 0;
+  uint32_t rateWindowStartCount = 0;
+  uint32_t flowRateMlMin        = 0;
+  static const uint16_t RATE_WINDOW_MS = 1000;
+
+  FlowMeter(const FlowMeter&) = delete;
+  FlowMeter& operator=(const FlowMeter&) = delete;
+};
+
+#endif // FLOW_METER_H
@@ -0,0 +1,80 @@
+#include "InputScanner.h"
+
+#if INPUT_SCANNER_GPIO_REGS
+  #include <soc/gpio_struct.h>
+  #include <soc/soc_caps.h>
+#endif
+
+// --- setup -------------------------------------------------------------------
+
+bool InputScanner::addInput(uint8_t pin, bool activeLow, bool pullup) {
+  if (pin >= 32 * INPUT_SCANNER_BANKS) return false;
+  Bank& b = banks[pin >> 5];
+  const uint32_t bit = 1UL << (pin & 31);
+  pinMode(pin, pullup ? INPUT_PULLUP : INPUT);
+  b.used  |= bit;
+  b.fresh |= bit;
+  if (activeLow) b.invert |= bit;
+  else           b.invert &= ~bit;
+  return true;
+}
+
+void InputScanner::setMockInputs(uint32_t bank0, uint32_t bank1) {
+  mock[0] = bank0;
+  mock[1] = bank1;
+}
+
+// --- scan --------------------------------------------------------------------
+
+uint32_t InputScanner::readBank(uint8_t bank) const {
+#if INPUT_SCANNER_GPIO_REGS
+  if (bank == 0) return GPIO.in;
+  #if SOC_GPIO_PIN_COUNT > 32
+  return GPIO.in1.val;
+  #else
+  return 0;
+  #endif
+#else
+  return mock[bank];
+#endif
+}
+
+void InputScanner::scan() {
+  for (uint8_t i = 0; i < INPUT_SCANNER_BANKS; ++i) {
+    Bank& b = banks[i];
+    if (!b.used) { b.rising = b.falling = 0; continue; }
+
+    const uint32_t sample = (readBank(i) ^ b.invert) & b.used; // 1 = active
+    b.state = (b.state & ~b.fresh) | (sample & b.fresh);
+    b.fresh = 0;
+
+    // Vertical counter: every pin that disagrees with its debounced state counts down
+    // 11 -> 10 -> 01 -> 00 -> 11; agreeing pins reset to 11. The wrap to 11 flips the state.
+    uint32_t changed = sample ^ b.state;
+    b.count0 = ~(b.count0 & changed);
+    b.count1 = b.count0 ^ (b.count1 & changed);
+    changed &= b.count0 & b.count1;
+    b.state  ^= changed;
+    b.rising  = changed & b.state;
+    b.falling = changed & ~b.state;
+  }
+}
+
+// --- results -----------------------------------------------------------------
+
+bool InputScanner::isActive(uint8_t pin) const {
+  return pin < 32 * INPUT_SCANNER_BANKS && (banks[pin >> 5].state >> (pin & 31)) & 1;
+}
+
+bool InputScanner::pressed(uint8_t pin) const {
+  return pin < 32 * INPUT_SCANNER_BANKS && (banks[pin >> 5].rising >> (pin & 31)) & 1;
+}
+
+bool InputScanner::released(uint8_t pin) const {
+  return pin < 32 * INPUT_SCANNER_BANKS && (banks[pin >> 5].falling >> (pin & 31)) & 1;
+}
+
+uint64_t InputScanner::getActiveMask()  const { return ((uint64_t)banks[1].state   << 32) | banks[0].state; }
+uint64_t InputScanner::getRisingMask()  const { return ((uint64_t)banks[1].rising  << 32) | banks[0].rising; }
+uint64_t InputScanner::getFallingMask() const { return ((uint64_t)banks[1].falling << 32) | banks[0].falling; }
+uint64_t InputScanner::getInputMask()   const { return ((uint64_t)banks[1].used    << 32) | banks[0].used; }
@@ -0,0 +1,61 @@
+#ifndef INPUT_SCANNER_H
+#define INPUT_SCANNER_H
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+  #define INPUT_SCANNER_GPIO_REGS 1 // GPIO.in / GPIO.in1 read directly
+#else
+  #define INPUT_SCANNER_GPIO_REGS 0 // setMockInputs() supplies the words
+#endif
+
+#define INPUT_SCANNER_BANKS 2       // GPIO 0..31, 32..63
+
+/**
+ * Debounces every digital input (buttons, limit switches) in one pass.
+ * - scan() reads each input bank with a single register load, then runs a 2-bit
+ *   vertical counter across all 32 bits at once: a pin's debounced state flips
+ *   after 4 consecutive scans that disagree with it. Debounce time = 4 x scan period.
+ * - Per scan, rising (became active) and falling (became inactive) edge masks;
+ *   bit n = GPIO n. Edges live until the next scan(); read them in the same task.
+ * - Active-low inputs are inverted on the way in, so "active" and "rising" always
+ *   mean pressed / end stop reached.
+ * - Without GPIO registers (host build), setMockInputs() supplies the raw words.
+ */
+class InputScanner {
+public:
+  bool addInput(uint8_t pin, bool activeLow = true, bool pullup = true); // false for pins past bank 1
+  void scan();
+
+  // --- per pin ---
+  bool isActive(uint8_t pin) const;     // debounced
+  bool pressed(uint8_t pin) const;      // became active on the last scan
+  bool released(uint8_t pin) const;     // became inactive on the last scan
+
+  // --- masks (bit n = GPIO n) ---
+  uint64_t getActiveMask()  const;
+  uint64_t getRisingMask()  const;
+  uint64_t getFallingMask() const;
+  uint64_t getInputMask()   const;
+
+  void setMockInputs(uint32_t bank0, uint32_t bank1 = 0); // raw levels for host builds
+
+private:
+  struct Bank {
+    uint32_t used    = 0;               // pins added to the scanner
+    uint32_t invert  = 0;               // active-low pins
+    uint32_t fresh   = 0;               // added since the last scan: adopt the level, no edge
+    uint32_t state   = 0;               // debounced, 1 = active
+    uint32_t count0  = 0xFFFFFFFF;      // vertical counter, low bit per pin (11 = idle)
+    uint32_t count1  = 0xFFFFFFFF;      // ... high bit
+    uint32_t rising  = 0;
+    uint32_t falling = 0;
+  };
+
+  uint32_t readBank(uint8_t bank) const;
+
+  Bank     banks[INPUT_SCANNER_BANKS];
+  uint32_t mock[INPUT_SCANNER_BANKS] = {0, 0};
+};
+
+#endif // INPUT_SCANNER_H
@@ -2,9 +2,17 @@
 #include "MENU.h"
 #include <string.h> // for memcpy
 
+const uint8_t MenuBase::MAX_PAGES; // bound to min()'s reference parameters
+
+template class PagedMenu<0, 0>;   // Menu's page engine, compiled once here (extern in MENU.h)
+
 // --- ctor/dtor ---------------------------------------------------------------
 
 Menu::Menu(uint16_t screenWidth, uint16_t screenHeight, int8_t reset, uint8_t addr, uint8_t sda, uint8_t scl, bool enableStatus)
+  : PagedMenu<0, 0>(screenWidth, screenHeight, reset, addr, sda, scl, enableStatus, Storage()) {}
+
+MenuBase::MenuBase(uint16_t screenWidth, uint16_t screenHeight, int8_t reset, uint8_t addr, uint8_t sda, uint8_t scl, bool enableStatus,
+                   const Storage& storage)
   : display(screenWidth, screenHeight, &Wire, reset),
     SCREEN_WIDTH(screenWidth),
     SCREEN_HEIGHT(screenHeight),
@@ -12,6 +20,8 @@ Menu::Menu(uint16_t screenWidth, uint16_t screenHeight, int8_t reset, uint8_t ad
     OLED_ADDR(addr),
     SDA_PIN(sda),
     SCL_PIN(scl),
+    wireTransport(Wire),
+    transport(&wireTransport),
     displayColumns(screenWidth / 6),
     displayRows(screenHeight / 8),
     titleCanvas(screenWidth, 16),
@@ -20,8 +30,35 @@ Menu::Menu(uint16_t screenWidth, uint16_t screenHeight, int8_t reset, uint8_t ad
     useStatusBar(enableStatus),
     statusCanvas(screenWidth, 8),
     prevBodyLeftCanvas(screenWidth / 2, screenHeight - 16),
-    prevBodyRightCanvas(screenWidth / 2, screenHeight - 16)
+    prevBodyRightCanvas(screenWidth / 2, screenHeight - 16),
+    itemCacheStorage(storage.itemCache),
+    itemCacheStorageCount(storage.itemCache ? storage.itemCacheCount : 0),
+    menuColumns(storage.columns == 2 ? 2 : 1),
+    menuRows(storage.rows ? storage.rows : 1),
+    marqueeStorage(storage.marquee),
+    marqueeStorageCount(storage.marquee ? storage.marqueeCount : 0),
+    contrastLevel(screenHeight > 32 ? 0xCF : 0x8F),
+    panelContrast(screenHeight > 32 ? 0xCF : 0x8F),
+    prerender{ { uint16_t(screenWidth / 2), uint16_t(screenHeight - 16) },
+               { uint16_t(screenWidth / 2), uint16_t(screenHeight - 16) } }
     {
+      // Caller storage where given, heap otherwise; the status canvas only with a status bar
+      display.bindStorage(storage.frame);
+      titleCanvas.setStorage(storage.title);
+      bodyLeftCanvas.setStorage(storage.bodyLeft);
+      bodyRightCanvas.setStorage(storage.bodyRight);
+      statusCanvas.setStorage(storage.status);
+      prevBodyLeftCanvas.setStorage(storage.snapshot[0]);
+      prevBodyRightCanvas.setStorage(storage.snapshot[1]);
+      for (uint8_t i = 0; i < 2; ++i) {
+        prerender[i].left.setStorage(storage.prerender[2 * i]);
+        prerender[i].right.setStorage(storage.prerender[2 * i + 1]);
+      }
+      titleCanvas.allocate();
+      bodyLeftCanvas.allocate();
+      bodyRightCanvas.allocate();
+      if (useStatusBar) statusCanvas.allocate();
+
       titleCanvas.setTextWrap(false);
       bodyLeftCanvas.setTextWrap(false);
       bodyRightCanvas.setTextWrap(false);
@@ -31,62 +68,116 @@ Menu::Menu(uint16_t screenWidth, uint16_t screenHeight, int8_t reset, uint8_t ad
       bodyLeftCanvas.setFont(NULL);
       bodyRightCanvas.setFont(NULL);
       statusCanvas.setFont(NULL);
+      allocateSnapshotCanvases(); // default transition is Slide
+      updateLayout();
     }
 
-Menu::~Menu() {
-  if (itemsC) { delete[] itemsC; itemsC = nullptr; }
-  if (itemsS) { delete[] itemsS; itemsS = nullptr; }
-  if (rowMarqueeStates) { delete[] rowMarqueeStates; rowMarqueeStates = nullptr; }
+MenuBase::~MenuBase() {
+  releaseItems();
+  if (rowMarqueeStates != marqueeStorage) delete[] rowMarqueeStates;
+  rowMarqueeStates = nullptr;
+  if (itemCache != itemCacheStorage) delete[] itemCache;
+  itemCache = nullptr;
+}
+
+// --- canvases ------------------------------------------------------------------
+
+bool MenuCanvas::allocate() {
+  if (buffer) return true;
+  if (storage) {
+    buffer = storage;
+    buffer_owned = false;
+  } else {
+    buffer = (uint8_t*)malloc(bytes());
+    buffer_owned = (buffer != nullptr);
+  }
+  if (buffer) memset(buffer, 0, bytes());
+  return buffer != nullptr;
+}
+
+void MenuCanvas::release() {
+  if (buffer_owned) free(buffer);
+  buffer = nullptr;
+  buffer_owned = false;
 }
 
 // --- display lifecycle -------------------------------------------------------
 
-void Menu::initializeDisplay() {
-  Wire.begin(SDA_PIN, SCL_PIN);
-  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR)) {
+bool MenuPanel::allocateBuffer() {
+  if (!buffer && !(buffer = (uint8_t*)malloc(size_t(WIDTH) * ((HEIGHT + 7) / 8)))) return false;
+  clearDisplay();
+  return true;
+}
+
+void MenuBase::initializeDisplay() {
+  bool onWire = (transport == &wireTransport);
+  if (!onWire && !transport->begin(OLED_ADDR)) {
+    transport = &wireTransport; // driver unavailable on this core: keep the Wire path
+    onWire = true;
+  }
+  if (onWire) Wire.begin(SDA_PIN, SCL_PIN);
+  // Off Wire only the frame buffer is taken from Adafruit_SSD1306 (bound or malloc'd)
+  const bool ready = onWire ? display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR, true, true)
+                            : display.allocateBuffer();
+  if (!ready) {
     error = true;
     errorString = F("SSD1306 init failed");
     initialized = false;
     return;
   }
+  if (onWire) wireTransport.begin(OLED_ADDR); // after display.begin(): it drops the clock to 100 kHz
+  else        sendPanelInit();
+  panelContrast = (SCREEN_HEIGHT > 32) ? 0xCF : 0x8F; // what either init sequence leaves set
+  hwScrollRunning = false;
+  displayPower = DisplayPower::On;
+  lastActivityMs = millis();
   initialized = true;
+  setPanelContrast(contrastLevel);
   error = false;
   errorString = "";
   display.clearDisplay();
-  display.display();
+  sendFullFrame();
 }
 
-bool Menu::isDisplayInitialized() const { return initialized && !error; }
-bool Menu::displayHasError()     const { return error; }
-String Menu::getDisplayError()   const { return errorString; }
+void MenuBase::setDisplayTransport(DisplayTransport* t) { transport = t ? t : &wireTransport; }
+void MenuBase::setBusClock(uint32_t hz)                 { wireTransport.setClock(hz); }
+DisplayTransport& MenuBase::getDisplayTransport()       { return *transport; }
+
+bool MenuBase::isDisplayInitialized() const { return initialized && !error; }
+bool MenuBase::displayHasError()     const { return error; }
+String MenuBase::getDisplayError()   const { return errorString; }
 
 // --- content ---------------------------------------------------------------
 
-void Menu::setMenuItems(const char* const items[], uint8_t itemCount) {
-  if (itemsS) { delete[] itemsS; itemsS = nullptr; }
-  if (itemsC) { delete[] itemsC; itemsC = nullptr; }
+void MenuBase::setMenuItems(const char* const items[], uint8_t itemCount) {
+  releaseItems();
 
+  itemProvider = nullptr;
   useStringItems = false;
   numberOfItems = itemCount;
   currentItemIndex = 0;
+  invalidatePrerender();
 
   if (itemCount == 0) { markBodyDirty(); return; }
 
-  itemsC = new const char*[itemCount];
-  for (uint8_t i = 0; i < itemCount; ++i) itemsC[i] = items[i];
+  const char** copy = new const char*[itemCount];
+  for (uint8_t i = 0; i < itemCount; ++i) copy[i] = items[i];
+  itemsC = copy;
+  itemsOwned = true;
 
   ensureMarqueeStateCapacity();
   resetPageMarqueeStates();
   markBodyDirty();
 }
 
-void Menu::setMenuItems(const String items[], uint8_t itemCount) {
-  if (itemsC) { delete[] itemsC; itemsC = nullptr; }
-  if (itemsS) { delete[] itemsS; itemsS = nullptr; }
+void MenuBase::setMenuItems(const String items[], uint8_t itemCount) {
+  releaseItems();
 
+  itemProvider = nullptr;
   useStringItems = true;
   numberOfItems = itemCount;
   currentItemIndex = 0;
+  invalidatePrerender();
 
   if (itemCount == 0) { markBodyDirty(); return; }
 
@@ -98,317 +189,409 @@ void Menu::setMenuItems(const String items[], uint8_t itemCount) {
   markBodyDirty();
 }
 
-void Menu::clearMenu() {
-  if (itemsC) { delete[] itemsC; itemsC = nullptr; }
+void MenuBase::setMenuItems(MenuItemProvider* provider) {
+  releaseItems();
+
+  itemProvider = provider;
+  useStringItems = false;
+  numberOfItems = provider ? provider->count() : 0;
+  currentItemIndex = 0;
+  invalidateItemCache();
+  invalidatePrerender();
+
+  ensureMarqueeStateCapacity();
+  resetPageMarqueeStates();
+  markBodyDirty();
+}
+
+void MenuBase::borrowMenuItems(const char* const items[], uint16_t itemCount) {
+  releaseItems();
+
+  itemProvider = nullptr;
+  useStringItems = false;
+  numberOfItems = items ? itemCount : 0;
+  currentItemIndex = 0;
+  itemsC = numberOfItems ? items : nullptr;
+  invalidatePrerender();
+
+  ensureMarqueeStateCapacity();
+  resetPageMarqueeStates();
+  markBodyDirty();
+}
+
+void MenuBase::releaseItems() {
+  if (itemsOwned) delete[] itemsC;
+  itemsC = nullptr;
+  itemsOwned = false;
   if (itemsS) { delete[] itemsS; itemsS = nullptr; }
+}
+
+void MenuBase::invalidateItems() {
+  if (itemProvider) {
+    numberOfItems = itemProvider->count();
+    if (currentItemIndex >= numberOfItems) currentItemIndex = numberOfItems ? numberOfItems - 1 : 0;
+  }
+  invalidateItemCache();
+  invalidatePrerender();
+  markBodyDirty();
+}
+
+void MenuBase::setItemCacheEnabled(bool enable) {
+  itemCacheEnabled = enable;
+  invalidateItemCache();
+}
+
+void MenuBase::clearMenu() {
+  releaseItems();
+  itemProvider = nullptr;
   numberOfItems = 0;
   currentItemIndex = 0;
+  invalidatePrerender();
   resetPageMarqueeStates();
   markBodyDirty();
 }
 
+// --- live widgets ------------------------------------------------------------
+
+void MenuBase::setWidgets(MenuWidget* const list[], uint8_t count) {
+  widgets = count ? list : nullptr;
+  widgetCount = widgets ? count : 0;
+  for (uint8_t i = 0; i < widgetCount; ++i) widgets[i]->invalidate();
+  widgetsNeedFullDraw = true;
+}
+
+void MenuBase::clearWidgets() {
+  widgets = nullptr;
+  widgetCount = 0;
+  widgetsNeedFullDraw = false;
+  // Widgets may have drawn anywhere in the body, also where a 1-column page never blits
+  const int16_t bodyH = SCREEN_HEIGHT - 16 - (useStatusBar ? 8 : 0);
+  if (initialized && !error) {
+    display.fillRect(0, 16, SCREEN_WIDTH, bodyH, MENU_BG_COLOR);
+    markDisplayRegion(0, 16, SCREEN_WIDTH, bodyH);
+  }
+  markBodyDirty();
+}
+
+bool MenuBase::hasWidgets() const { return widgetCount != 0; }
+
 // --- titles / layout --------------------------------------------------------
 
-void Menu::setMenuTitle(const String& title, uint8_t alignment) {
+void MenuBase::setMenuTitle(const String& title, uint8_t alignment) {
   menuTitle = title;
   titleAlignment = alignment;
   markTitleDirty();
 }
 
-void Menu::setMenuSubtitle(const String& subtitle, uint8_t alignment) {
+void MenuBase::setMenuSubtitle(const String& subtitle, uint8_t alignment) {
   menuSubtitle = subtitle;
   subtitleAlignment = alignment;
   markTitleDirty();
 }
 
-void Menu::setMenuColumns(uint8_t columns) {
+void MenuBase::setMenuColumns(uint8_t columns) {
   menuColumns = (columns == 2) ? 2 : 1;
+  updateLayout();
+  invalidatePrerender();
   ensureMarqueeStateCapacity();
   resetPageMarqueeStates();
   markBodyDirty();
 }
 
-void Menu::setMenuRows(uint8_t rows) {
+void MenuBase::setMenuRows(uint8_t rows) {
   menuRows = rows ? rows : 1;
+  updateLayout();
+  invalidatePrerender();
   ensureMarqueeStateCapacity();
   resetPageMarqueeStates();
   markBodyDirty();
 }
 
-void Menu::setColumnNumberOfCharacters(uint8_t charsPerColumn) {
+void MenuBase::setColumnNumberOfCharacters(uint8_t charsPerColumn) {
   charsPerCol = charsPerColumn ? charsPerColumn : 1;
+  updateLayout();
+  invalidatePrerender();
   markBodyDirty();
 }
 
-void Menu::setMenuItemScrolling(bool enable) {
+void MenuBase::setMenuItemScrolling(bool enable) {
   menuItemScrolling = enable;
 }
 
 // --- NEW: inverted selected row --------------------------------------------
 
-void Menu::setSelectedItemInverted(bool enable) {
+void MenuBase::setSelectedItemInverted(bool enable) {
   selectedItemInverted = enable;
+  invalidatePrerender();
   markBodyDirty();
 }
 
 // --- marquee controls -------------------------------------------------------
 
-void Menu::setMarqueeEnabled(bool enable)       { marqueeEnabled = enable; }
-void Menu::setMarqueeMode(MarqueeMode mode)     { marqueeMode = mode; }
-void Menu::setMarqueeSpeed(uint16_t pxPerSec)   { marqueeSpeedPxSec = pxPerSec ? pxPerSec : 1; }
-void Menu::setMarqueeEdgePauseMs(uint16_t ms)   { marqueeEdgePauseMs = ms; }
-void Menu::setSelectedMarqueeEdgePauseMs(uint16_t ms) { selectedMarqueeEdgePauseMs = ms; }
-void Menu::setResetMarqueeOnIntraPageNav(bool enable) { resetMarqueeOnIntraPageNav = enable; }
+void MenuBase::setMarqueeEnabled(bool enable)       { marqueeEnabled = enable; invalidatePrerender(); }
+void MenuBase::setMarqueeMode(MarqueeMode mode)     { marqueeMode = mode; invalidatePrerender(); }
+void MenuBase::setMarqueeSpeed(uint16_t pxPerSec)   { marqueeSpeedPxSec = pxPerSec ? pxPerSec : 1; }
+void MenuBase::setMarqueeEdgePauseMs(uint16_t ms)   { marqueeEdgePauseMs = ms; }
+void MenuBase::setSelectedMarqueeEdgePauseMs(uint16_t ms) { selectedMarqueeEdgePauseMs = ms; }
+void MenuBase::setResetMarqueeOnIntraPageNav(bool enable) { resetMarqueeOnIntraPageNav = enable; }
+
+void MenuBase::setHardwareScrollEnabled(bool enable) {
+  hardwareScrollEnabled = enable;
+  if (enable) return;
+  if (hwScrollRunning) stopHardwareScroll();
+  hwMarqueeRow = NO_HW_ROW;
+  hwRowInBuffer = false;
+  markBodyDirty();
+}
+
+bool MenuBase::isHardwareScrolling() const { return hwScrollRunning; }
 
 // --- vertical scroll controls ----------------------------------------------
 
-void Menu::setSmoothScrollEnabled(bool enable)  { smoothScrollEnabled = enable; }
-void Menu::setScrollSpeed(uint16_t pxPerSec)    { scrollSpeedPxSec = pxPerSec ? pxPerSec : 1; }
+void MenuBase::setSmoothScrollEnabled(bool enable)  { smoothScrollEnabled = enable; }
+void MenuBase::setScrollSpeed(uint16_t pxPerSec)    { scrollSpeedPxSec = pxPerSec ? pxPerSec : 1; }
 
 // --- page transition controls ----------------------------------------------
 
-void Menu::setPageTransition(TransitionType type, uint16_t durationMs) {
+void MenuBase::setPageTransition(TransitionType type, uint16_t durationMs) {
+  if (transitionActive) {
+    // Snap the running one: its snapshot may be about to go away
+    if (pageTransitionType == TransitionType::ContrastFade) endHardwareTransition();
+    transitionActive = false;
+    markBodyDirty();
+  }
   pageTransitionType = type;
   pageTransitionDurationMs = durationMs ? durationMs : 1;
+
+  // Only Slide/Fade draw the old page; ContrastFade leaves it on the panel
+  if (type == TransitionType::Slide || type == TransitionType::Fade) {
+    if (!allocateSnapshotCanvases()) pageTransitionType = TransitionType::None; // no RAM: plain page change
+  } else {
+    prevBodyLeftCanvas.release();
+    prevBodyRightCanvas.release();
+  }
 }
 
-// --- navigation -------------------------------------------------------------
+void MenuBase::setContrast(uint8_t level) {
+  contrastLevel = level;
+  if (!transitionActive && displayPower == DisplayPower::On) setPanelContrast(level);
+}
 
-void Menu::nextItem() {
-  if (!numberOfItems) return;
-  
-  uint8_t oldPage = getCurrentPageIndex();          // NEW
-  uint8_t curPage = getCurrentPageIndex();
-  uint8_t endIdx  = getPageEndIndex(curPage);
-  bool staysInPage = (currentItemIndex < endIdx);
-
-  if (currentItemIndex < numberOfItems - 1) {
-    if (smoothScrollEnabled && staysInPage && pageTransitionType == TransitionType::None) {
-      startVerticalScroll(+1);
-    } else if (!staysInPage && pageTransitionType != TransitionType::None) {
-      startPageTransition(+1, currentItemIndex + 1);  // keeps reset call inside transition
-    } else {
-      currentItemIndex++;
-      // RESET ONLY IF PAGE CHANGED
-      uint8_t newPage = getCurrentPageIndex();       // NEW
-      if (resetMarqueeOnIntraPageNav || (newPage != oldPage)) resetPageMarqueeStates(); // NEW
-      //resetPageMarqueeStates();
-      markBodyDirty();
-    }
-  } else if (menuItemScrolling) {
-    // wrap to first item (page transition optional)
-    if (pageTransitionType != TransitionType::None) {
-      startPageTransition(+1, 0);
-    } else {
-      currentItemIndex = 0;
-      resetPageMarqueeStates();  // wrap ⇒ page likely changed; OK to reset
-      markBodyDirty();
-    }
+// --- display power ------------------------------------------------------------
+
+void MenuBase::setIdleTimeouts(uint32_t dimAfter, uint32_t offAfter, uint8_t dimLevel) {
+  dimAfterMs     = dimAfter;
+  offAfterMs     = offAfter;
+  dimContrast    = dimLevel;
+  lastActivityMs = millis();
+}
+
+bool MenuBase::wakeDisplay() {
+  const uint32_t now = millis();
+  lastActivityMs = now;
+  if (displayPower == DisplayPower::On) return false;
+
+  const bool wasOff = (displayPower == DisplayPower::Off);
+  displayPower = DisplayPower::On;
+  setPanelContrast(contrastLevel);    // before display-on: no dim flash
+  if (wasOff) {
+    sendPanelCommand(SSD1306_DISPLAYON); // GDDRAM kept the last frame: nothing to redraw
+    resumeAnimationClocks(now);
   }
+  return wasOff;
 }
 
-void Menu::previousItem() {
-  if (!numberOfItems) return;
-  
-  uint8_t oldPage = getCurrentPageIndex();          // NEW
-  uint8_t curPage = getCurrentPageIndex();
-  uint8_t startIdx = getPageStartIndex(curPage);
-  bool staysInPage = (currentItemIndex > startIdx);
+bool MenuBase::isDisplayAsleep() const { return displayPower == DisplayPower::Off; }
+MenuBase::DisplayPower MenuBase::getDisplayPower() const { return displayPower; }
 
-  if (currentItemIndex > 0) {
-    if (smoothScrollEnabled && staysInPage && pageTransitionType == TransitionType::None) {
-      startVerticalScroll(-1);
-    } else if (!staysInPage && pageTransitionType != TransitionType::None) {
-      startPageTransition(-1, currentItemIndex - 1);
-    } else {
-      currentItemIndex--;
-      // RESET ONLY IF PAGE CHANGED
-      uint8_t newPage = getCurrentPageIndex();      // NEW
-      if (resetMarqueeOnIntraPageNav || (newPage != oldPage)) resetPageMarqueeStates();
-      markBodyDirty();
-    }
-  } else if (menuItemScrolling) {
-    // wrap to last item
-    uint8_t last = numberOfItems ? (numberOfItems - 1) : 0;
-    if (pageTransitionType != TransitionType::None) {
-      startPageTransition(-1, last);
-    } else {
-      currentItemIndex = last;
-      resetPageMarqueeStates(); // wrap ⇒ page likely changed; OK to reset
-      markBodyDirty();
+void MenuBase::resumeAnimationClocks(uint32_t now) {
+  // Time spent blank doesn't count: restart each step clock from now
+  if (rowMarqueeStates) {
+    for (uint8_t i = 0; i < marqueeStateCount; ++i) {
+      if (rowMarqueeStates[i].lastMs != 0) rowMarqueeStates[i].lastMs = now;
     }
   }
+  lastScrollMs = now;
 }
 
-void Menu::setCurrentItemIndex(uint8_t index) {
-  if (index < numberOfItems) {
-    uint8_t oldPage = getCurrentPageIndex();        // NEW
-    currentItemIndex = index;
-    uint8_t newPage = getCurrentPageIndex();        // NEW
-    if (resetMarqueeOnIntraPageNav || (newPage != oldPage)) resetPageMarqueeStates();
-    markBodyDirty();
-  }
-}
+// --- navigation -------------------------------------------------------------
 
-uint8_t Menu::getCurrentItemIndex() const { return currentItemIndex; }
+uint16_t MenuBase::getCurrentItemIndex() const { return currentItemIndex; }
 
-const char* Menu::getCurrentItemC() const {
+const char* MenuBase::getCurrentItemC() const {
   return itemAtC(currentItemIndex);
 }
-String Menu::getCurrentItemS() const {
+String MenuBase::getCurrentItemS() const {
   return itemAtS(currentItemIndex);
 }
 
 // --- dirty flags ------------------------------------------------------------
 
-void Menu::markTitleDirty()  { dirtyTitle  = true; }
-void Menu::markBodyDirty()   { dirtyBodyL  = true; dirtyBodyR = (menuColumns == 2); }
-void Menu::markStatusDirty() { if (useStatusBar) dirtyStatus = true; }
+void MenuBase::markTitleDirty()  { dirtyTitle  = true; }
+void MenuBase::markBodyDirty()   { dirtyBodyL  = true; dirtyBodyR = (menuColumns == 2); }
+void MenuBase::markStatusDirty() { if (useStatusBar) dirtyStatus = true; }
 
 // --- redraw / blit ----------------------------------------------------------
 
-void Menu::showMenu() {
-  dirtyTitle = dirtyBodyL = true;
-  dirtyBodyR = (menuColumns == 2);
-  dirtyStatus = useStatusBar;
-  refreshMenu();
+void MenuBase::clearDisplay() {
+  if (!initialized || error) return;
+  display.clearDisplay();
+  sendFullFrame();
 }
 
-void Menu::refreshMenu() {
+void MenuBase::updateDisplay() {
   if (!initialized || error) return;
+  sendFullFrame();
+  dirtyPageMask = 0;
+  renderStats.flushes++;
+  if (frameOpen) { renderStats.frame.add(micros() - frameStartUs); frameOpen = false; }
+}
 
-  uint32_t now = millis();
-
-  if (dirtyTitle && !transitionActive)  { drawTitle();  blitTitle();      dirtyTitle = false; }
+bool MenuBase::flushDisplay(uint8_t maxPages) {
+  if (!initialized || error || displayPower == DisplayPower::Off) return true;
+  if (hwScrollRunning && dirtyPageMask) stopHardwareScroll(); // GDDRAM writes are undefined while scrolling
+  if (!dirtyPageMask) {
+    if (hwMarqueeRow != NO_HW_ROW && hwRowInBuffer && !hwScrollRunning) startHardwareScroll();
+    return true;
+  }
 
-  // During transitions, body is rendered via renderTransitionFrame()
-  if (transitionActive) {
-    renderTransitionFrame(now);
-  } else {
-    if (dirtyBodyL)  { drawBody();   blitBodyLeft();   dirtyBodyL = false; }
-    if (menuColumns == 2 && dirtyBodyR) {
-      blitBodyRight(); dirtyBodyR = false;
+  const uint8_t pages = min<uint8_t>(SCREEN_HEIGHT / 8, MAX_PAGES);
+  uint8_t p = 0;
+  while (p < pages && maxPages) {
+    if (!(dirtyPageMask & (1 << p))) { ++p; continue; }
+    // Merge a run of pages sharing one column span into a single window
+    uint8_t last = p;
+    while (last + 1 < pages && uint8_t(last - p + 1) < maxPages && (dirtyPageMask & (1 << (last + 1))) &&
+           dirtyColMin[last + 1] == dirtyColMin[p] && dirtyColMax[last + 1] == dirtyColMax[p]) {
+      ++last;
     }
+    sendWindow(dirtyColMin[p], dirtyColMax[p], p, last);
+    for (uint8_t q = p; q <= last; ++q) dirtyPageMask &= uint8_t(~(1 << q));
+    maxPages -= uint8_t(last - p + 1);
+    p = last + 1;
   }
+  renderStats.flushes++;
+  if (dirtyPageMask) return false;    // caller continues on a later slice
 
-  if (useStatusBar && dirtyStatus && !transitionActive) { drawStatus(); blitStatus(); dirtyStatus = false; }
+  if (frameOpen) { renderStats.frame.add(micros() - frameStartUs); frameOpen = false; }
 
-  updateDisplay();
+  if (navFrameArmed) {
+    // First frame that reflects those presses has just gone out; later ones wait for their own
+    renderStats.navLatencyLastUs = micros() - navFrameInputUs;
+    if (renderStats.navLatencyLastUs > renderStats.navLatencyMaxUs) renderStats.navLatencyMaxUs = renderStats.navLatencyLastUs;
+    navFrameArmed = false;
+  }
+  if (hwMarqueeRow != NO_HW_ROW && hwRowInBuffer) startHardwareScroll(); // row is in GDDRAM: hand it over
+  return true;
 }
 
-void Menu::clearDisplay() {
-  if (!initialized || error) return;
-  display.clearDisplay();
-  display.display();
-}
+uint32_t MenuBase::getBytesFlushed() const { return renderStats.bytesFlushed; }
 
-void Menu::updateDisplay() {
-  if (!initialized || error) return;
-  display.display();
-}
+// --- render instrumentation -------------------------------------------------
 
-// --- tick (animations) ------------------------------------------------------
+const MenuBase::RenderStats& MenuBase::getRenderStats() const { return renderStats; }
 
-void Menu::tick() {
-  if (!initialized || error) return;
+void MenuBase::resetRenderStats() { renderStats = RenderStats(); }
 
-  uint32_t now = millis();
-  bool needsRedraw = false;
+void MenuBase::printRenderStats(Print& out) const {
+  const RenderTiming* stages[] = { &renderStats.drawBody, &renderStats.tick, &renderStats.transitionFrame, &renderStats.frame,
+                                   &renderStats.prerender, &renderStats.transitionStart };
+  const char* names[] = { "drawBody", "tick", "transition", "frame", "prerender", "transStart" };
+  for (uint8_t i = 0; i < 6; ++i) {
+    out.print(names[i]);
+    out.print(F(": n="));    out.print(stages[i]->count);
+    out.print(F(" avg="));   out.print(stages[i]->avgUs());
+    out.print(F("us max=")); out.print(stages[i]->maxUs);
+    out.println(F("us"));
+  }
+  out.print(F("flushes="));  out.print(renderStats.flushes);
+  out.print(F(" bytes="));   out.print(renderStats.bytesFlushed);
+  out.print(F(" transactions=")); out.print(renderStats.busTransactions);
+  out.print(F(" hwScrolls="));    out.print(renderStats.hwScrollStarts);
+  out.print(F(" bytes/frame="));
+  out.println(renderStats.frame.count ? renderStats.bytesFlushed / renderStats.frame.count : 0);
+  out.print(F("prerender hits="));  out.print(renderStats.prerenderHits);
+  out.print(F(" misses="));          out.println(renderStats.prerenderMisses);
+  out.print(F("nav latency last="));  out.print(renderStats.navLatencyLastUs);
+  out.print(F("us max="));            out.print(renderStats.navLatencyMaxUs);
+  out.println(F("us"));
+}
 
-  // Vertical smooth scroll (within page)
-  if (bodyScrollDir != 0) {
-    if (stepVerticalScroll(now)) {
-      needsRedraw = true;
-    } else {
-      // commit index after finishing 1 row
-      currentItemIndex += (bodyScrollDir > 0 ? 1 : -1);
-      bodyScrollDir = 0;
-      bodyYOffsetPx = 0;
-      resetPageMarqueeStates();
-      needsRedraw = true;
+void MenuBase::dumpFramePBM(Print& out) const {
+  if (!initialized || error) return;
+  // PBM: 1 = black, so unlit pixels are written as 1 and the image reads like the panel
+  const uint8_t* fb = const_cast<MenuPanel&>(display).getBuffer();
+  out.print(F("P4\n"));
+  out.print(SCREEN_WIDTH); out.print(F(" ")); out.print(SCREEN_HEIGHT); out.print(F("\n"));
+  for (uint8_t y = 0; y < SCREEN_HEIGHT; ++y) {
+    const uint8_t* page = fb + (uint16_t)(y / 8) * SCREEN_WIDTH;
+    const uint8_t  bit  = uint8_t(1 << (y & 7));
+    for (uint8_t x = 0; x < SCREEN_WIDTH; x += 8) {
+      uint8_t packed = 0;
+      for (uint8_t b = 0; b < 8 && x + b < SCREEN_WIDTH; ++b) {
+        if (!(page[x + b] & bit)) packed |= uint8_t(0x80 >> b);
+      }
+      out.write(packed);
     }
   }
+}
 
-  // Page transition active? We just mark needsRedraw; rendering happens in refreshMenu()
-  if (transitionActive) {
-    needsRedraw = true;
-  }
-
-  // Per-row marquee: step each visible row if enabled
-  if (marqueeEnabled && numberOfItems) {
-    const uint8_t pi = getCurrentPageIndex();
-    const uint8_t s  = getPageStartIndex(pi);
-    const uint8_t e  = getPageEndIndex(pi);
-    const uint16_t leftWidthPx  = min<uint16_t>(charsPerCol * 6, bodyLeftCanvas.width());
-    const uint16_t rightWidthPx = min<uint16_t>(charsPerCol * 6, bodyRightCanvas.width());
-
-    for (uint8_t i = s; i <= e; ++i) {
-      uint8_t ip = i - s;               // index within current page
-      // Skip if SelectedOnly and not selected
-      if (marqueeMode == MarqueeMode::SelectedOnly && i != currentItemIndex) {
-        // ensure offset reset so text aligns cleanly
-        if (rowMarqueeStates && rowMarqueeStates[ip].offsetPx != 0) {
-          rowMarqueeStates[ip].offsetPx = 0;
-          rowMarqueeStates[ip].dir = -1;
-          rowMarqueeStates[ip].lastMs = now;
-          rowMarqueeStates[ip].holdMs = 0;
-          needsRedraw = true;
-        }
-        continue;
-      }
+// --- memory accounting ------------------------------------------------------
 
-      String text = useStringItems ? itemAtS(i) : String(itemAtC(i));
-      // Measure on appropriate canvas for correct width (left or right)
-      bool isLeft = ((ip % menuColumns) == 0);
-      GFXcanvas1& canvas = isLeft ? bodyLeftCanvas : bodyRightCanvas;
-      int16_t x1, y1; uint16_t tw, th;
-      canvas.getTextBounds(text.c_str(), 0, 0, &x1, &y1, &tw, &th);
-      uint16_t colWidthPx = isLeft ? leftWidthPx : rightWidthPx;
-
-      if (!Serial) { /* optional wait */ }
-      //Serial.print(F("Row ")); 
-      //Serial.print(ip);
-      //Serial.print(F(" tw="));
-      //Serial.print(tw);
-      //Serial.print(F(" colW="));
-      //Serial.println(colWidthPx);
-
-      if (tw > colWidthPx && rowMarqueeStates) {
-        if (rowMarqueeStates[ip].lastMs == 0) rowMarqueeStates[ip].lastMs = now - 16;
-
-        // NEW: choose edge pause per row
-        const bool isSelectedRow = (i == currentItemIndex);
-        const uint16_t edgePause = isSelectedRow ? selectedMarqueeEdgePauseMs : marqueeEdgePauseMs;
-        if (stepMarquee(rowMarqueeStates[ip], tw, colWidthPx, now, edgePause)) { // CHANGED signature
-          needsRedraw = true;
-          //Serial.print(F(" ip="));
-          //Serial.print(ip);
-          //Serial.print(F(" offset="));
-          //Serial.print(rowMarqueeStates[ip].offsetPx);
-          //Serial.print(F(" dir="));
-          //Serial.print(rowMarqueeStates[ip].dir);
-          //Serial.print(F(" hold="));
-          //Serial.println(rowMarqueeStates[ip].holdMs);
-        }
-      } else {
-        // fits: reset state if needed
-        if (rowMarqueeStates && (rowMarqueeStates[ip].offsetPx != 0 || rowMarqueeStates[ip].holdMs != 0)) {
-          rowMarqueeStates[ip].offsetPx = 0;
-          rowMarqueeStates[ip].dir = -1;
-          rowMarqueeStates[ip].holdMs = 0;
-          rowMarqueeStates[ip].lastMs = now;
-          needsRedraw = true;
-        }
-      }
-    }
+uint32_t MenuBase::canvasBytes(const MenuCanvas& canvas) {
+  return canvas.isAllocated() ? canvas.bytes() : 0;
+}
+
+MenuBase::MemoryUsage MenuBase::getMemoryUsage() const {
+  MemoryUsage m;
+  // display.begin() allocates the buffer unless bound (FixedMenu); nothing is held before that
+  if (initialized) m.frameBuffer = uint32_t(SCREEN_WIDTH) * ((SCREEN_HEIGHT + 7) / 8);
+  const MenuCanvas* canvases[] = { &titleCanvas, &bodyLeftCanvas, &bodyRightCanvas, &statusCanvas,
+                                    &prevBodyLeftCanvas, &prevBodyRightCanvas,
+                                    &prerender[0].left, &prerender[0].right, &prerender[1].left, &prerender[1].right };
+  for (uint8_t i = 0; i < 10; ++i) {
+    const uint32_t bytes = canvasBytes(*canvases[i]);
+    if (i < 4)      m.canvases  += bytes;
+    else if (i < 6) m.snapshot  += bytes;
+    else            m.prerender += bytes;
+    if (canvases[i]->isOnHeap()) m.heap += bytes;
   }
+  if (display.isOnHeap()) m.heap += m.frameBuffer; // malloc'd by Adafruit_SSD1306::begin()
+  if (itemsC && itemsOwned) m.items = uint32_t(numberOfItems) * sizeof(const char*); // borrowed: caller's memory
+  if (itemsS) {
+    m.items = uint32_t(numberOfItems) * sizeof(String);
+    for (uint16_t i = 0; i < numberOfItems; ++i) m.items += itemsS[i].length() + 1;
+  }
+  m.heap   += m.items;
+  if (itemCache) {
+    const uint32_t cache = uint32_t(itemCacheSlots) * sizeof(RowCacheSlot);
+    m.items += cache;
+    if (itemCache != itemCacheStorage) m.heap += cache;
+  }
+  m.marquee = uint32_t(marqueeStateCount) * sizeof(RowMarquee);
+  if (rowMarqueeStates && rowMarqueeStates != marqueeStorage) m.heap += m.marquee;
+  m.object  = sizeof(MenuBase) + menuTitle.length() + menuSubtitle.length();
+  m.heap   += menuTitle.length() + menuSubtitle.length();
+  return m;
+}
 
-  if (needsRedraw) markBodyDirty();
+void MenuBase::printMemoryUsage(Print& out) const {
+  const MemoryUsage m = getMemoryUsage();
+  out.print(F("menu: frame="));  out.print(m.frameBuffer);
+  out.print(F(" canvases="));    out.print(m.canvases);
+  out.print(F(" snapshot="));    out.print(m.snapshot);
+  out.print(F(" prerender="));   out.print(m.prerender);
+  out.print(F(" items="));       out.print(m.items);
+  out.print(F(" marquee="));     out.print(m.marquee);
+  out.print(F(" object="));      out.print(m.object);
+  out.print(F(" total="));       out.print(m.total());
+  out.print(F(" heap="));        out.print(m.heap);
+  out.println(F(" B"));
 }
 
 // --- drawing routines -------------------------------------------------------
 
-void Menu::drawTitle() {
+void MenuBase::drawTitle() {
   titleCanvas.fillScreen(MENU_BG_COLOR);
 
   titleCanvas.setTextColor(MENU_FG_COLOR);
@@ -425,127 +608,7 @@ void Menu::drawTitle() {
   titleCanvas.print(menuSubtitle);
 }
 
-void Menu::drawBody() {
-  // Clear body canvases
-  bodyLeftCanvas.fillScreen(MENU_BG_COLOR);
-  if (menuColumns == 2) bodyRightCanvas.fillScreen(MENU_BG_COLOR);
-
-  const uint8_t pi = getCurrentPageIndex();
-  const uint8_t s  = getPageStartIndex(pi);
-  const uint8_t e  = getPageEndIndex(pi);
-
-  // Text settings
-  bodyLeftCanvas.setTextColor(MENU_FG_COLOR);
-  bodyLeftCanvas.setTextSize(1);
-  if (menuColumns == 2) {
-    bodyRightCanvas.setTextColor(MENU_FG_COLOR);
-    bodyRightCanvas.setTextSize(1);
-  }
-
-  const uint16_t leftColWidthPx  = min<uint16_t>(charsPerCol * 6, bodyLeftCanvas.width());
-  const uint16_t rightColWidthPx = min<uint16_t>(charsPerCol * 6, bodyRightCanvas.width());
-
-  // Lay out items across columns; apply vertical animation offset
-  uint8_t row = 0, col = 0;
-  for (uint8_t i = s; i <= e; ++i) {
-    const uint16_t baseY = row * 8;
-    const int16_t  y     = baseY + bodyYOffsetPx; // smooth vertical scroll
-    String text = useStringItems ? itemAtS(i) : String(itemAtC(i));
-
-    // Clip (static fallback)
-    String clip = text;
-    if (clip.length() > charsPerCol) clip.remove(charsPerCol);
-
-    const uint8_t ip = i - s;   // per-page index
-    const bool isSelected = (i == currentItemIndex);
-    const bool useMarqueeForThisRow =
-      marqueeEnabled &&
-      ((marqueeMode == MarqueeMode::AllOverflow) || (marqueeMode == MarqueeMode::SelectedOnly && isSelected));
-
-    // Choose target canvas and width for current column
-    GFXcanvas1& target = (col == 0) ? bodyLeftCanvas :
-                         (menuColumns == 2 ? bodyRightCanvas : bodyLeftCanvas);
-    const uint16_t colWidthPx = (col == 0) ? leftColWidthPx :
-                                (menuColumns == 2 ? rightColWidthPx : leftColWidthPx);
-
-
-    // NEW: make sure this canvas won’t wrap long lines into the next row
-    target.setTextWrap(false);
-    target.setFont(NULL);
-
-    if (isSelected && selectedItemInverted) {
-      // Inverted row: MENU_FG_COLOR background, MENU_BG_COLOR text (mono)
-      target.fillRect(0, baseY, colWidthPx, 8, MENU_FG_COLOR);   // MENU_FG_COLOR row
-      target.setTextColor(MENU_BG_COLOR);                         // MENU_BG_COLOR text
-      //target.setCursor(rowMarqueeStates[ip].offsetPx, y);
-      //target.print(text);
-
-      if (useMarqueeForThisRow && rowMarqueeStates) {
-        int16_t x1, y1; uint16_t tw, th;
-        target.getTextBounds(text.c_str(), 0, 0, &x1, &y1, &tw, &th);
-        if (tw > colWidthPx) {
-          target.setCursor(rowMarqueeStates[ip].offsetPx, y);
-          target.print(text);
-          
-        //Serial.print(F(" ip="));
-        //Serial.print(ip);
-        //Serial.print(F(" offset="));
-        //Serial.println(rowMarqueeStates[ip].offsetPx);
-
-        } else {
-          target.setCursor(0, y);
-          target.print(clip);
-        }
-      } else {
-        target.setCursor(0, y);
-        target.print(clip);
-      }
-      
-      //Serial.print(F(" ip="));
-      //Serial.print(ip);
-      //Serial.print(F(" offset="));
-      //Serial.println(rowMarqueeStates[ip].offsetPx);
-
-      // Optional MENU_BG_COLOR outline around the MENU_FG_COLOR selected row
-      target.drawRect(0, y, colWidthPx, 8, MENU_BG_COLOR);
-    } else {
-      // Normal row: MENU_BG_COLOR background (already), MENU_FG_COLOR text
-      target.setTextColor(MENU_FG_COLOR);                         // MENU_FG_COLOR text
-
-      if (useMarqueeForThisRow && rowMarqueeStates) {
-        int16_t x1, y1; uint16_t tw, th;
-        target.getTextBounds(text.c_str(), 0, 0, &x1, &y1, &tw, &th);
-        //Serial.print(F(" ip="));
-        //Serial.print(ip);
-        //Serial.print(F(" offset="));
-        //Serial.println(rowMarqueeStates[ip].offsetPx);
-        if (tw > colWidthPx) {
-          // ensure clean row area for marquee
-          target.fillRect(0, baseY, colWidthPx, 8, MENU_BG_COLOR);   // MENU_BG_COLOR row clear
-          target.setCursor(rowMarqueeStates[ip].offsetPx, y);
-          target.print(text);
-        } else {
-          target.setCursor(0, y);
-          target.print(clip);
-        }
-      } else {
-        target.setCursor(0, y);
-        target.print(clip);
-      }
-
-      // If you still want a selection frame when not inverted:
-      if (isSelected) {
-        target.drawRect(0, y, colWidthPx, 8, MENU_FG_COLOR);     // MENU_FG_COLOR outline
-      }
-    }
-
-    // Next position
-    ++col;
-    if (col >= menuColumns) { col = 0; ++row; }
-  }
-}
-
-void Menu::drawStatus() {
+void MenuBase::drawStatus() {
   statusCanvas.fillScreen(MENU_BG_COLOR);
   statusCanvas.setTextColor(MENU_FG_COLOR);
   statusCanvas.setTextSize(1);
@@ -555,30 +618,126 @@ void Menu::drawStatus() {
 
 // --- blits ------------------------------------------------------------------
 
-void Menu::blitTitle() {
+void MenuBase::blitTitle() {
   display.drawBitmap(0, 0, titleCanvas.getBuffer(), titleCanvas.width(), titleCanvas.height(), MENU_FG_COLOR, MENU_BG_COLOR);
 }
-void Menu::blitBodyLeft() {
+void MenuBase::blitBodyLeft() {
   display.drawBitmap(0, 16, bodyLeftCanvas.getBuffer(), bodyLeftCanvas.width(), bodyLeftCanvas.height(), MENU_FG_COLOR, MENU_BG_COLOR);
 }
-void Menu::blitBodyRight() {
+void MenuBase::blitBodyRight() {
   if (menuColumns == 2) {
     display.drawBitmap(SCREEN_WIDTH / 2, 16, bodyRightCanvas.getBuffer(), bodyRightCanvas.width(), bodyRightCanvas.height(), MENU_FG_COLOR, MENU_BG_COLOR);
   }
 }
-void Menu::blitStatus() {
+void MenuBase::blitStatus() {
   if (useStatusBar) {
     display.drawBitmap(0, SCREEN_HEIGHT - 8, statusCanvas.getBuffer(), statusCanvas.width(), statusCanvas.height(), MENU_FG_COLOR, MENU_BG_COLOR);
   }
 }
 
+// --- live widgets ------------------------------------------------------------
+
+void MenuBase::drawWidgets() {
+  if (widgetsNeedFullDraw) {
+    display.fillRect(0, 16, SCREEN_WIDTH, SCREEN_HEIGHT - 16 - (useStatusBar ? 8 : 0), MENU_BG_COLOR);
+    markDisplayRegion(0, 16, SCREEN_WIDTH, SCREEN_HEIGHT - 16 - (useStatusBar ? 8 : 0));
+    widgetsNeedFullDraw = false;
+  }
+  for (uint8_t i = 0; i < widgetCount; ++i) {
+    MenuWidget* w = widgets[i];
+    if (!w->update()) continue;        // same text as on screen: nothing to draw or send
+    w->draw(display, MENU_FG_COLOR, MENU_BG_COLOR);
+    markDisplayRegion(w->getX(), w->getY(), w->getWidth(), w->getHeight());
+  }
+}
+
+// --- partial flush -----------------------------------------------------------
+
+void MenuBase::markDisplayRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+  // Clip to the panel
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > SCREEN_WIDTH)  w = SCREEN_WIDTH - x;
+  if (y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
+  if (w <= 0 || h <= 0) return;
+
+  const uint8_t c0 = uint8_t(x);
+  const uint8_t c1 = uint8_t(x + w - 1);
+  const uint8_t p1 = min<uint8_t>(uint8_t((y + h - 1) / 8), MAX_PAGES - 1);
+  for (uint8_t p = uint8_t(y / 8); p <= p1; ++p) {
+    const uint8_t bit = uint8_t(1 << p);
+    if (dirtyPageMask & bit) {
+      if (c0 < dirtyColMin[p]) dirtyColMin[p] = c0;
+      if (c1 > dirtyColMax[p]) dirtyColMax[p] = c1;
+    } else {
+      dirtyPageMask |= bit;
+      dirtyColMin[p] = c0;
+      dirtyColMax[p] = c1;
+    }
+  }
+}
+
+void MenuBase::sendWindow(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1) {
+  const uint8_t cmds[] = { SSD1306_PAGEADDR, page0, page1, SSD1306_COLUMNADDR, col0, col1 };
+
+  // Window data straight from the frame buffer, one span per page (full width = one span)
+  const uint8_t* fb = display.getBuffer();
+  DisplaySpan spans[MAX_PAGES];
+  uint8_t spanCount = 0;
+  if (col0 == 0 && col1 == SCREEN_WIDTH - 1) {
+    spans[spanCount++] = { fb + (uint16_t)page0 * SCREEN_WIDTH, uint16_t(SCREEN_WIDTH * (page1 - page0 + 1)) };
+  } else {
+    for (uint8_t p = page0; p <= page1; ++p) {
+      spans[spanCount++] = { fb + (uint16_t)p * SCREEN_WIDTH + col0, uint16_t(col1 - col0 + 1) };
+    }
+  }
+
+  const uint32_t bytesBefore = transport->getBytesWritten();
+  const uint32_t txBefore    = transport->getTransactionCount();
+  transport->sendWindow(cmds, sizeof(cmds), spans, spanCount);
+  renderStats.bytesFlushed    += transport->getBytesWritten() - bytesBefore;
+  renderStats.busTransactions += transport->getTransactionCount() - txBefore;
+}
+
+void MenuBase::sendFullFrame() {
+  if (hwScrollRunning) stopHardwareScroll();
+  sendWindow(0, uint8_t(SCREEN_WIDTH - 1), 0, uint8_t(min<uint8_t>(SCREEN_HEIGHT / 8, MAX_PAGES) - 1));
+}
+
+void MenuBase::sendPanelInit() {
+  // Same sequence Adafruit_SSD1306::begin() sends for an internal charge pump
+  const bool tall = (SCREEN_HEIGHT > 32);
+  const uint8_t init[] = {
+    SSD1306_DISPLAYOFF,
+    SSD1306_SETDISPLAYCLOCKDIV, 0x80,
+    SSD1306_SETMULTIPLEX, uint8_t(SCREEN_HEIGHT - 1),
+    SSD1306_SETDISPLAYOFFSET, 0x00,
+    SSD1306_SETSTARTLINE | 0x0,
+    SSD1306_CHARGEPUMP, 0x14,
+    SSD1306_MEMORYMODE, 0x00,                 // horizontal addressing: windows wrap page to page
+    SSD1306_SEGREMAP | 0x1,
+    SSD1306_COMSCANDEC,
+    SSD1306_SETCOMPINS, uint8_t(tall ? 0x12 : 0x02),
+    SSD1306_SETCONTRAST, uint8_t(tall ? 0xCF : 0x8F),
+    SSD1306_SETPRECHARGE, 0xF1,
+    SSD1306_SETVCOMDETECT, 0x40,
+    SSD1306_DISPLAYALLON_RESUME,
+    SSD1306_NORMALDISPLAY,
+    SSD1306_DEACTIVATE_SCROLL,
+    SSD1306_DISPLAYON
+  };
+  transport->sendCommands(init, sizeof(init));
+}
+
 // --- transition frame renderer ---------------------------------------------
 
-void Menu::renderTransitionFrame(uint32_t now) {
+bool MenuBase::renderTransitionFrame(uint32_t now) {
   // Progress [0..1]
   uint32_t elapsed = now - transitionStartMs;
-  float r = (elapsed >= pageTransitionDurationMs) ? 1.0f
-                                                  : (float)elapsed / (float)pageTransitionDurationMs;
+  if (pageTransitionType == TransitionType::ContrastFade) return renderContrastFade(elapsed);
+
+  float r = (elapsed >= activeTransitionMs) ? 1.0f
+                                            : (float)elapsed / (float)activeTransitionMs;
 
   // Clear body area first (to avoid stale pixels)
   display.fillRect(0, 16, SCREEN_WIDTH, SCREEN_HEIGHT - 16 - (useStatusBar ? 8 : 0), MENU_BG_COLOR);
@@ -620,17 +779,54 @@ void Menu::renderTransitionFrame(uint32_t now) {
     }
   }
 
-  if (elapsed >= pageTransitionDurationMs) {
+  if (elapsed >= activeTransitionMs) {
     // Transition completed
     transitionActive = false;
     // Finalize: mark body dirty so the steady state blit happens next refresh
     markBodyDirty();
   }
+  return true;
+}
+
+bool MenuBase::renderContrastFade(uint32_t elapsed) {
+  // Old page ramps down to blank, new page is written while the panel is off, then ramps up.
+  // Every frame is a two-byte contrast command; the page swap is the only buffer transfer.
+  const uint32_t half = max<uint32_t>(activeTransitionMs / 2, 1);
+  bool changed = false;
+
+  if (elapsed < half) {
+    setPanelContrast(uint8_t((uint32_t)contrastLevel * (half - elapsed) / half));
+  } else if (!fadeSwapped) {
+    sendPanelCommand(SSD1306_DISPLAYOFF);
+    panelBlanked = true;
+    display.fillRect(0, 16, SCREEN_WIDTH, SCREEN_HEIGHT - 16 - (useStatusBar ? 8 : 0), MENU_BG_COLOR);
+    blitBodyLeft();
+    blitBodyRight();
+    fadeSwapped = true;
+    changed = true;
+  } else if (panelBlanked) {
+    if (!dirtyPageMask) {             // new page fully in GDDRAM (flush may be sliced)
+      setPanelContrast(0);
+      sendPanelCommand(SSD1306_DISPLAYON);
+      panelBlanked = false;
+    }
+  } else {
+    const uint32_t up = min<uint32_t>(elapsed - half, half);
+    setPanelContrast(uint8_t((uint32_t)contrastLevel * up / half));
+  }
+
+  if (elapsed >= activeTransitionMs && fadeSwapped && !panelBlanked) {
+    endHardwareTransition();
+    transitionActive = false;         // body canvases already on screen: no steady-state redraw
+    dirtyBodyL = false;
+    dirtyBodyR = false;
+  }
+  return changed;
 }
 
 // --- math / helpers ---------------------------------------------------------
 
-uint8_t Menu::calculateAlignmentOffset(const String& text, uint8_t alignment) const {
+uint8_t MenuBase::calculateAlignmentOffset(const String& text, uint8_t alignment) const {
   const int16_t textLen = (int16_t)text.length();
   const int16_t cols    = (int16_t)displayColumns;
   int16_t offset = 0;
@@ -645,55 +841,110 @@ uint8_t Menu::calculateAlignmentOffset(const String& text, uint8_t alignment) co
   return (uint8_t)offset;
 }
 
-uint8_t Menu::getMaxItemsPerPage() const { return uint8_t(menuRows * menuColumns); }
-
-uint8_t Menu::getTotalPages() const {
-  const uint8_t mpp = getMaxItemsPerPage();
-  return mpp ? uint8_t((numberOfItems + mpp - 1) / mpp) : 0;
+void MenuBase::updateLayout() {
+  itemsPerPage = uint8_t(menuRows * menuColumns);
+  colWidthPx   = min<uint16_t>(uint16_t(charsPerCol) * 6, bodyLeftCanvas.width());
 }
 
-uint8_t Menu::getCurrentPageIndex() const {
+uint8_t MenuBase::getMaxItemsPerPage() const { return itemsPerPage; }
+
+uint16_t MenuBase::getCurrentPageIndex() const {
   const uint8_t mpp = getMaxItemsPerPage();
-  return mpp ? uint8_t(currentItemIndex / mpp) : 0;
+  return mpp ? uint16_t(currentItemIndex / mpp) : 0;
 }
 
-uint8_t Menu::getPageStartIndex(uint8_t pageIndex) const { return uint8_t(pageIndex * getMaxItemsPerPage()); }
+uint16_t MenuBase::getPageStartIndex(uint16_t pageIndex) const { return uint16_t(pageIndex * itemsPerPage); }
 
-uint8_t Menu::getPageEndIndex(uint8_t pageIndex) const {
+uint16_t MenuBase::getPageEndIndex(uint16_t pageIndex) const {
   const uint8_t mpp = getMaxItemsPerPage();
   if (!mpp || !numberOfItems) return 0;
-  const uint8_t end = uint8_t((pageIndex + 1) * mpp - 1);
-  return (end >= numberOfItems) ? uint8_t(numberOfItems - 1) : end;
+  const uint32_t end = (uint32_t)(pageIndex + 1) * mpp - 1;
+  return (end >= numberOfItems) ? uint16_t(numberOfItems - 1) : uint16_t(end);
 }
 
-uint8_t Menu::getVisibleItemsCount() const {
-  const uint8_t pi = getCurrentPageIndex();
-  const uint8_t s  = getPageStartIndex(pi);
-  const uint8_t e  = getPageEndIndex(pi);
+uint8_t MenuBase::getVisibleItemsCount() const {
+  const uint16_t pi = getCurrentPageIndex();
+  const uint16_t s  = getPageStartIndex(pi);
+  const uint16_t e  = getPageEndIndex(pi);
   return (e >= s) ? uint8_t(e - s + 1) : 0;
 }
 
-const char* Menu::itemAtC(uint8_t idx) const {
+const char* MenuBase::itemAtC(uint16_t idx) const {
   if (!itemsC || idx >= numberOfItems) return "";
   return itemsC[idx];
 }
-String Menu::itemAtS(uint8_t idx) const {
+String MenuBase::itemAtS(uint16_t idx) const {
   if (!itemsS || idx >= numberOfItems) return String("");
   return itemsS[idx];
 }
 
+const char* MenuBase::itemTextAt(uint16_t idx) {
+  if (idx >= numberOfItems) return "";
+  if (itemProvider) {
+    if (!itemCacheEnabled || !ensureItemCacheCapacity()) {
+      itemProvider->format(idx, itemScratch, sizeof(itemScratch));
+      itemScratch[sizeof(itemScratch) - 1] = '\0';
+      return itemScratch;
+    }
+    // Small LRU of formatted rows: a page redraw or marquee step hits it, scrolling refills one row
+    RowCacheSlot* victim = &itemCache[0];
+    for (uint8_t i = 0; i < itemCacheSlots; ++i) {
+      RowCacheSlot& slot = itemCache[i];
+      if (slot.index == idx) { slot.stamp = ++itemCacheClock; return slot.text; }
+      if (slot.stamp < victim->stamp) victim = &slot;
+    }
+    itemProvider->format(idx, victim->text, sizeof(victim->text));
+    victim->text[sizeof(victim->text) - 1] = '\0';
+    victim->index = idx;
+    victim->stamp = ++itemCacheClock;
+    return victim->text;
+  }
+  if (useStringItems) return itemsS ? itemsS[idx].c_str() : "";
+  return itemsC ? itemsC[idx] : "";
+}
+
+bool MenuBase::ensureItemCacheCapacity() {
+  const uint16_t wanted = uint16_t(itemsPerPage) * (prerenderEnabled ? 3 : 1);
+  const uint8_t  needed = uint8_t(wanted > 255 ? 255 : wanted);
+  if (needed == itemCacheSlots) return itemCache != nullptr;
+
+  if (itemCache != itemCacheStorage) delete[] itemCache;
+  itemCache = nullptr;
+  itemCacheSlots = needed;
+  if (needed <= itemCacheStorageCount) itemCache = itemCacheStorage; // caller storage: nothing allocated
+  else                                 itemCache = new RowCacheSlot[needed];
+  invalidateItemCache();
+  return itemCache != nullptr;
+}
+
+void MenuBase::invalidateItemCache() {
+  if (!itemCache) return;
+  for (uint8_t i = 0; i < itemCacheSlots; ++i) {
+    itemCache[i].index = 0xFFFF;
+    itemCache[i].stamp = 0;
+  }
+  itemCacheClock = 0;
+}
+
 // --- marquee core -----------------------------------------------------------
 
-void Menu::ensureMarqueeStateCapacity() {
+void MenuBase::ensureMarqueeStateCapacity() {
   uint8_t needed = getMaxItemsPerPage();
   if (needed == marqueeStateCount) return;
 
-  if (rowMarqueeStates) { delete[] rowMarqueeStates; rowMarqueeStates = nullptr; }
+  if (rowMarqueeStates != marqueeStorage) delete[] rowMarqueeStates;
+  rowMarqueeStates = nullptr;
   marqueeStateCount = needed;
-  if (needed > 0) rowMarqueeStates = new RowMarquee[needed];
+  if (needed == 0) return;
+  if (needed <= marqueeStorageCount) {
+    rowMarqueeStates = marqueeStorage;   // caller storage: nothing allocated
+    for (uint8_t i = 0; i < needed; ++i) rowMarqueeStates[i] = RowMarquee();
+  } else {
+    rowMarqueeStates = new RowMarquee[needed];
+  }
 }
 
-void Menu::resetPageMarqueeStates() {
+void MenuBase::resetPageMarqueeStates() {
   if (!rowMarqueeStates) return;
   uint8_t count = marqueeStateCount;
   uint32_t now = millis();
@@ -705,7 +956,7 @@ void Menu::resetPageMarqueeStates() {
   }
 }
 
-bool Menu::stepMarquee(RowMarquee& st, uint16_t textWidth, uint16_t colWidthPx, uint32_t now, uint16_t edgePauseMs) {
+bool MenuBase::stepMarquee(RowMarquee& st, uint16_t textWidth, uint16_t colWidthPx, uint32_t now, uint16_t edgePauseMs) {
   // Edge pause
   if (st.holdMs > 0) {
     uint32_t dt = now - st.lastMs;
@@ -740,13 +991,13 @@ bool Menu::stepMarquee(RowMarquee& st, uint16_t textWidth, uint16_t colWidthPx,
 
 // --- vertical smooth scroll -------------------------------------------------
 
-void Menu::startVerticalScroll(int8_t dir) {
+void MenuBase::startVerticalScroll(int8_t dir) {
   if (dir == 0) return;
   bodyScrollDir  = (dir < 0) ? -1 : +1;
   lastScrollMs   = millis();
 }
 
-bool Menu::stepVerticalScroll(uint32_t now) {
+bool MenuBase::stepVerticalScroll(uint32_t now) {
   uint32_t dt = now - lastScrollMs;
   if (dt == 0) return true;
   lastScrollMs = now;
@@ -761,48 +1012,159 @@ bool Menu::stepVerticalScroll(uint32_t now) {
   return true;   // continue animating
 }
 
+// --- input priority ---------------------------------------------------------
+
+bool MenuBase::isAnimating() const { return transitionActive || bodyScrollDir != 0; }
+
+void MenuBase::armNavLatency() {
+  if (navLatencyArmed) return;        // measure from the first press of a burst
+  navLatencyArmed = true;
+  navInputUs = micros();
+}
+
+void MenuBase::latchNavLatency() {
+  if (!navFrameArmed) navFrameInputUs = navInputUs; // a frame still in flight keeps its older press
+  navFrameArmed   = true;
+  navLatencyArmed = false;
+}
+
 // --- transitions (setup) ----------------------------------------------------
 
-void Menu::startPageTransition(int8_t dir, uint8_t newIndex) {
-  // Capture previous body canvases
-  size_t bytesLeft  = (bodyLeftCanvas.width()  * bodyLeftCanvas.height())  / 8;
-  size_t bytesRight = (bodyRightCanvas.width() * bodyRightCanvas.height()) / 8;
-  memcpy(prevBodyLeftCanvas.getBuffer(),  bodyLeftCanvas.getBuffer(),  bytesLeft);
-  memcpy(prevBodyRightCanvas.getBuffer(), bodyRightCanvas.getBuffer(), bytesRight);
+bool MenuBase::allocateSnapshotCanvases() {
+  if (prevBodyLeftCanvas.allocate() && prevBodyRightCanvas.allocate()) return true;
+  prevBodyLeftCanvas.release();
+  prevBodyRightCanvas.release();
+  return false;
+}
 
-  // Commit new index and draw new page into current body canvases
-  currentItemIndex = newIndex;
-  resetPageMarqueeStates();
-  drawBody(); // prepare new canvases immediately
+// --- pre-rendered neighbour pages -----------------------------------------------
+
+void MenuBase::setPrerenderEnabled(bool enable) {
+  prerenderEnabled = enable;
+  if (enable) return;
+  for (uint8_t i = 0; i < 2; ++i) {
+    prerender[i].left.release();
+    prerender[i].right.release();
+    prerender[i].generation = 0;
+  }
+}
+
+void MenuBase::invalidatePrerender() {
+  if (++contentGeneration == 0) contentGeneration = 1; // 0 marks an empty slot
+}
+
+// --- hardware animation -----------------------------------------------------
+
+uint16_t MenuBase::hardwareMarqueeCandidate() {
+  // Scroll engine rotates whole 128-px pages: only a single-column row, alone on its page,
+  // whose text (plus a gap) fits the page qualifies. Anything else stays in software.
+  if (!hardwareScrollEnabled || !marqueeEnabled || !numberOfItems || widgetCount ||
+      menuColumns != 1 || transitionActive || bodyScrollDir != 0) return NO_HW_ROW;
+
+  const uint16_t pi = getCurrentPageIndex();
+  const uint16_t s  = getPageStartIndex(pi);
+  const uint16_t e  = getPageEndIndex(pi);
+  const int16_t  bodyBottom = SCREEN_HEIGHT - (useStatusBar ? 8 : 0);
+
+  uint16_t found = NO_HW_ROW;
+  for (uint16_t i = s; i <= e; ++i) {
+    if (marqueeMode == MarqueeMode::SelectedOnly && i != currentItemIndex) continue;
+    int16_t x1, y1; uint16_t tw, th;
+    bodyLeftCanvas.getTextBounds(itemTextAt(i), 0, 0, &x1, &y1, &tw, &th);
+    if (tw <= colWidthPx) continue;
+    if (found != NO_HW_ROW) return NO_HW_ROW;                       // two rows would move
+    if (tw + MENU_HW_MARQUEE_GAP_PX > SCREEN_WIDTH) return NO_HW_ROW; // text longer than page RAM
+    if (16 + (int16_t)(i - s) * 8 + 8 > bodyBottom) return NO_HW_ROW;
+    found = i;
+  }
+  return found;
+}
+
+void MenuBase::drawHardwareMarqueeRow() {
+  // Full-width, unclipped: the panel rotates this page, so the text wraps round like a ticker
+  const int16_t y = 16 + (int16_t)(hwMarqueeRow - getPageStartIndex(getCurrentPageIndex())) * 8;
+  const bool inverted = selectedItemInverted && hwMarqueeRow == currentItemIndex;
+  display.fillRect(0, y, SCREEN_WIDTH, 8, inverted ? MENU_FG_COLOR : MENU_BG_COLOR);
+  display.setTextWrap(false);
+  display.setTextSize(1);
+  display.setTextColor(inverted ? MENU_BG_COLOR : MENU_FG_COLOR);
+  display.setCursor(0, y);
+  display.print(itemTextAt(hwMarqueeRow));
+  markDisplayRegion(0, y, SCREEN_WIDTH, 8);
+  hwRowInBuffer = true;
+}
+
+void MenuBase::startHardwareScroll() {
+  if (hwScrollRunning) return;
+  const uint8_t page = uint8_t(2 + (hwMarqueeRow - getPageStartIndex(getCurrentPageIndex())));
+
+  // Step interval in panel frames, nearest to the configured marquee speed
+  static const uint8_t  codes[]  = { 0x07, 0x04, 0x05, 0x00, 0x06, 0x01, 0x02, 0x03 };
+  static const uint16_t frames[] = { 2,    3,    4,    5,    25,   64,   128,  256  };
+  uint8_t best = 0;
+  uint32_t bestErr = 0xFFFFFFFFUL;
+  for (uint8_t k = 0; k < sizeof(frames) / sizeof(frames[0]); ++k) {
+    const uint32_t speed = MENU_OLED_FRAME_HZ / frames[k];
+    const uint32_t err = (speed > marqueeSpeedPxSec) ? speed - marqueeSpeedPxSec : marqueeSpeedPxSec - speed;
+    if (err < bestErr) { bestErr = err; best = k; }
+  }
+
+  const uint8_t cmds[] = {
+    SSD1306_DEACTIVATE_SCROLL,
+    SSD1306_LEFT_HORIZONTAL_SCROLL, 0x00, page, codes[best], page, 0x00, 0xFF,
+    SSD1306_ACTIVATE_SCROLL
+  };
+  transport->sendCommands(cmds, sizeof(cmds));
+  hwScrollPage    = page;
+  hwScrollRunning = true;
+  renderStats.hwScrollStarts++;
+}
+
+void MenuBase::stopHardwareScroll() {
+  sendPanelCommand(SSD1306_DEACTIVATE_SCROLL);
+  hwScrollRunning = false;
+  // GDDRAM holds the rotated row; the display buffer still has it unrotated
+  markDisplayRegion(0, (int16_t)hwScrollPage * 8, SCREEN_WIDTH, 8);
+}
+
+void MenuBase::setPanelContrast(uint8_t level) {
+  if (!initialized || error || level == panelContrast) return;
+  const uint8_t cmds[] = { SSD1306_SETCONTRAST, level };
+  transport->sendCommands(cmds, sizeof(cmds));
+  panelContrast = level;
+}
+
+void MenuBase::sendPanelCommand(uint8_t cmd) {
+  if (!initialized || error) return;
+  transport->sendCommands(&cmd, 1);
+}
 
-  // Activate transition
-  transitionActive   = true;
-  transitionDir      = (dir < 0) ? -1 : +1;
-  transitionStartMs  = millis();
-  // Title/status remain steady; redraw body only via renderTransitionFrame()
+void MenuBase::endHardwareTransition() {
+  if (panelBlanked) { sendPanelCommand(SSD1306_DISPLAYON); panelBlanked = false; }
+  setPanelContrast(contrastLevel);
+  fadeSwapped = false;
 }
 
 // --- hardware setters/getters ----------------------------------------------
 
-void Menu::setSDA_PIN(uint8_t sda)     { SDA_PIN = sda; }
-void Menu::setSCL_PIN(uint8_t scl)     { SCL_PIN = scl; }
-void Menu::setOLED_ADDR(uint8_t addr)  { OLED_ADDR = addr; }
-void Menu::setOLED_RESET(int8_t reset) { OLED_RESET = reset; }
-void Menu::setSCREEN_WIDTH(uint8_t width) {
+void MenuBase::setSDA_PIN(uint8_t sda)     { SDA_PIN = sda; }
+void MenuBase::setSCL_PIN(uint8_t scl)     { SCL_PIN = scl; }
+void MenuBase::setOLED_ADDR(uint8_t addr)  { OLED_ADDR = addr; }
+void MenuBase::setOLED_RESET(int8_t reset) { OLED_RESET = reset; }
+void MenuBase::setSCREEN_WIDTH(uint8_t width) {
   SCREEN_WIDTH = width; displayColumns = SCREEN_WIDTH / 6;
 }
-void Menu::setSCREEN_HEIGHT(uint8_t height) {
+void MenuBase::setSCREEN_HEIGHT(uint8_t height) {
   SCREEN_HEIGHT = height; displayRows = SCREEN_HEIGHT / 8;
 }
 
-uint8_t Menu::getSDA_PIN()       const { return SDA_PIN; }
-uint8_t Menu::getSCL_PIN()       const { return SCL_PIN; }
-uint8_t Menu::getOLED_ADDR()     const { return OLED_ADDR; }
-int8_t  Menu::getOLED_RESET()    const { return OLED_RESET; }
-uint8_t Menu::getSCREEN_WIDTH()  const { return SCREEN_WIDTH; }
-uint8_t Menu::getSCREEN_HEIGHT() const { return SCREEN_HEIGHT; }
+uint8_t MenuBase::getSDA_PIN()       const { return SDA_PIN; }
+uint8_t MenuBase::getSCL_PIN()       const { return SCL_PIN; }
+uint8_t MenuBase::getOLED_ADDR()     const { return OLED_ADDR; }
+int8_t  MenuBase::getOLED_RESET()    const { return OLED_RESET; }
+uint8_t MenuBase::getSCREEN_WIDTH()  const { return SCREEN_WIDTH; }
+uint8_t MenuBase::getSCREEN_HEIGHT() const { return SCREEN_HEIGHT; }
 
-//void Menu::setMENU_BG_COLOR(uint16_t color) { MENU_BG_COLOR = color ? 1 : 0; }
-void Menu::setMENU_BG_COLOR(uint16_t color) { MENU_BG_COLOR = color ? 1 : 0; }
-//void Menu::setMENU_FG_COLOR(uint16_t color) { MENU_FG_COLOR = color ? 1 : 0; }
-void Menu::setMENU_FG_COLOR(uint16_t color) { MENU_FG_COLOR = color ? 1 : 0; }
+void MenuBase::setMENU_BG_COLOR(uint16_t color) { MENU_BG_COLOR = color ? 1 : 0; invalidatePrerender(); }
+//void MenuBase::setMENU_FG_COLOR(uint16_t color) { MENU_FG_COLOR = color ? 1 : 0; }
+void MenuBase::setMENU_FG_COLOR(uint16_t color) { MENU_FG_COLOR = color ? 1 : 0; invalidatePrerender(); }
@@ -6,47 +6,123 @@
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "MenuWidget.h"
+#include "DisplayTransport.h"
+
+#define MENU_ITEM_MAX_CHARS 32 // longest formatted row kept for provider-backed lists
+#define MENU_OLED_FRAME_HZ     88 // SSD1306 refresh with the default clock/precharge (scroll steps per second / interval)
+#define MENU_HW_MARQUEE_GAP_PX 12 // blank run between the end and the start of a hardware-scrolled row
+
+/**
+ * Lazy item source for long lists (event logs, per-valve stats, schedule rows).
+ * Menu only asks for the rows on the visible page, so memory use does not
+ * depend on count().
+ */
+class MenuItemProvider {
+public:
+  virtual ~MenuItemProvider() {}
+  virtual uint16_t count() const = 0;
+  virtual void     format(uint16_t index, char* buf, size_t cap) const = 0; // NUL-terminated, cap includes NUL
+};
+
+/**
+ * GFXcanvas1 whose buffer is bound after construction: heap on allocate(), or
+ * caller-provided storage (FixedMenu) that is never freed.
+ * Needs Adafruit GFX 1.11+ (canvas constructor without allocation).
+ */
+class MenuCanvas : public GFXcanvas1 {
+public:
+  MenuCanvas(uint16_t w, uint16_t h) : GFXcanvas1(w, h, false) { buffer = nullptr; buffer_owned = false; }
+
+  void     setStorage(uint8_t* bytes) { storage = bytes; } // used by allocate() instead of the heap
+  bool     allocate();                // no-op if bound; false = out of memory
+  void     release();                 // frees a heap buffer, unbinds storage
+  bool     isAllocated() const { return buffer != nullptr; }
+  bool     isOnHeap()    const { return buffer != nullptr && buffer_owned; }
+  uint32_t bytes()       const { return uint32_t((width() + 7) / 8) * height(); }
+
+private:
+  uint8_t* storage = nullptr;
+};
+
+/**
+ * Adafruit_SSD1306 that can take its frame buffer without begin(): with a transport
+ * other than Wire the panel init goes through the transport, and begin() would send
+ * its own init on a Wire nobody has begun.
+ * - bindStorage() hands it caller memory (FixedMenu): begin() only mallocs a buffer
+ *   when none is set, and the destructor unbinds it before the library would free it.
+ */
+class MenuPanel : public Adafruit_SSD1306 {
+public:
+  MenuPanel(uint8_t w, uint8_t h, TwoWire* twi, int8_t rst_pin) : Adafruit_SSD1306(w, h, twi, rst_pin) {}
+  ~MenuPanel() { if (bound) buffer = nullptr; }
+
+  void bindStorage(uint8_t* bytes) { buffer = bytes; bound = (bytes != nullptr); } // W x H / 8, before begin()
+  bool allocateBuffer();              // W x H / 8 on the heap unless bound, cleared; no bus traffic
+  bool isOnHeap() const { return buffer != nullptr && !bound; }
+
+private:
+  bool bound = false;
+};
+
+template <uint16_t Width, uint16_t Height, uint8_t Rows, uint8_t Cols, bool StatusBar, bool Prerender>
+struct FixedMenuBuffers;
+template <uint8_t PerPage, uint8_t Columns>
+class PagedMenu;
 
 /**
  * Mono-only menu class for SSD1306 displays (ESP32/Arduino).
  * - Multi-canvas layout (title, body left/right, optional status) to reduce flicker.
  * - Per-row pixel-smooth marquee (horizontal) whenever text overflows its column.
  * - Pixel-smooth vertical scroll when moving within page rows.
- * - Page transition animations: slide (left/right) and temporal fade.
+ * - Page transition animations: slide (left/right), temporal fade, contrast fade through blank.
+ * - Hardware animation: a lone overflowing full-width row runs on the SSD1306 scroll engine,
+ *   contrast fades only send commands; no frame-buffer traffic while they run.
  * - NEW: Inverted selected item (white row, black text).
- * - RAII: predictable memory use, no raw new/delete for display/canvases.
+ * - Partial flush: only the 8-px pages/columns touched since the last refresh go over I2C.
+ * - Pluggable transport: Wire by default, or the IDF I2C driver (one transaction per window, up to 1 MHz).
+ * - Live widget pages: data-bound fields that redraw only when their text changes.
+ * - Virtual lists: item providers with 16-bit indices and an optional row LRU.
+ * - Render instrumentation: per-stage timings, bytes flushed, PBM frame dumps.
+ * - Input priority: presses during an animation snap it and coalesce into one short move.
+ * - Pre-render: next/previous pages drawn ahead in idle frames, so a page change starts with a copy.
+ * - Idle blanking: dim through the contrast register, then display-off; while off, tick/render/flush
+ *   return at once and marquees are frozen. The panel keeps its RAM, so waking is two commands.
+ * - RAII: predictable memory use, no raw new/delete for display/canvases; canvases of
+ *   disabled features are never allocated, getMemoryUsage() reports what is held.
+ *
+ * MenuBase holds the state and everything that does not depend on the page layout; the
+ * page engine (tick, render, navigation) is PagedMenu below. Declare one of its two forms:
+ * - Menu: rows/columns set at run time (setMenuRows()/setMenuColumns()).
+ * - FixedMenu<...>: layout fixed at compile time, so the page math and the per-row loops are
+ *   constants, and all canvases, marquee state and the row cache live in the object itself
+ *   (no heap beyond the item tables and strings the caller hands over).
  */
-class Menu {
+class MenuBase {
 public:
-  // Construct a menu for SSD1306; defaults match 128x64 panels on ESP32.
-  Menu(uint16_t screenWidth = 128,
-       uint16_t screenHeight = 64,
-       int8_t  reset        = -1,
-       uint8_t addr         = 0x3C,
-       uint8_t sda          = 21,
-       uint8_t scl          = 22,
-       bool    useStatusBar = false);
-
-  ~Menu();
-
   // --- Display lifecycle ---
-  void   initializeDisplay();        // Wire.begin(SDA,SCL), display.begin(...)
+  void   initializeDisplay();        // bus up, display.begin(...), panel init through the transport
+  void   setDisplayTransport(DisplayTransport* transport); // before initializeDisplay(); nullptr = Wire
+  void   setBusClock(uint32_t hz);   // built-in Wire transport only (default 400 kHz, max 1 MHz)
+  DisplayTransport& getDisplayTransport();
   bool   isDisplayInitialized() const;
   bool   displayHasError()    const;
   String getDisplayError()    const;
 
   // --- Menu content (two modes: const char* or String) ---
-  void setMenuItems(const char* const items[], uint8_t itemCount); // preferred (no heap churn)
+  void setMenuItems(const char* const items[], uint8_t itemCount); // copies the table (not the strings)
   void setMenuItems(const String items[],       uint8_t itemCount); // optional (dynamic text)
+  void setMenuItems(MenuItemProvider* provider);                     // virtual list (up to 65535 rows)
+  void borrowMenuItems(const char* const items[], uint16_t itemCount); // no copy: array must outlive its use
+  void invalidateItems();                        // provider content/count changed
+  void setItemCacheEnabled(bool enable);         // LRU of formatted provider rows (default on)
   void clearMenu();
 
   // --- Title / subtitle ---
   void setMenuTitle(const String& title,    uint8_t alignment = 0); // 0=left,1=center,2=right
   void setMenuSubtitle(const String& subtitle, uint8_t alignment = 0);
 
-  // --- Layout ---
-  void setMenuColumns(uint8_t columns);           // 1 or 2
-  void setMenuRows(uint8_t rows);                 // rows per column area
+  // --- Layout (rows/columns: Menu only) ---
   void setColumnNumberOfCharacters(uint8_t charsPerColumn); // clipping width in chars
   void setMenuItemScrolling(bool enable);         // wrap at list ends
 
@@ -61,35 +137,89 @@ public:
   void setMarqueeEdgePauseMs(uint16_t ms);        // default 600 ms pause at edges
   void setSelectedMarqueeEdgePauseMs(uint16_t ms);  // NEW: longer pause for selected row
   void setResetMarqueeOnIntraPageNav(bool enable);
+  void setHardwareScrollEnabled(bool enable);     // single-column rows may marquee on the panel (ticker style)
+  bool isHardwareScrolling() const;
 
   // --- Vertical smooth scroll controls ---
   void setSmoothScrollEnabled(bool enable);       // vertical scroll between rows
   void setScrollSpeed(uint16_t pxPerSec);         // default 120 px/s (row = 8 px)
 
   // --- Page transition animation ---
-  enum class TransitionType : uint8_t { None, Slide, Fade };
-  void setPageTransition(TransitionType type, uint16_t durationMs = 300);
+  enum class TransitionType : uint8_t { None, Slide, Fade, ContrastFade };
+  void setPageTransition(TransitionType type, uint16_t durationMs = 300); // Slide/Fade hold a page snapshot (2 body canvases)
+  void setContrast(uint8_t level);                // panel contrast, also the peak of ContrastFade
+  void setPrerenderEnabled(bool enable);          // keep neighbour pages ready (4 spare body canvases)
 
-  // --- Navigation ---
-  void     nextItem();                            // advances selection (animates if enabled)
-  void     previousItem();
-  void     setCurrentItemIndex(uint8_t index);
-  uint8_t  getCurrentItemIndex() const;
+  // --- Display power (idle blanking) ---
+  enum class DisplayPower : uint8_t { On, Dimmed, Off };
+  void setIdleTimeouts(uint32_t dimAfterMs, uint32_t offAfterMs, uint8_t dimContrast = 1); // 0 = never
+  bool wakeDisplay();                             // activity: full contrast, panel on; true if it was off
+  bool isDisplayAsleep() const;
+  DisplayPower getDisplayPower() const;
+
+  // --- Navigation (moves: PagedMenu) ---
+  uint16_t getCurrentItemIndex() const;
   const char* getCurrentItemC() const;            // returns "" if const-char mode inactive
   String   getCurrentItemS() const;               // returns "" if String mode inactive
 
+  // --- Live widgets (status pages) ---
+  void setWidgets(MenuWidget* const widgets[], uint8_t count); // replaces the item body until clearWidgets()
+  void clearWidgets();
+  bool hasWidgets() const;
+
   // --- Drawing / flicker control ---
   void markTitleDirty();
   void markBodyDirty();
   void markStatusDirty();
 
-  void showMenu();        // full redraw (marks and repaints all)
-  void refreshMenu();     // repaint only dirty canvases and blit them
   void clearDisplay();
-  void updateDisplay();   // display.display()
+  void updateDisplay();   // full frame through the transport
+  bool flushDisplay(uint8_t maxPages = 0xFF); // send changed regions; false = pages left for a later slice
+  uint32_t getBytesFlushed() const; // I2C payload sent so far (commands + data)
 
-  // --- Animation tick (call in loop) ---
-  void tick();            // advances marquee, vertical scroll, page transitions
+  // --- Render instrumentation ---
+  struct RenderTiming {
+    uint32_t count   = 0;
+    uint32_t totalUs = 0;
+    uint32_t maxUs   = 0;
+    void     add(uint32_t us) { ++count; totalUs += us; if (us > maxUs) maxUs = us; }
+    uint32_t avgUs() const    { return count ? totalUs / count : 0; }
+  };
+  struct RenderStats {
+    RenderTiming drawBody;              // page render into body canvases
+    RenderTiming tick;                  // marquee/scroll/transition bookkeeping
+    RenderTiming transitionFrame;       // one Slide/Fade frame composed into the display buffer
+    RenderTiming frame;                 // render start -> last dirty page sent (however many flush slices)
+    RenderTiming prerender;             // neighbour page drawn ahead in an idle frame
+    RenderTiming transitionStart;       // press -> first transition frame ready (snapshot + new page)
+    uint32_t     flushes      = 0;      // flushDisplay()/updateDisplay() that sent data
+    uint32_t     bytesFlushed = 0;      // I2C bytes (address + control + commands + data) over those flushes
+    uint32_t     busTransactions = 0;   // I2C START..STOP sequences over those flushes
+    uint32_t     hwScrollStarts  = 0;   // marquees handed to the panel's scroll engine
+    uint32_t     prerenderHits   = 0;   // page changes served from a pre-rendered page
+    uint32_t     prerenderMisses = 0;   // ... that had to render on the spot
+    uint32_t     navLatencyLastUs = 0;  // press -> first flushed frame showing it
+    uint32_t     navLatencyMaxUs  = 0;
+  };
+  const RenderStats& getRenderStats() const;
+  void resetRenderStats();
+  void printRenderStats(Print& out) const;   // one line per stage: count, avg/max us, bytes per frame
+  void dumpFramePBM(Print& out) const;       // binary P4 PBM of the display buffer (lit = white)
+
+  // --- Memory accounting ---
+  struct MemoryUsage {
+    uint32_t frameBuffer = 0;           // Adafruit_SSD1306 buffer (W x H / 8)
+    uint32_t canvases    = 0;           // title, body left/right, status
+    uint32_t snapshot    = 0;           // previous page for Slide/Fade, 0 otherwise
+    uint32_t prerender   = 0;           // neighbour pages, 0 while pre-render is off
+    uint32_t items       = 0;           // item arrays (+ String text in String mode, row cache in provider mode)
+    uint32_t marquee     = 0;           // per-row marquee states
+    uint32_t object      = 0;           // the Menu itself: stats, dirty spans
+    uint32_t heap        = 0;           // part of the above taken from the heap
+    uint32_t total() const { return frameBuffer + canvases + snapshot + prerender + items + marquee + object; }
+  };
+  MemoryUsage getMemoryUsage() const;
+  void printMemoryUsage(Print& out) const;
 
   // --- Hardware getters/setters ---
   void setSDA_PIN(uint8_t sda);
@@ -109,15 +239,59 @@ public:
   void setMENU_BG_COLOR(uint16_t color); // 0 or 1 (mono)
   void setMENU_FG_COLOR(uint16_t color); // 0 or 1 (mono)
 
+protected:
+  // Per-row marquee state (for visible items on current page)
+  struct RowMarquee {
+    int16_t   offsetPx = 0;
+    int8_t    dir      = -1;           // -1 left, +1 right
+    uint32_t  lastMs   = 0;
+    uint32_t  holdMs   = 0;            // remaining pause at edges
+  };
+
+  // One provider row formatted ahead of use
+  struct RowCacheSlot {
+    uint16_t index = 0xFFFF;           // 0xFFFF = empty
+    uint32_t stamp = 0;                // last use (LRU)
+    char     text[MENU_ITEM_MAX_CHARS + 1];
+  };
+
+  // Caller-owned buffers used instead of the heap (nullptr = heap, on demand), and the layout
+  struct Storage {
+    uint8_t*    frame         = nullptr;                              // panel frame buffer
+    uint8_t*    title         = nullptr;
+    uint8_t*    bodyLeft      = nullptr;
+    uint8_t*    bodyRight     = nullptr;
+    uint8_t*    status        = nullptr;
+    uint8_t*    snapshot[2]   = {nullptr, nullptr};                   // Slide/Fade previous page L/R
+    uint8_t*    prerender[4]  = {nullptr, nullptr, nullptr, nullptr}; // next L/R, prev L/R
+    RowMarquee* marquee       = nullptr;
+    uint8_t     marqueeCount  = 0;
+    RowCacheSlot* itemCache      = nullptr;
+    uint8_t       itemCacheCount = 0;
+    uint8_t       rows           = 6;                                 // as setMenuRows()/setMenuColumns()
+    uint8_t       columns        = 1;
+  };
+  MenuBase(uint16_t screenWidth, uint16_t screenHeight, int8_t reset, uint8_t addr, uint8_t sda, uint8_t scl,
+           bool useStatusBar, const Storage& storage);
+  ~MenuBase();                         // not virtual: held as Menu or FixedMenu, never deleted as MenuBase
+
+  void setMenuColumns(uint8_t columns);           // 1 or 2 (public on Menu)
+  void setMenuRows(uint8_t rows);                 // rows per column area
+
 private:
+  template <uint16_t, uint16_t, uint8_t, uint8_t, bool, bool> friend struct FixedMenuBuffers;
+  template <uint8_t, uint8_t> friend class PagedMenu;
+
   // --- Hardware / display ---
-  Adafruit_SSD1306 display;
+  MenuPanel        display;
   uint8_t SCREEN_WIDTH;
   uint8_t SCREEN_HEIGHT;
   int8_t  OLED_RESET;
   uint8_t OLED_ADDR;
   uint8_t SDA_PIN;
   uint8_t SCL_PIN;
+  WireDisplayTransport wireTransport;  // default transport (Wire)
+  DisplayTransport*    transport;      // every panel write goes through this
 
   bool   initialized = false;
   bool   error       = false;
@@ -130,15 +304,15 @@ private:
   uint16_t MENU_FG_COLOR = WHITE;          // WHITE
 
   // --- Canvases (current page) ---
-  GFXcanvas1 titleCanvas;              // (SCREEN_WIDTH x 16)
-  GFXcanvas1 bodyLeftCanvas;           // (SCREEN_WIDTH/2 x SCREEN_HEIGHT-16)
-  GFXcanvas1 bodyRightCanvas;          // same size; used only if columns==2
+  MenuCanvas titleCanvas;              // (SCREEN_WIDTH x 16)
+  MenuCanvas bodyLeftCanvas;           // (SCREEN_WIDTH/2 x SCREEN_HEIGHT-16)
+  MenuCanvas bodyRightCanvas;          // same size; used only if columns==2
   bool       useStatusBar;
-  GFXcanvas1 statusCanvas;             // (SCREEN_WIDTH x 8), optional
+  MenuCanvas statusCanvas;             // (SCREEN_WIDTH x 8), allocated only with a status bar
 
-  // --- Canvases (previous page snapshot for transitions) ---
-  GFXcanvas1 prevBodyLeftCanvas;       // same sizes as body canvases
-  GFXcanvas1 prevBodyRightCanvas;
+  // --- Canvases (previous page snapshot for Slide/Fade; not allocated for other transitions) ---
+  MenuCanvas prevBodyLeftCanvas;       // same sizes as body canvases
+  MenuCanvas prevBodyRightCanvas;
 
   // Dirty flags
   bool dirtyTitle  = true;
@@ -147,16 +321,32 @@ private:
   bool dirtyStatus = false;
 
   // --- Menu data (two modes) ---
-  const char** itemsC = nullptr;       // const char* mode
+  const char* const* itemsC = nullptr; // const char* mode
+  bool         itemsOwned = false;     // itemsC is our copy (setMenuItems) rather than borrowed
   String*      itemsS = nullptr;       // String mode
   bool         useStringItems = false;
-  uint8_t      numberOfItems = 0;
-  uint8_t      currentItemIndex = 0;
+  uint16_t     numberOfItems = 0;
+  uint16_t     currentItemIndex = 0;
+
+  // --- Provider mode: rows formatted on demand ---
+  MenuItemProvider* itemProvider = nullptr;
+  // Sized on first use to a page of rows, three pages with pre-render (current + both
+  // neighbours), so drawing the neighbours does not evict the rows on screen
+  RowCacheSlot* itemCache = nullptr;
+  uint8_t       itemCacheSlots = 0;
+  RowCacheSlot* itemCacheStorage = nullptr;  // caller-owned slots (FixedMenu), used when large enough
+  uint8_t       itemCacheStorageCount = 0;
+  uint32_t     itemCacheClock = 0;
+  bool         itemCacheEnabled = true;
+  char         itemScratch[MENU_ITEM_MAX_CHARS + 1]; // uncached provider row
 
   // Layout/behavior
   uint8_t menuColumns = 1;             // 1 or 2
   uint8_t menuRows    = 6;             // rows per column
   uint8_t charsPerCol = 16;            // clipping width
+  // Derived once per layout change instead of on every tick/draw
+  uint8_t  itemsPerPage = 6;           // menuRows * menuColumns
+  uint16_t colWidthPx   = 64;          // min(charsPerCol * 6, body canvas width)
   bool    menuItemScrolling = false;
 
   String  menuTitle;
@@ -167,15 +357,11 @@ private:
   // --- NEW: inverted selected row flag ---
   bool    selectedItemInverted = false;
 
-  // --- Per-row marquee states (for visible items on current page) ---
-  struct RowMarquee {
-    int16_t   offsetPx = 0;
-    int8_t    dir      = -1;           // -1 left, +1 right
-    uint32_t  lastMs   = 0;
-    uint32_t  holdMs   = 0;            // remaining pause at edges
-  };
+  // --- Per-row marquee states ---
   RowMarquee* rowMarqueeStates = nullptr;
   uint8_t marqueeStateCount = 0;   // = getMaxItemsPerPage()
+  RowMarquee* marqueeStorage = nullptr;  // caller-owned states (FixedMenu), used when large enough
+  uint8_t marqueeStorageCount = 0;
   bool marqueeEnabled = true;
   MarqueeMode marqueeMode = MarqueeMode::SelectedOnly;
   uint16_t marqueeSpeedPxSec = 30;
@@ -193,37 +379,118 @@ private:
   // --- Page transition animation ---
   TransitionType pageTransitionType   = TransitionType::Slide;
   uint16_t       pageTransitionDurationMs = 300;
+  uint16_t       activeTransitionMs    = 300;  // duration of the running transition (shortened when coalesced)
   bool           transitionActive      = false;
   int8_t         transitionDir         = +1;  // +1 = next (slide left), -1 = prev (slide right)
   uint32_t       transitionStartMs     = 0;
 
+  // --- Hardware animation (SSD1306 scroll engine / contrast register) ---
+  static const uint16_t NO_HW_ROW = 0xFFFF;
+  bool     hardwareScrollEnabled = false;
+  uint16_t hwMarqueeRow    = NO_HW_ROW;  // item scrolled by the panel, NO_HW_ROW = software marquee
+  bool     hwRowInBuffer   = false;      // full-width row drawn into the display buffer
+  bool     hwScrollRunning = false;      // panel is scrolling; GDDRAM must not be written
+  uint8_t  hwScrollPage    = 0;          // display page being scrolled
+  uint8_t  contrastLevel;                // configured contrast
+  uint8_t  panelContrast;                // contrast currently set on the panel
+  bool     fadeSwapped     = false;      // ContrastFade: new page written at the blank point
+  bool     panelBlanked    = false;      // ContrastFade: display off while the new page goes out
+
+  // --- Display power ---
+  DisplayPower displayPower   = DisplayPower::On;
+  uint32_t     dimAfterMs     = 0;       // 0 = never dim
+  uint32_t     offAfterMs     = 0;       // 0 = never blank
+  uint8_t      dimContrast    = 1;
+  uint32_t     lastActivityMs = 0;       // last wakeDisplay() / navigation
+
+  // --- Pre-rendered neighbour pages ---
+  static const uint8_t PRERENDER_NEXT = 0;
+  static const uint8_t PRERENDER_PREV = 1;
+  struct PrerenderSlot {
+    PrerenderSlot(uint16_t w, uint16_t h) : left(w, h), right(w, h) {}
+    MenuCanvas left;                     // allocated on first use
+    MenuCanvas right;
+    uint16_t page       = 0;
+    uint16_t selected   = 0;
+    uint32_t generation = 0;             // contentGeneration it was drawn for, 0 = empty
+  };
+  bool          prerenderEnabled  = false;
+  PrerenderSlot prerender[2];
+  uint32_t      contentGeneration = 1;   // bumped when items/layout/colours change what a page looks like
+
+  // --- Input priority: presses arriving mid-animation ---
+  int16_t  pendingNavSteps = 0;        // net next(+)/previous(-) presses not applied yet
+  bool     navLatencyArmed = false;    // a press is waiting for a render that shows it
+  uint32_t navInputUs      = 0;        // ... the first of them
+  bool     navFrameArmed   = false;    // the frame being flushed shows a press
+  uint32_t navFrameInputUs = 0;        // ... the oldest one it shows
+
+  // --- Live widgets ---
+  MenuWidget* const* widgets = nullptr;  // caller-owned array
+  uint8_t widgetCount = 0;
+  bool    widgetsNeedFullDraw = false;
+
+  // --- Partial flush: dirty column span per 8-px page ---
+  static const uint8_t MAX_PAGES = 8;  // 64 px panels
+  uint8_t  dirtyPageMask = 0;
+  uint8_t  dirtyColMin[MAX_PAGES];
+  uint8_t  dirtyColMax[MAX_PAGES];
+  RenderStats renderStats;
+  bool        frameOpen    = false;    // rendered pages are waiting for flushDisplay()
+  uint32_t    frameStartUs = 0;
+
   // --- helpers: drawing ---
   void drawTitle();
-  void drawBody();          // draws current page into body canvases
   void drawStatus();
-
   void blitTitle();
   void blitBodyLeft();
   void blitBodyRight();
   void blitStatus();
+  void drawWidgets();
+
+  // --- helpers: partial flush ---
+  void markDisplayRegion(int16_t x, int16_t y, int16_t w, int16_t h);
+  void sendWindow(uint8_t col0, uint8_t col1, uint8_t page0, uint8_t page1);
+  void sendFullFrame();
+  void sendPanelInit();             // SSD1306 init sequence for transports other than Wire
+
+  // --- helpers: hardware animation ---
+  uint16_t hardwareMarqueeCandidate();
+  void drawHardwareMarqueeRow();
+  void startHardwareScroll();
+  void stopHardwareScroll();        // also re-marks the scrolled page: its GDDRAM is stale
+  void setPanelContrast(uint8_t level);
+  void sendPanelCommand(uint8_t cmd);
+  bool renderContrastFade(uint32_t elapsed);
+  void endHardwareTransition();     // panel back on at full contrast
+
+  // --- helpers: display power ---
+  void resumeAnimationClocks(uint32_t now);  // marquee/scroll continue where they stopped
 
   // Transition frame renderer
-  void renderTransitionFrame(uint32_t now);
+  bool renderTransitionFrame(uint32_t now); // false = display buffer unchanged this frame
+
+  // --- helpers: memory accounting ---
+  static uint32_t canvasBytes(const MenuCanvas& canvas);
+  void releaseItems();
 
-  // --- helpers: layout math ---
+  // --- helpers: layout math (runtime; the page engine has its own) ---
+  void updateLayout();                   // refreshes itemsPerPage / colWidthPx
   uint8_t calculateAlignmentOffset(const String& text, uint8_t alignment) const;
-  uint8_t getMaxItemsPerPage() const;
-  uint8_t getTotalPages() const;
-  uint8_t getCurrentPageIndex() const;
-  uint8_t getPageStartIndex(uint8_t pageIndex) const;
-  uint8_t getPageEndIndex(uint8_t pageIndex) const;
-  uint8_t getVisibleItemsCount() const;
+  uint8_t  getMaxItemsPerPage() const;
+  uint16_t getCurrentPageIndex() const;
+  uint16_t getPageStartIndex(uint16_t pageIndex) const;
+  uint16_t getPageEndIndex(uint16_t pageIndex) const;
+  uint8_t  getVisibleItemsCount() const;
 
-  const char* itemAtC(uint8_t idx) const;
-  String      itemAtS(uint8_t idx) const;
+  const char* itemAtC(uint16_t idx) const;
+  String      itemAtS(uint16_t idx) const;
+  const char* itemTextAt(uint16_t idx);   // any mode; provider rows come from the LRU/scratch
+  void        invalidateItemCache();
 
   // --- helpers: marquee core ---
   void ensureMarqueeStateCapacity();
+  bool ensureItemCacheCapacity();        // false = no slots: format uncached
   void resetPageMarqueeStates();
   bool stepMarquee(RowMarquee& st, uint16_t textWidth, uint16_t colWidthPx, uint32_t now, uint16_t edgePauseMs);
 
@@ -232,11 +499,654 @@ private:
   bool stepVerticalScroll(uint32_t now);  // returns true while animating
 
   // --- helpers: transitions (setup) ---
-  void startPageTransition(int8_t dir, uint8_t newIndex); // captures prev canvases, sets new page
+  bool allocateSnapshotCanvases();       // false = no RAM for Slide/Fade
+
+  // --- helpers: pre-render ---
+  void invalidatePrerender();
+
+  // --- helpers: input priority ---
+  bool isAnimating() const;
+  void armNavLatency();
+  void latchNavLatency();                // render: the presses so far are in this frame
 
   // non-copyable
-  Menu(const Menu&) = delete;
-  Menu& operator=(const Menu&) = delete;
+  MenuBase(const MenuBase&) = delete;
+  MenuBase& operator=(const MenuBase&) = delete;
+};
+
+/**
+ * Page engine: tick, render and navigation for one page layout. PerPage/Columns = 0 take
+ * the layout from MenuBase (Menu); anything else is the layout (FixedMenu), so the page math
+ * folds to constants and the row loops run a fixed count.
+ */
+template <uint8_t PerPage, uint8_t Columns>
+class PagedMenu : public MenuBase {
+public:
+  // --- Display power ---
+  void sleepDisplay();                            // last frame out, panel off until wakeDisplay()
+
+  // --- Navigation ---
+  void nextItem();                                // advances selection (animates if enabled)
+  void previousItem();
+  void setCurrentItemIndex(uint16_t index);
+
+  // --- Drawing ---
+  void showMenu();        // full redraw (marks and repaints all)
+  void refreshMenu();     // renderMenu() + flushDisplay()
+  void renderMenu();      // repaint dirty canvases into the display buffer, no I2C
+
+  // --- Animation tick (call in loop) ---
+  void tick();            // advances marquee, vertical scroll, page transitions
+
+protected:
+  PagedMenu(uint16_t screenWidth, uint16_t screenHeight, int8_t reset, uint8_t addr, uint8_t sda, uint8_t scl,
+            bool useStatusBar, const Storage& storage)
+    : MenuBase(screenWidth, screenHeight, reset, addr, sda, scl, useStatusBar, storage) {}
+
+private:
+  // --- page math ---
+  uint8_t  getMaxItemsPerPage() const { return PerPage ? PerPage : itemsPerPage; }
+  uint8_t  getPageColumns()     const { return Columns ? Columns : menuColumns; }
+  uint16_t getTotalPages() const;
+  uint16_t getCurrentPageIndex() const { return getMaxItemsPerPage() ? uint16_t(currentItemIndex / getMaxItemsPerPage()) : 0; }
+  uint16_t getPageStartIndex(uint16_t pageIndex) const { return uint16_t(pageIndex * getMaxItemsPerPage()); }
+  uint16_t getPageEndIndex(uint16_t pageIndex) const;
+
+  // --- drawing ---
+  void drawBody();          // draws current page into body canvases
+  void drawPage(uint16_t pageIndex, uint16_t selectedIndex, GFXcanvas1& left, GFXcanvas1& right,
+                int16_t yOffsetPx, bool liveMarquee);
+  bool stepPageMarquees(uint32_t now);       // true = a row moved or was reset
+
+  bool updateDisplayPower(uint32_t now);     // dim / blank on idle; false once the panel went off
+  void applyPendingNavigation();             // snap running animation, jump to the merged target
+  void startPageTransition(int8_t dir, uint16_t newIndex, uint16_t durationMs); // captures prev canvases, sets new page
+  bool adjacentPageTarget(int8_t dir, uint16_t& page, uint16_t& selected) const;
+  void prerenderStep();
+};
+
+// --- page engine (header: FixedMenu instantiates it with its layout) ---
+
+template <uint8_t PerPage, uint8_t Columns>
+uint16_t PagedMenu<PerPage, Columns>::getTotalPages() const {
+  const uint8_t mpp = getMaxItemsPerPage();
+  return mpp ? uint16_t((numberOfItems + mpp - 1) / mpp) : 0;
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+uint16_t PagedMenu<PerPage, Columns>::getPageEndIndex(uint16_t pageIndex) const {
+  const uint8_t mpp = getMaxItemsPerPage();
+  if (!mpp || !numberOfItems) return 0;
+  const uint32_t end = (uint32_t)(pageIndex + 1) * mpp - 1;
+  return (end >= numberOfItems) ? uint16_t(numberOfItems - 1) : uint16_t(end);
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::showMenu() {
+  dirtyTitle = dirtyBodyL = true;
+  dirtyBodyR = (getPageColumns() == 2);
+  dirtyStatus = useStatusBar;
+  refreshMenu();
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::refreshMenu() {
+  if (!initialized || error || displayPower == DisplayPower::Off) return;
+
+  renderMenu();
+  flushDisplay();
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::renderMenu() {
+  if (!initialized || error || displayPower == DisplayPower::Off) return; // dirty flags wait for the wake
+
+  const uint32_t t0 = micros();
+  uint32_t now = millis();
+  const int16_t bodyH = SCREEN_HEIGHT - 16;
+  if (navLatencyArmed && pendingNavSteps == 0) latchNavLatency();
+
+  if (dirtyTitle && !transitionActive)  { drawTitle();  blitTitle(); markDisplayRegion(0, 0, SCREEN_WIDTH, 16); dirtyTitle = false; }
+
+  // During transitions, body is rendered via renderTransitionFrame()
+  if (transitionActive) {
+    const uint32_t tf = micros();
+    const bool changed = renderTransitionFrame(now);
+    renderStats.transitionFrame.add(micros() - tf);
+    if (changed) markDisplayRegion(0, 16, SCREEN_WIDTH, bodyH);
+  } else if (widgetCount) {
+    drawWidgets();
+  } else {
+    const bool bodyDrawn = dirtyBodyL;
+    if (dirtyBodyL)  { drawBody();   blitBodyLeft();   markDisplayRegion(0, 16, SCREEN_WIDTH / 2, bodyH); dirtyBodyL = false; }
+    if (getPageColumns() == 2 && dirtyBodyR) {
+      blitBodyRight(); markDisplayRegion(SCREEN_WIDTH / 2, 16, SCREEN_WIDTH / 2, bodyH); dirtyBodyR = false;
+    }
+    if (hwMarqueeRow != NO_HW_ROW && (bodyDrawn || !hwRowInBuffer)) drawHardwareMarqueeRow();
+  }
+
+  if (useStatusBar && dirtyStatus && !transitionActive) { drawStatus(); blitStatus(); markDisplayRegion(0, SCREEN_HEIGHT - 8, SCREEN_WIDTH, 8); dirtyStatus = false; }
+
+  // No page animation this frame: spend it on one stale neighbour page
+  if (prerenderEnabled && !isAnimating() && pendingNavSteps == 0 && !widgetCount) prerenderStep();
+
+  // A frame runs from the render that first dirtied the buffer to the flush that empties it
+  if (dirtyPageMask && !frameOpen) { frameOpen = true; frameStartUs = t0; }
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::tick() {
+  if (!initialized || error || displayPower == DisplayPower::Off) return; // blanked: marquees frozen
+
+  const uint32_t t0 = micros();
+  uint32_t now = millis();
+  bool needsRedraw = false;
+
+  if (!updateDisplayPower(now)) return;
+
+  // Input first: queued presses cancel whatever is animating
+  if (pendingNavSteps != 0) applyPendingNavigation();
+
+  // Vertical smooth scroll (within page)
+  if (bodyScrollDir != 0) {
+    if (stepVerticalScroll(now)) {
+      needsRedraw = true;
+    } else {
+      // commit index after finishing 1 row
+      currentItemIndex += (bodyScrollDir > 0 ? 1 : -1);
+      bodyScrollDir = 0;
+      bodyYOffsetPx = 0;
+      resetPageMarqueeStates();
+      needsRedraw = true;
+    }
+  }
+
+  // Page transition active? We just mark needsRedraw; rendering happens in refreshMenu()
+  if (transitionActive) {
+    needsRedraw = true;
+  }
+
+  // Hardware marquee: a lone overflowing single-column row moves on the panel by itself
+  const uint16_t hwRow = hardwareMarqueeCandidate();
+  if (hwRow != hwMarqueeRow) {
+    if (hwScrollRunning) stopHardwareScroll();
+    hwMarqueeRow  = hwRow;
+    hwRowInBuffer = false;
+    needsRedraw   = true;
+  }
+
+  // Per-row marquee: step each visible row if enabled (items are hidden on widget pages)
+  if (marqueeEnabled && numberOfItems && !widgetCount && hwMarqueeRow == NO_HW_ROW && stepPageMarquees(now)) {
+    needsRedraw = true;
+  }
+
+  if (needsRedraw) markBodyDirty();
+  renderStats.tick.add(micros() - t0);
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::sleepDisplay() {
+  if (!initialized || error || displayPower == DisplayPower::Off) return;
+
+  // Finish whatever moves so the frame left in GDDRAM is the settled page
+  if (transitionActive) {
+    if (pageTransitionType == TransitionType::ContrastFade) endHardwareTransition();
+    transitionActive = false;
+    markBodyDirty();
+  }
+  if (bodyScrollDir != 0) {
+    currentItemIndex += (bodyScrollDir > 0 ? 1 : -1);
+    bodyScrollDir = 0;
+    bodyYOffsetPx = 0;
+    markBodyDirty();
+  }
+  if (hwScrollRunning) stopHardwareScroll(); // the scroll engine would keep rotating GDDRAM
+  hwMarqueeRow  = NO_HW_ROW;                 // picked again by the first tick after waking
+  hwRowInBuffer = false;
+  refreshMenu();
+
+  sendPanelCommand(SSD1306_DISPLAYOFF);
+  displayPower = DisplayPower::Off;
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+bool PagedMenu<PerPage, Columns>::updateDisplayPower(uint32_t now) {
+  if (isAnimating() || pendingNavSteps != 0) return true; // transitions own the contrast register
+  const uint32_t idle = now - lastActivityMs;
+  if (offAfterMs && idle >= offAfterMs) {
+    sleepDisplay();
+    return false;
+  }
+  if (dimAfterMs && idle >= dimAfterMs && displayPower == DisplayPower::On) {
+    setPanelContrast(min(dimContrast, contrastLevel));
+    displayPower = DisplayPower::Dimmed;
+  }
+  return true;
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::nextItem() {
+  if (!numberOfItems) return;
+  wakeDisplay();
+  armNavLatency();
+  if (isAnimating()) { pendingNavSteps++; return; } // merged and applied by the next tick()
+  
+  uint16_t oldPage = getCurrentPageIndex();         // NEW
+  uint16_t curPage = getCurrentPageIndex();
+  uint16_t endIdx  = getPageEndIndex(curPage);
+  bool staysInPage = (currentItemIndex < endIdx);
+
+  if (currentItemIndex < numberOfItems - 1) {
+    if (smoothScrollEnabled && staysInPage && pageTransitionType == TransitionType::None) {
+      startVerticalScroll(+1);
+    } else if (!staysInPage && pageTransitionType != TransitionType::None) {
+      startPageTransition(+1, currentItemIndex + 1, pageTransitionDurationMs);  // keeps reset call inside transition
+    } else {
+      currentItemIndex++;
+      // RESET ONLY IF PAGE CHANGED
+      uint16_t newPage = getCurrentPageIndex();      // NEW
+      if (resetMarqueeOnIntraPageNav || (newPage != oldPage)) resetPageMarqueeStates(); // NEW
+      //resetPageMarqueeStates();
+      markBodyDirty();
+    }
+  } else if (menuItemScrolling) {
+    // wrap to first item (page transition optional)
+    if (pageTransitionType != TransitionType::None) {
+      startPageTransition(+1, 0, pageTransitionDurationMs);
+    } else {
+      currentItemIndex = 0;
+      resetPageMarqueeStates();  // wrap ⇒ page likely changed; OK to reset
+      markBodyDirty();
+    }
+  }
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::previousItem() {
+  if (!numberOfItems) return;
+  wakeDisplay();
+  armNavLatency();
+  if (isAnimating()) { pendingNavSteps--; return; }
+  
+  uint16_t oldPage = getCurrentPageIndex();         // NEW
+  uint16_t curPage = getCurrentPageIndex();
+  uint16_t startIdx = getPageStartIndex(curPage);
+  bool staysInPage = (currentItemIndex > startIdx);
+
+  if (currentItemIndex > 0) {
+    if (smoothScrollEnabled && staysInPage && pageTransitionType == TransitionType::None) {
+      startVerticalScroll(-1);
+    } else if (!staysInPage && pageTransitionType != TransitionType::None) {
+      startPageTransition(-1, currentItemIndex - 1, pageTransitionDurationMs);
+    } else {
+      currentItemIndex--;
+      // RESET ONLY IF PAGE CHANGED
+      uint16_t newPage = getCurrentPageIndex();     // NEW
+      if (resetMarqueeOnIntraPageNav || (newPage != oldPage)) resetPageMarqueeStates();
+      markBodyDirty();
+    }
+  } else if (menuItemScrolling) {
+    // wrap to last item
+    uint16_t last = numberOfItems ? (numberOfItems - 1) : 0;
+    if (pageTransitionType != TransitionType::None) {
+      startPageTransition(-1, last, pageTransitionDurationMs);
+    } else {
+      currentItemIndex = last;
+      resetPageMarqueeStates(); // wrap ⇒ page likely changed; OK to reset
+      markBodyDirty();
+    }
+  }
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::setCurrentItemIndex(uint16_t index) {
+  if (index < numberOfItems) {
+    uint16_t oldPage = getCurrentPageIndex();       // NEW
+    currentItemIndex = index;
+    uint16_t newPage = getCurrentPageIndex();       // NEW
+    if (resetMarqueeOnIntraPageNav || (newPage != oldPage)) resetPageMarqueeStates();
+    markBodyDirty();
+  }
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::applyPendingNavigation() {
+  // Snap the running animation to its end state
+  if (bodyScrollDir != 0) {
+    currentItemIndex += (bodyScrollDir > 0 ? 1 : -1);
+    bodyScrollDir = 0;
+    bodyYOffsetPx = 0;
+  }
+  if (transitionActive) endHardwareTransition();
+  transitionActive = false;           // new page was committed when the transition started
+
+  // Merge the queued presses into one target
+  const int16_t steps = pendingNavSteps;
+  pendingNavSteps = 0;
+  int32_t target = (int32_t)currentItemIndex + steps;
+  if (menuItemScrolling) {
+    target %= (int32_t)numberOfItems;
+    if (target < 0) target += numberOfItems;
+  } else {
+    if (target < 0) target = 0;
+    if (target >= (int32_t)numberOfItems) target = numberOfItems - 1;
+  }
+
+  const uint16_t oldPage = getCurrentPageIndex();
+  const uint16_t newPage = uint16_t(target / getMaxItemsPerPage());
+  if (newPage != oldPage && pageTransitionType != TransitionType::None) {
+    // One short transition straight to the final page, however many pages were skipped
+    startPageTransition(steps > 0 ? +1 : -1, uint16_t(target), pageTransitionDurationMs / 2);
+  } else {
+    currentItemIndex = uint16_t(target);
+    if (resetMarqueeOnIntraPageNav || newPage != oldPage) resetPageMarqueeStates();
+  }
+  markBodyDirty();
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::startPageTransition(int8_t dir, uint16_t newIndex, uint16_t durationMs) {
+  const uint32_t t0 = micros();
+  // Capture previous body canvases (ContrastFade has none: the old page stays on the panel)
+  size_t bytesLeft  = (bodyLeftCanvas.width()  * bodyLeftCanvas.height())  / 8;
+  size_t bytesRight = (bodyRightCanvas.width() * bodyRightCanvas.height()) / 8;
+  if (prevBodyLeftCanvas.isAllocated()) {
+    memcpy(prevBodyLeftCanvas.getBuffer(),  bodyLeftCanvas.getBuffer(),  bytesLeft);
+    memcpy(prevBodyRightCanvas.getBuffer(), bodyRightCanvas.getBuffer(), bytesRight);
+  }
+
+  // Commit new index; take the new page from the pre-render if it is the one we need
+  currentItemIndex = newIndex;
+  resetPageMarqueeStates();
+  PrerenderSlot& slot = prerender[dir > 0 ? PRERENDER_NEXT : PRERENDER_PREV];
+  if (prerenderEnabled && slot.left.isAllocated() && slot.generation == contentGeneration &&
+      slot.page == getCurrentPageIndex() && slot.selected == newIndex) {
+    memcpy(bodyLeftCanvas.getBuffer(),  slot.left.getBuffer(),  bytesLeft);
+    memcpy(bodyRightCanvas.getBuffer(), slot.right.getBuffer(), bytesRight);
+    renderStats.prerenderHits++;
+  } else {
+    drawBody(); // coalesced multi-page jump or content changed: render now
+    renderStats.prerenderMisses++;
+  }
+  slot.generation = 0;                // neighbours moved with the page
+
+  // Activate transition
+  transitionActive   = true;
+  transitionDir      = (dir < 0) ? -1 : +1;
+  transitionStartMs  = millis();
+  activeTransitionMs = durationMs ? durationMs : 1;
+  fadeSwapped        = false;
+  // Title/status remain steady; redraw body only via renderTransitionFrame()
+  renderStats.transitionStart.add(micros() - t0);
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+bool PagedMenu<PerPage, Columns>::adjacentPageTarget(int8_t dir, uint16_t& page, uint16_t& selected) const {
+  // Where nextItem()/previousItem() land when they leave the current page
+  if (!numberOfItems) return false;
+  const uint16_t pi = getCurrentPageIndex();
+  if (dir > 0) {
+    if (pi + 1 < getTotalPages()) { page = uint16_t(pi + 1); selected = getPageStartIndex(page); return true; }
+    if (!menuItemScrolling) return false;
+    page = 0;
+    selected = 0;
+    return true;
+  }
+  if (pi > 0) { page = uint16_t(pi - 1); selected = getPageEndIndex(page); return true; }
+  if (!menuItemScrolling) return false;
+  selected = uint16_t(numberOfItems - 1);
+  page = uint16_t(selected / getMaxItemsPerPage());
+  return true;
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::prerenderStep() {
+  for (uint8_t i = 0; i < 2; ++i) {
+    PrerenderSlot& slot = prerender[i];
+    uint16_t page, selected;
+    if (!adjacentPageTarget(i == PRERENDER_NEXT ? +1 : -1, page, selected)) continue;
+    if (slot.left.isAllocated() && slot.generation == contentGeneration && slot.page == page && slot.selected == selected) continue;
+
+    if (!slot.left.isAllocated()) {
+      if (!slot.left.allocate() || !slot.right.allocate()) { setPrerenderEnabled(false); return; } // no RAM: render on demand
+      slot.left.setTextWrap(false);
+      slot.right.setTextWrap(false);
+    }
+    const uint32_t t0 = micros();
+    drawPage(page, selected, slot.left, slot.right, 0, false);
+    renderStats.prerender.add(micros() - t0);
+    slot.page       = page;
+    slot.selected   = selected;
+    slot.generation = contentGeneration;
+    return;                            // one page per idle frame
+  }
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::drawBody() {
+  const uint32_t t0 = micros();
+  drawPage(getCurrentPageIndex(), currentItemIndex, bodyLeftCanvas, bodyRightCanvas, bodyYOffsetPx, true);
+  renderStats.drawBody.add(micros() - t0);
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+void PagedMenu<PerPage, Columns>::drawPage(uint16_t pageIndex, uint16_t selectedIndex, GFXcanvas1& left, GFXcanvas1& right,
+                                           int16_t yOffsetPx, bool liveMarquee) {
+  const uint8_t columns = getPageColumns();
+  // Clear body canvases
+  left.fillScreen(MENU_BG_COLOR);
+  if (columns == 2) right.fillScreen(MENU_BG_COLOR);
+
+  // Text settings
+  left.setTextColor(MENU_FG_COLOR);
+  left.setTextSize(1);
+  if (columns == 2) {
+    right.setTextColor(MENU_FG_COLOR);
+    right.setTextSize(1);
+  }
+
+  // Lay out items across columns; apply vertical animation offset
+  const uint16_t s = getPageStartIndex(pageIndex);
+  const uint16_t e = getPageEndIndex(pageIndex);
+  const uint8_t  clipAt  = min<uint8_t>(charsPerCol, MENU_ITEM_MAX_CHARS);
+
+  uint8_t row = 0, col = 0;
+  for (uint16_t i = s; i <= e; ++i) {
+    const uint16_t baseY = row * 8;
+    const int16_t  y     = baseY + yOffsetPx;     // smooth vertical scroll
+    const char* text = itemTextAt(i);
+
+    // Clip (static fallback)
+    char clip[MENU_ITEM_MAX_CHARS + 1];
+    strncpy(clip, text, sizeof(clip) - 1);
+    clip[clipAt] = '\0';
+
+    const uint8_t ip = uint8_t(i - s);   // per-page index
+    const bool isSelected = (i == selectedIndex);
+    const int16_t marqueeX = (liveMarquee && rowMarqueeStates) ? rowMarqueeStates[ip].offsetPx : 0; // pre-rendered pages start reset
+    const bool useMarqueeForThisRow =
+      marqueeEnabled &&
+      ((marqueeMode == MarqueeMode::AllOverflow) || (marqueeMode == MarqueeMode::SelectedOnly && isSelected));
+
+    // Target canvas for the current column
+    GFXcanvas1& target = (col == 0 || columns != 2) ? left : right;
+
+    // Long lines must not wrap into the next row
+    target.setTextWrap(false);
+    target.setFont(NULL);
+
+    // Overflowing marquee rows print the whole text at their offset, others the clipped text
+    bool scrolls = false;
+    if (useMarqueeForThisRow && rowMarqueeStates) {
+      int16_t x1, y1; uint16_t tw, th;
+      target.getTextBounds(text, 0, 0, &x1, &y1, &tw, &th);
+      scrolls = (tw > colWidthPx);
+    }
+
+    if (isSelected && selectedItemInverted) {
+      // Inverted row: MENU_FG_COLOR background, MENU_BG_COLOR text (mono)
+      target.fillRect(0, baseY, colWidthPx, 8, MENU_FG_COLOR);
+      target.setTextColor(MENU_BG_COLOR);
+    } else {
+      // Normal row: MENU_BG_COLOR background (already), MENU_FG_COLOR text
+      target.setTextColor(MENU_FG_COLOR);
+      if (scrolls) target.fillRect(0, baseY, colWidthPx, 8, MENU_BG_COLOR); // clean row area for marquee
+    }
+    target.setCursor(scrolls ? marqueeX : 0, y);
+    target.print(scrolls ? text : clip);
+
+    if (isSelected && selectedItemInverted) {
+      target.drawRect(0, y, colWidthPx, 8, MENU_BG_COLOR);     // MENU_BG_COLOR outline around the row
+    } else if (isSelected) {
+      target.drawRect(0, y, colWidthPx, 8, MENU_FG_COLOR);     // selection frame when not inverted
+    }
+
+    // Next position
+    if (++col >= columns) { col = 0; ++row; }
+  }
+}
+
+template <uint8_t PerPage, uint8_t Columns>
+bool PagedMenu<PerPage, Columns>::stepPageMarquees(uint32_t now) {
+  const uint16_t pi = getCurrentPageIndex();
+  const uint16_t s  = getPageStartIndex(pi);
+  const uint16_t e  = getPageEndIndex(pi);
+  bool moved = false;
+
+  for (uint16_t i = s; i <= e; ++i) {
+    const uint8_t ip = uint8_t(i - s);           // index within current page
+    // Skip if SelectedOnly and not selected
+    if (marqueeMode == MarqueeMode::SelectedOnly && i != currentItemIndex) {
+      // ensure offset reset so text aligns cleanly
+      if (rowMarqueeStates && rowMarqueeStates[ip].offsetPx != 0) {
+        rowMarqueeStates[ip].offsetPx = 0;
+        rowMarqueeStates[ip].dir = -1;
+        rowMarqueeStates[ip].lastMs = now;
+        rowMarqueeStates[ip].holdMs = 0;
+        moved = true;
+      }
+      continue;
+    }
+
+    const char* text = itemTextAt(i);
+    // Measure on the body canvas (both columns share font and width)
+    int16_t x1, y1; uint16_t tw, th;
+    bodyLeftCanvas.getTextBounds(text, 0, 0, &x1, &y1, &tw, &th);
+
+    if (tw > colWidthPx && rowMarqueeStates) {
+      if (rowMarqueeStates[ip].lastMs == 0) rowMarqueeStates[ip].lastMs = now - 16;
+      // Selected row pauses longer at the edges
+      const uint16_t edgePause = (i == currentItemIndex) ? selectedMarqueeEdgePauseMs : marqueeEdgePauseMs;
+      if (stepMarquee(rowMarqueeStates[ip], tw, colWidthPx, now, edgePause)) moved = true;
+    } else if (rowMarqueeStates && (rowMarqueeStates[ip].offsetPx != 0 || rowMarqueeStates[ip].holdMs != 0)) {
+      // fits: reset state if needed
+      rowMarqueeStates[ip].offsetPx = 0;
+      rowMarqueeStates[ip].dir = -1;
+      rowMarqueeStates[ip].holdMs = 0;
+      rowMarqueeStates[ip].lastMs = now;
+      moved = true;
+    }
+  }
+  return moved;
+}
+
+extern template class PagedMenu<0, 0>;  // instantiated in MENU.cpp
+
+/** Menu with rows/columns chosen at run time; canvases and tables on the heap, on demand. */
+class Menu : public PagedMenu<0, 0> {
+public:
+  // Construct a menu for SSD1306; defaults match 128x64 panels on ESP32.
+  Menu(uint16_t screenWidth = 128,
+       uint16_t screenHeight = 64,
+       int8_t  reset        = -1,
+       uint8_t addr         = 0x3C,
+       uint8_t sda          = 21,
+       uint8_t scl          = 22,
+       bool    useStatusBar = false);
+
+  using MenuBase::setMenuColumns;      // 1 or 2
+  using MenuBase::setMenuRows;         // rows per column area
+};
+
+/**
+ * Buffers of a FixedMenu, in a base constructed ahead of MenuBase (base-from-member):
+ * MenuBase's constructor binds them, so they must exist before it runs.
+ */
+template <uint16_t Width, uint16_t Height, uint8_t Rows, uint8_t Cols, bool StatusBar, bool Prerender>
+struct FixedMenuBuffers {
+  static constexpr uint16_t BODY_WIDTH     = Width / 2;
+  static constexpr uint16_t BODY_HEIGHT    = Height - 16;
+  static constexpr uint8_t  ITEMS_PER_PAGE = Rows * Cols;
+  static constexpr uint16_t FRAME_BYTES    = Width * ((Height + 7) / 8);
+  static constexpr uint16_t TITLE_BYTES    = ((Width + 7) / 8) * 16;
+  static constexpr uint16_t BODY_BYTES     = ((BODY_WIDTH + 7) / 8) * BODY_HEIGHT;
+  static constexpr uint16_t STATUS_BYTES   = StatusBar ? ((Width + 7) / 8) * 8 : 1;
+  static constexpr uint16_t PRERENDER_BYTES = Prerender ? BODY_BYTES : 1;
+  static constexpr uint8_t  CACHE_SLOTS    = ITEMS_PER_PAGE * (Prerender ? 3 : 1);
+
+  MenuBase::Storage storage() {
+    MenuBase::Storage s;
+    s.frame       = frameBytes;
+    s.title       = titleBytes;
+    s.bodyLeft    = bodyBytes[0];
+    s.bodyRight   = bodyBytes[1];
+    s.status      = StatusBar ? statusBytes : nullptr;
+    s.snapshot[0] = bodyBytes[2];
+    s.snapshot[1] = bodyBytes[3];
+    for (uint8_t i = 0; i < 4; ++i) s.prerender[i] = Prerender ? prerenderBytes[i] : nullptr;
+    s.marquee      = marquee;
+    s.marqueeCount = ITEMS_PER_PAGE;
+    s.itemCache      = rowCache;
+    s.itemCacheCount = CACHE_SLOTS;
+    s.rows           = Rows;
+    s.columns        = Cols;
+    return s;
+  }
+
+  uint8_t    frameBytes[FRAME_BYTES];          // panel frame buffer
+  uint8_t    titleBytes[TITLE_BYTES];
+  uint8_t    bodyBytes[4][BODY_BYTES];        // body L/R, transition snapshot L/R
+  uint8_t    statusBytes[STATUS_BYTES];
+  uint8_t    prerenderBytes[4][PRERENDER_BYTES];
+  MenuBase::RowMarquee   marquee[ITEMS_PER_PAGE];
+  MenuBase::RowCacheSlot rowCache[CACHE_SLOTS];   // provider rows
+};
+
+/**
+ * Menu with its layout fixed at compile time and every buffer inside the object.
+ *   FixedMenu<128, 64, 3, 2> menu;          // 128x64, 3 rows x 2 columns
+ * - Frame buffer, canvases, transition snapshot, marquee states, provider row cache (and the
+ *   pre-render pages when Prerender is set) are member arrays sized from the template
+ *   arguments: a global FixedMenu lives entirely in .bss and never touches the heap.
+ * - Rows x columns are template arguments of its PagedMenu: page math and the per-row
+ *   marquee/drawing loops are constants, called directly.
+ * - Items follow the same rule as Menu: setMenuItems() copies the table, borrowMenuItems()
+ *   keeps a pointer to a static one (no heap at all).
+ * - Rows/columns are fixed: setMenuRows()/setMenuColumns() do not exist on this type.
+ */
+template <uint16_t Width = 128, uint16_t Height = 64, uint8_t Rows = 6, uint8_t Cols = 1,
+          bool StatusBar = false, bool Prerender = false>
+class FixedMenu : private FixedMenuBuffers<Width, Height, Rows, Cols, StatusBar, Prerender>,
+                  public PagedMenu<Rows * Cols, Cols> {
+  typedef FixedMenuBuffers<Width, Height, Rows, Cols, StatusBar, Prerender> Buffers;
+
+public:
+  using Buffers::BODY_WIDTH;
+  using Buffers::BODY_HEIGHT;
+  using Buffers::ITEMS_PER_PAGE;
+  using Buffers::FRAME_BYTES;
+  using Buffers::TITLE_BYTES;
+  using Buffers::BODY_BYTES;
+  using Buffers::STATUS_BYTES;
+  using Buffers::PRERENDER_BYTES;
+  using Buffers::CACHE_SLOTS;
+
+  static_assert(Cols == 1 || Cols == 2, "FixedMenu: 1 or 2 columns");
+  static_assert(Rows >= 1 && Rows * 8 <= BODY_HEIGHT - (StatusBar ? 8 : 0), "FixedMenu: rows do not fit the body");
+  static_assert(Height <= 64 && Height > 16, "FixedMenu: SSD1306 panels up to 64 px high");
+
+  FixedMenu(int8_t reset = -1, uint8_t addr = 0x3C, uint8_t sda = 21, uint8_t scl = 22)
+    : Buffers(), PagedMenu<Rows * Cols, Cols>(Width, Height, reset, addr, sda, scl, StatusBar, Buffers::storage()) {}
 };
 
 #endif // MENU_H
@@ -0,0 +1,117 @@
+#include "MemoryMonitor.h"
+
+// --- registration ------------------------------------------------------------
+
+bool MemoryMonitor::addSubsystem(const char* name, FootprintFn fn, void* ctx) {
+  if (subsystemCount >= MEMORY_MONITOR_MAX_SUBSYSTEMS) return false;
+  subsystems[subsystemCount++] = { name, fn, ctx, 0 };
+  return true;
+}
+
+bool MemoryMonitor::addSubsystem(const char* name, uint32_t bytes) {
+  if (subsystemCount >= MEMORY_MONITOR_MAX_SUBSYSTEMS) return false;
+  subsystems[subsystemCount++] = { name, nullptr, nullptr, bytes };
+  return true;
+}
+
+bool MemoryMonitor::addTask(const char* name, TaskHandle_t task) {
+  if (taskCount >= MEMORY_MONITOR_MAX_TASKS) return false;
+#if MEMORY_MONITOR_ESP32
+  if (task == nullptr) task = xTaskGetCurrentTaskHandle();
+#endif
+  tasks[taskCount++] = { name, task };
+  return true;
+}
+
+bool MemoryMonitor::addTaskByName(const char* freeRtosName) {
+#if MEMORY_MONITOR_ESP32
+  TaskHandle_t task = xTaskGetHandle(freeRtosName);
+  return task != nullptr && addTask(freeRtosName, task);
+#else
+  (void)freeRtosName;
+  return false;
+#endif
+}
+
+// --- heap --------------------------------------------------------------------
+
+#if MEMORY_MONITOR_ESP32
+  #define MEMORY_MONITOR_CAPS MALLOC_CAP_8BIT
+  uint32_t MemoryMonitor::getHeapSize()         const { return heap_caps_get_total_size(MEMORY_MONITOR_CAPS); }
+  uint32_t MemoryMonitor::getFreeHeap()         const { return heap_caps_get_free_size(MEMORY_MONITOR_CAPS); }
+  uint32_t MemoryMonitor::getMinFreeHeap()      const { return heap_caps_get_minimum_free_size(MEMORY_MONITOR_CAPS); }
+  uint32_t MemoryMonitor::getLargestFreeBlock() const { return heap_caps_get_largest_free_block(MEMORY_MONITOR_CAPS); }
+#else
+  uint32_t MemoryMonitor::getHeapSize()         const { return 0; }
+  uint32_t MemoryMonitor::getFreeHeap()         const { return 0; }
+  uint32_t MemoryMonitor::getMinFreeHeap()      const { return 0; }
+  uint32_t MemoryMonitor::getLargestFreeBlock() const { return 0; }
+#endif
+
+uint8_t MemoryMonitor::getFragmentationPercent() const {
+  const uint32_t freeBytes = getFreeHeap();
+  if (!freeBytes) return 0;
+  return uint8_t(100 - (uint64_t)getLargestFreeBlock() * 100 / freeBytes);
+}
+
+// --- subsystems ----------------------------------------------------------------
+
+const char* MemoryMonitor::getSubsystemName(uint8_t i) const {
+  return (i < subsystemCount) ? subsystems[i].name : "";
+}
+
+uint32_t MemoryMonitor::getSubsystemBytes(uint8_t i) const {
+  if (i >= subsystemCount) return 0;
+  const Subsystem& s = subsystems[i];
+  return s.fn ? s.fn(s.ctx) : s.bytes;
+}
+
+uint32_t MemoryMonitor::getTotalFootprint() const {
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < subsystemCount; ++i) total += getSubsystemBytes(i);
+  return total;
+}
+
+// --- task stacks -----------------------------------------------------------------
+
+const char* MemoryMonitor::getTaskName(uint8_t i) const {
+  return (i < taskCount) ? tasks[i].name : "";
+}
+
+uint32_t MemoryMonitor::getStackFreeMin(uint8_t i) const {
+  if (i >= taskCount || tasks[i].handle == nullptr) return 0;
+#if MEMORY_MONITOR_ESP32
+  // Walks the unused (pattern-filled) end of the stack: cheap enough for a report, not for every pass
+  return uxTaskGetStackHighWaterMark(tasks[i].handle);
+#else
+  return 0;
+#endif
+}
+
+// --- report ------------------------------------------------------------------------
+
+void MemoryMonitor::printReport(Print& out) const {
+  out.print(F("heap: size="));  out.print(getHeapSize());
+  out.print(F(" free="));       out.print(getFreeHeap());
+  out.print(F(" minFree="));    out.print(getMinFreeHeap());
+  out.print(F(" peakUsed="));   out.print(getPeakHeapUsed());
+  out.print(F(" largest="));    out.print(getLargestFreeBlock());
+  out.print(F(" frag="));       out.print(getFragmentationPercent());
+  out.println(F("%"));
+  for (uint8_t i = 0; i < subsystemCount; ++i) {
+    out.print(subsystems[i].name);
+    out.print(F(": "));
+    out.print(getSubsystemBytes(i));
+    out.println(F(" B"));
+  }
+  out.print(F("footprint total: "));
+  out.print(getTotalFootprint());
+  out.println(F(" B"));
+  for (uint8_t i = 0; i < taskCount; ++i) {
+    out.print(F("stack "));
+    out.print(tasks[i].name);
+    out.print(F(": minFree="));
+    out.print(getStackFreeMin(i));
+    out.println(F(" B"));
+  }
+}
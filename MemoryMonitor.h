@@ -0,0 +1,77 @@
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+  #include <esp_heap_caps.h>
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+  #define MEMORY_MONITOR_ESP32 1
+#else
+  #define MEMORY_MONITOR_ESP32 0
+  typedef void* TaskHandle_t;
+#endif
+
+#define MEMORY_MONITOR_MAX_SUBSYSTEMS 8
+#define MEMORY_MONITOR_MAX_TASKS      4
+
+/**
+ * RAM accounting for the whole sketch, read on demand (nothing runs in the background).
+ * - Heap: size, free now, lowest free ever (peak use) and the largest free block;
+ *   free vs largest block shows fragmentation before an allocation starts failing.
+ * - Subsystems: name + byte count (fixed, or a getter for sizes that follow settings,
+ *   e.g. Menu canvases that exist only while their feature is on).
+ * - Tasks: minimum free stack ever seen per FreeRTOS task (ESP-IDF counts it in bytes).
+ *   Scheduler tasks all run on the loop task, so its figure covers every one of them.
+ */
+class MemoryMonitor {
+public:
+  typedef uint32_t (*FootprintFn)(void* ctx);
+
+  // false when the table is full
+  bool addSubsystem(const char* name, FootprintFn fn, void* ctx);
+  bool addSubsystem(const char* name, uint32_t bytes);
+  bool addTask(const char* name, TaskHandle_t task = nullptr); // nullptr = the calling task (register loop from setup())
+  bool addTaskByName(const char* freeRtosName);                // e.g. "esp_timer"; false if no such task
+
+  // --- heap (8-bit capable internal RAM) ---
+  uint32_t getHeapSize()         const;
+  uint32_t getFreeHeap()         const;
+  uint32_t getMinFreeHeap()      const;   // low-water mark since boot
+  uint32_t getPeakHeapUsed()     const { return getHeapSize() - getMinFreeHeap(); }
+  uint32_t getLargestFreeBlock() const;
+  uint8_t  getFragmentationPercent() const; // 0 = all free memory in one block
+
+  // --- subsystems ---
+  uint8_t     getSubsystemCount() const { return subsystemCount; }
+  const char* getSubsystemName(uint8_t i) const;
+  uint32_t    getSubsystemBytes(uint8_t i) const;
+  uint32_t    getTotalFootprint() const;
+
+  // --- task stacks ---
+  uint8_t     getTaskCount() const { return taskCount; }
+  const char* getTaskName(uint8_t i) const;
+  uint32_t    getStackFreeMin(uint8_t i) const; // bytes never touched; 0 for an unknown task
+
+  void printReport(Print& out) const;
+
+private:
+  struct Subsystem {
+    const char* name;
+    FootprintFn fn;
+    void*       ctx;
+    uint32_t    bytes;                  // used when fn is null
+  };
+  struct Task {
+    const char*  name;
+    TaskHandle_t handle;
+  };
+
+  Subsystem subsystems[MEMORY_MONITOR_MAX_SUBSYSTEMS];
+  Task      tasks[MEMORY_MONITOR_MAX_TASKS];
+  uint8_t   subsystemCount = 0;
+  uint8_t   taskCount      = 0;
+};
+
+#endif // MEMORY_MONITOR_H
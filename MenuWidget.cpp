@@ -0,0 +1,129 @@
+#include "MenuWidget.h"
+
+// --- base --------------------------------------------------------------------
+
+MenuWidget::MenuWidget(int16_t px, int16_t py, uint8_t chars)
+  : x(px),
+    y(py),
+    widthChars(chars > MENU_WIDGET_MAX_CHARS ? MENU_WIDGET_MAX_CHARS : (chars ? chars : 1)) {
+  text[0] = '\0';
+}
+
+bool MenuWidget::update() {
+  char next[MENU_WIDGET_MAX_CHARS + 1];
+  format(next, widthChars + 1);          // clipped to the region width
+  next[widthChars] = '\0';
+  if (valid && strcmp(next, text) == 0) return false;
+  memcpy(text, next, sizeof(text));
+  valid = true;
+  return true;
+}
+
+void MenuWidget::draw(Adafruit_GFX& gfx, uint16_t fg, uint16_t bg) const {
+  gfx.fillRect(x, y, getWidth(), getHeight(), bg);
+  gfx.setTextWrap(false);
+  gfx.setFont(NULL);
+  gfx.setTextSize(1);
+  gfx.setTextColor(fg);
+  gfx.setCursor(x, y);
+  gfx.print(text);
+}
+
+void MenuWidget::invalidate() { valid = false; }
+
+const char* MenuWidget::separator(const char* label) { return (label && *label) ? " " : ""; }
+
+// --- countdown -----------------------------------------------------------------
+
+CountdownWidget::CountdownWidget(int16_t px, int16_t py, uint8_t chars, const char* lbl, Getter fn, void* c, bool secs)
+  : MenuWidget(px, py, chars), label(lbl), getter(fn), ctx(c), showSeconds(secs) {}
+
+CountdownWidget::CountdownWidget(int16_t px, int16_t py, uint8_t chars, const char* lbl, const uint32_t* seconds, bool secs)
+  : MenuWidget(px, py, chars), label(lbl), getter(&CountdownWidget::readPointer), ctx((void*)seconds), showSeconds(secs) {}
+
+void CountdownWidget::format(char* buf, size_t cap) {
+  const uint32_t s = getter(ctx);
+  const uint32_t h = s / 3600;
+  const uint32_t m = (s / 60) % 60;
+  if (showSeconds) {
+    if (h) snprintf(buf, cap, "%s%s%luh%02lum%02lus", label, separator(label), (unsigned long)h, (unsigned long)m, (unsigned long)(s % 60));
+    else   snprintf(buf, cap, "%s%s%lum%02lus", label, separator(label), (unsigned long)m, (unsigned long)(s % 60));
+  } else {
+    // Minute resolution: the text (and so the redraw) changes once per minute
+    if (h) snprintf(buf, cap, "%s%s%luh%02lum", label, separator(label), (unsigned long)h, (unsigned long)m);
+    else   snprintf(buf, cap, "%s%s%lum", label, separator(label), (unsigned long)m);
+  }
+}
+
+// --- indicator -----------------------------------------------------------------
+
+IndicatorWidget::IndicatorWidget(int16_t px, int16_t py, uint8_t chars, const char* lbl, Getter fn, void* c,
+                                 const char* on, const char* off)
+  : MenuWidget(px, py, chars), label(lbl), getter(fn), ctx(c), onText(on), offText(off) {}
+
+IndicatorWidget::IndicatorWidget(int16_t px, int16_t py, uint8_t chars, const char* lbl, const bool* value,
+                                 const char* on, const char* off)
+  : MenuWidget(px, py, chars), label(lbl), getter(&IndicatorWidget::readPointer), ctx((void*)value), onText(on), offText(off) {}
+
+void IndicatorWidget::format(char* buf, size_t cap) {
+  snprintf(buf, cap, "%s%s%s", label, separator(label), getter(ctx) ? onText : offText);
+}
+
+// --- number --------------------------------------------------------------------
+
+NumberWidget::NumberWidget(int16_t px, int16_t py, uint8_t chars, const char* lbl, Getter fn, void* c, const char* sfx)
+  : MenuWidget(px, py, chars), label(lbl), getter(fn), ctx(c), suffix(sfx) {}
+
+void NumberWidget::format(char* buf, size_t cap) {
+  snprintf(buf, cap, "%s%s%ld%s", label, separator(label), (long)getter(ctx), suffix);
+}
+
+// --- sparkline -----------------------------------------------------------------
+
+SparklineWidget::SparklineWidget(int16_t px, int16_t py, uint8_t w, uint8_t h, const TrendStore& s,
+                                 TrendStore::Tier t, int16_t low, int16_t high)
+  : MenuWidget(px, py, uint8_t((w + 5) / 6)), store(s), tier(t), widthPx(w ? w : 1), heightPx(h ? h : 1), lo(low), hi(high) {}
+
+bool SparklineWidget::update() {
+  const uint32_t rev = store.getRevision(tier);
+  if (drawn && rev == drawnRevision) return false;
+  drawnRevision = rev;
+  drawn = true;
+  return true;
+}
+
+void SparklineWidget::invalidate() { drawn = false; }
+
+int16_t SparklineWidget::toY(int16_t v, int16_t low, int16_t high) const {
+  const int32_t span = (int32_t)high - low;
+  int32_t offset = span > 0 ? ((int32_t)v - low) * (heightPx - 1) / span : 0;
+  offset = constrain(offset, (int32_t)0, (int32_t)(heightPx - 1));
+  return int16_t(y + heightPx - 1 - offset);
+}
+
+void SparklineWidget::draw(Adafruit_GFX& gfx, uint16_t fg, uint16_t bg) const {
+  gfx.fillRect(x, y, widthPx, heightPx, bg);
+  const uint8_t columns = min<uint8_t>(widthPx, store.getCount(tier));
+  TrendStore::Bucket b;
+
+  int16_t low = lo, high = hi;
+  if (low >= high) {
+    // Fit to the buckets on screen; runs only when a bucket was added
+    bool any = false;
+    for (uint8_t age = 0; age < columns; ++age) {
+      if (!store.getBucket(tier, age, b) || !b.count) continue;
+      if (!any || b.min < low)  low  = b.min;
+      if (!any || b.max > high) high = b.max;
+      any = true;
+    }
+    if (!any) return;
+  }
+
+  for (uint8_t age = 0; age < columns; ++age) {
+    if (!store.getBucket(tier, age, b) || !b.count) continue; // gap
+    const int16_t px = int16_t(x + widthPx - 1 - age);
+    const int16_t top    = toY(b.max, low, high);
+    const int16_t bottom = toY(b.min, low, high);
+    gfx.drawFastVLine(px, top, bottom - top + 1, fg);
+  }
+}
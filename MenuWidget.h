@@ -0,0 +1,146 @@
+#ifndef MENU_WIDGET_H
+#define MENU_WIDGET_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include "TrendStore.h"
+
+#define MENU_WIDGET_MAX_CHARS 21 // one full 128 px text row
+
+/**
+ * Data-bound live field for Menu status pages.
+ * - Each widget owns a fixed one-line screen region (x, y, widthChars * 6 x 8 px).
+ * - Bound to a getter (fn + context) or straight to a value pointer.
+ * - Menu formats every widget each refresh, but only redraws and flushes the
+ *   region when the formatted text actually changed.
+ * - Graphic widgets override update()/draw() and the region size instead.
+ */
+class MenuWidget {
+public:
+  MenuWidget(int16_t x, int16_t y, uint8_t widthChars);
+  virtual ~MenuWidget() {}
+
+  virtual bool update();               // re-format; true if the text changed since last draw
+  virtual void draw(Adafruit_GFX& gfx, uint16_t fg, uint16_t bg) const;
+  virtual void invalidate();           // force a redraw on the next update()
+
+  int16_t  getX()      const { return x; }
+  int16_t  getY()      const { return y; }
+  virtual uint16_t getWidth()  const { return uint16_t(widthChars) * 6; }
+  virtual uint16_t getHeight() const { return 8; }
+
+protected:
+  virtual void format(char* buf, size_t cap) = 0;
+  static const char* separator(const char* label); // " " after a label, nothing without one
+
+  int16_t x;
+  int16_t y;
+  uint8_t widthChars;
+
+private:
+  char text[MENU_WIDGET_MAX_CHARS + 1];
+  bool valid = false;
+};
+
+/** Remaining time as "label 1h05m" / "label 12m" (or with seconds), from a seconds getter. */
+class CountdownWidget : public MenuWidget {
+public:
+  typedef uint32_t (*Getter)(void* ctx);
+
+  CountdownWidget(int16_t x, int16_t y, uint8_t widthChars, const char* label, Getter getter, void* ctx, bool showSeconds = false);
+  CountdownWidget(int16_t x, int16_t y, uint8_t widthChars, const char* label, const uint32_t* seconds, bool showSeconds = false);
+
+protected:
+  void format(char* buf, size_t cap) override;
+
+private:
+  static uint32_t readPointer(void* p) { return *static_cast<const uint32_t*>(p); }
+
+  const char* label;
+  Getter      getter;
+  void*       ctx;
+  bool        showSeconds;
+};
+
+/** On/off indicator ("label ON" / "label OFF" or custom words). */
+class IndicatorWidget : public MenuWidget {
+public:
+  typedef bool (*Getter)(void* ctx);
+
+  IndicatorWidget(int16_t x, int16_t y, uint8_t widthChars, const char* label, Getter getter, void* ctx,
+                  const char* onText = "ON", const char* offText = "OFF");
+  IndicatorWidget(int16_t x, int16_t y, uint8_t widthChars, const char* label, const bool* value,
+                  const char* onText = "ON", const char* offText = "OFF");
+
+protected:
+  void format(char* buf, size_t cap) override;
+
+private:
+  static bool readPointer(void* p) { return *static_cast<const bool*>(p); }
+
+  const char* label;
+  Getter      getter;
+  void*       ctx;
+  const char* onText;
+  const char* offText;
+};
+
+/** Integer field ("label 42 suffix"), from a getter or any integral variable. */
+class NumberWidget : public MenuWidget {
+public:
+  typedef int32_t (*Getter)(void* ctx);
+
+  NumberWidget(int16_t x, int16_t y, uint8_t widthChars, const char* label, Getter getter, void* ctx, const char* suffix = "");
+
+  template <typename T>
+  NumberWidget(int16_t x, int16_t y, uint8_t widthChars, const char* label, const T* value, const char* suffix = "")
+    : NumberWidget(x, y, widthChars, label, &NumberWidget::readPointer<T>, (void*)value, suffix) {}
+
+protected:
+  void format(char* buf, size_t cap) override;
+
+private:
+  template <typename T>
+  static int32_t readPointer(void* p) { return (int32_t)*static_cast<const T*>(p); }
+
+  const char* label;
+  Getter      getter;
+  void*       ctx;
+  const char* suffix;
+};
+
+/**
+ * Sparkline of one TrendStore tier: one column per bucket, newest on the right, drawn as
+ * a min..max bar (a dot for raw samples); empty buckets leave a gap.
+ * - update() only compares the tier's revision: O(1) per frame, and the region is
+ *   redrawn once per new bucket (once a minute for the minute tier).
+ * - Vertical range fixed by the caller (lo < hi, store units) or fitted to what is shown.
+ */
+class SparklineWidget : public MenuWidget {
+public:
+  SparklineWidget(int16_t x, int16_t y, uint8_t widthPx, uint8_t heightPx, const TrendStore& store,
+                  TrendStore::Tier tier, int16_t lo = 0, int16_t hi = 0);
+
+  bool update() override;
+  void draw(Adafruit_GFX& gfx, uint16_t fg, uint16_t bg) const override;
+  void invalidate() override;
+  uint16_t getWidth()  const override { return widthPx; }
+  uint16_t getHeight() const override { return heightPx; }
+
+protected:
+  void format(char* buf, size_t cap) override { if (cap) buf[0] = '\0'; } // graphic only
+
+private:
+  int16_t toY(int16_t v, int16_t lo, int16_t hi) const;
+
+  const TrendStore& store;
+  TrendStore::Tier  tier;
+  uint8_t  widthPx;
+  uint8_t  heightPx;
+  int16_t  lo;
+  int16_t  hi;
+  uint32_t drawnRevision = 0;
+  bool     drawn         = false;
+};
+
+#endif // MENU_WIDGET_H
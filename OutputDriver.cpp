@@ -0,0 +1,209 @@
+#include "OutputDriver.h"
+#include <SPI.h>
+#include <Wire.h>
+
+// MCP23017 register map (IOCON.BANK = 0, sequential addressing)
+#define MCP23017_IODIRA 0x00
+#define MCP23017_OLATA  0x14
+
+// How one commit reaches several expanders in a single START..STOP
+#if defined(ARDUINO_ARCH_ESP32) && ESP_ARDUINO_VERSION_MAJOR < 3 && __has_include(<driver/i2c.h>)
+  #include <driver/i2c.h>
+  #define MCP23017_IDF_LINK     1 // 2.x core: Wire runs on the legacy driver, one command link with repeated STARTs
+#else
+  #define MCP23017_IDF_LINK     0
+#endif
+#if defined(ARDUINO_ARCH_ESP32)
+  #define MCP23017_WIRE_RESTART 0 // ESP32 Wire holds a non-STOP write for the next requestFrom(): no write-restart-write
+#else
+  #define MCP23017_WIRE_RESTART 1 // endTransmission(false) sends the write and keeps the bus
+#endif
+#define MCP23017_MAX_CHIPS      8 // A2..A0
+
+// --- direct GPIO -------------------------------------------------------------
+
+GpioOutputDriver& GpioOutputDriver::instance() {
+  static GpioOutputDriver driver;
+  return driver;
+}
+
+void GpioOutputDriver::configure(uint8_t channel, uint8_t level) {
+  if (channel < 64 && (pwmPins & (1ULL << channel))) return; // on LEDC already: pinMode() would detach it
+  digitalWrite(channel, level);        // level latched before the output is enabled: no glitch
+  pinMode(channel, OUTPUT);
+}
+
+void GpioOutputDriver::write(uint8_t channel, uint8_t level) {
+  if (channel < 64 && (pwmPins & (1ULL << channel))) {
+    writeDuty(channel, level ? 255 : 0);  // pin belongs to LEDC now; GPIO out bit has no effect
+    return;
+  }
+  digitalWrite(channel, level);
+  transactions++;
+}
+
+void GpioOutputDriver::writeDuty(uint8_t channel, uint8_t duty) {
+  if (!attachPwm(channel)) { write(channel, duty ? HIGH : LOW); return; }
+  // 255 at 8 bits is treated as fully on by the core
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+  ledcWrite(channel, duty);
+#else
+  ledcWrite(ledcChannelOf[channel], duty);
+#endif
+  transactions++;
+}
+
+bool GpioOutputDriver::attachPwm(uint8_t pin) {
+  if (pin >= 64) return false;
+  if (pwmPins & (1ULL << pin)) return true;
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+  if (!ledcAttach(pin, OUTPUT_DRIVER_PWM_HZ, OUTPUT_DRIVER_PWM_BITS)) return false;
+#else
+  if (!ledcMapReady) { memset(ledcChannelOf, -1, sizeof(ledcChannelOf)); ledcMapReady = true; }
+  if (ledcChannelsUsed >= 16) return false;  // all LEDC channels taken
+  const uint8_t ch = ledcChannelsUsed++;
+  ledcSetup(ch, OUTPUT_DRIVER_PWM_HZ, OUTPUT_DRIVER_PWM_BITS);
+  ledcAttachPin(pin, ch);
+  ledcChannelOf[pin] = int8_t(ch);
+#endif
+  pwmPins |= (1ULL << pin);
+  return true;
+}
+
+// --- register mock (host builds) ----------------------------------------------
+
+#if !OUTPUT_DRIVER_GPIO_REGS
+uint32_t GpioOutputRegs::latch[2] = {0, 0};
+void (*GpioOutputRegs::onStore)(uint8_t, uint32_t, uint32_t) = nullptr;
+#endif
+
+// --- shadow image ------------------------------------------------------------
+
+ShadowOutputDriver::ShadowOutputDriver(uint8_t byteCount)
+  : imageBytes(byteCount > OUTPUT_DRIVER_MAX_BYTES ? OUTPUT_DRIVER_MAX_BYTES : byteCount) {}
+
+void ShadowOutputDriver::configure(uint8_t channel, uint8_t level) {
+  write(channel, level);
+}
+
+void ShadowOutputDriver::write(uint8_t channel, uint8_t level) {
+  const uint8_t byteIdx = channel >> 3;
+  if (byteIdx >= imageBytes) return;
+  const uint8_t mask = uint8_t(1u << (channel & 7));
+  const uint8_t next = level ? (image[byteIdx] | mask) : (image[byteIdx] & ~mask);
+  if (next == image[byteIdx]) return;
+  image[byteIdx] = next;
+  dirtyBytes |= (1UL << byteIdx);
+}
+
+void ShadowOutputDriver::commit() {
+  if (!dirtyBytes) return;
+  if (flush()) dirtyBytes = 0;
+  else         failures++;      // still dirty: the next commit retries
+}
+
+// --- 74HC595 chain -------------------------------------------------------------
+
+ShiftRegisterDriver::ShiftRegisterDriver(uint8_t data, uint8_t clock, uint8_t latch, uint8_t chipCount, uint32_t hz)
+  : ShadowOutputDriver(chipCount),
+    dataPin(data),
+    clockPin(clock),
+    latchPin(latch),
+    spiHz(hz) {}
+
+void ShiftRegisterDriver::begin() {
+  pinMode(latchPin, OUTPUT);
+  digitalWrite(latchPin, HIGH);
+  SPI.begin(clockPin, -1, dataPin, -1);
+  dirtyBytes = 0xFFFFFFFFUL; // force the whole chain to a known state
+  commit();
+}
+
+bool ShiftRegisterDriver::flush() {
+  // The first byte shifted ends up in the last chip, so send the image back to front
+  uint8_t out[OUTPUT_DRIVER_MAX_BYTES];
+  for (uint8_t i = 0; i < imageBytes; ++i) out[i] = image[imageBytes - 1 - i];
+
+  SPI.beginTransaction(SPISettings(spiHz, MSBFIRST, SPI_MODE0));
+  digitalWrite(latchPin, LOW);
+  SPI.writeBytes(out, imageBytes);
+  digitalWrite(latchPin, HIGH); // rising edge copies the chain to the outputs at once
+  SPI.endTransaction();
+
+  transactions++;
+  bytesWritten += imageBytes;
+  return true;                  // SPI has no acknowledge to check
+}
+
+// --- MCP23017 expanders --------------------------------------------------------
+
+Mcp23017Driver::Mcp23017Driver(uint8_t chipCount, uint8_t addr)
+  : ShadowOutputDriver(uint8_t(chipCount * 2)),
+    baseAddr(addr) {}
+
+void Mcp23017Driver::begin() {
+  for (uint8_t chip = 0; chip < imageBytes / 2; ++chip) {
+    Wire.beginTransmission(uint8_t(baseAddr + chip));
+    Wire.write(MCP23017_IODIRA);
+    Wire.write(0x00); // IODIRA: all outputs
+    Wire.write(0x00); // IODIRB: all outputs
+    Wire.endTransmission();
+    transactions++;
+    bytesWritten += 3;
+  }
+  dirtyBytes = 0xFFFFFFFFUL;
+  commit();
+}
+
+bool Mcp23017Driver::flush() {
+  // Every changed chip in one transaction: register pointer + OLATA + OLATB per chip,
+  // a repeated START in between and a single STOP after the last one
+  uint8_t chips[MCP23017_MAX_CHIPS];
+  uint8_t count = 0;
+  for (uint8_t chip = 0; chip < imageBytes / 2 && chip < MCP23017_MAX_CHIPS; ++chip) {
+    if (dirtyBytes & (3UL << (chip * 2))) chips[count++] = chip;
+  }
+  if (!count) return true;
+
+#if MCP23017_IDF_LINK
+  uint8_t frames[MCP23017_MAX_CHIPS][4];
+  uint8_t link[I2C_LINK_RECOMMENDED_SIZE(MCP23017_MAX_CHIPS)];
+  i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link, sizeof(link));
+  if (cmd != nullptr) {
+    for (uint8_t i = 0; i < count; ++i) {
+      const uint8_t chip = chips[i];
+      frames[i][0] = uint8_t(((baseAddr + chip) << 1) | I2C_MASTER_WRITE);
+      frames[i][1] = MCP23017_OLATA;
+      frames[i][2] = image[chip * 2];
+      frames[i][3] = image[chip * 2 + 1];
+      i2c_master_start(cmd);
+      i2c_master_write(cmd, frames[i], 4, true);
+    }
+    i2c_master_stop(cmd);
+    const esp_err_t err = i2c_master_cmd_begin(I2C_NUM_0, cmd, pdMS_TO_TICKS(10)); // Wire's port
+    i2c_cmd_link_delete_static(cmd);
+    transactions++;
+    bytesWritten += 3u * count;
+    return err == ESP_OK;       // NACK, timeout or a busy bus
+  }
+#endif
+  bool ok = true;
+  for (uint8_t i = 0; i < count; ++i) {
+    const uint8_t chip = chips[i];
+    Wire.beginTransmission(uint8_t(baseAddr + chip));
+    Wire.write(MCP23017_OLATA);
+    Wire.write(image[chip * 2]);
+    Wire.write(image[chip * 2 + 1]);
+#if MCP23017_WIRE_RESTART
+    ok &= (Wire.endTransmission(i + 1 == count) == 0);
+#else
+    ok &= (Wire.endTransmission() == 0);
+    transactions++;                       // one STOP per chip on this core
+#endif
+    bytesWritten += 3;
+  }
+#if MCP23017_WIRE_RESTART
+  transactions++;
+#endif
+  return ok;
+}
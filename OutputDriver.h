@@ -0,0 +1,244 @@
+#ifndef OUTPUT_DRIVER_H
+#define OUTPUT_DRIVER_H
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+  #include <soc/gpio_struct.h>
+  #include <soc/soc_caps.h>
+  #define OUTPUT_DRIVER_GPIO_REGS 1 // GPIO.out_w1ts / out_w1tc written directly
+#else
+  #define OUTPUT_DRIVER_GPIO_REGS 0 // GpioOutputRegs::latch stands in for the registers
+#endif
+
+#define OUTPUT_DRIVER_MAX_BYTES 24 // Shadow image size: 192 channels = 64 valves x (open, close, LED)
+#define OUTPUT_DRIVER_PWM_HZ    20000 // LEDC frequency for duty-driven outputs (above audible coil whine)
+#define OUTPUT_DRIVER_PWM_BITS  8
+
+/**
+ * Output-driver abstraction used by Valve for its drive and LED outputs.
+ * - Channels are driver-local numbers (GPIO number, shift-register bit, expander pin).
+ * - write() only stages a level; commit() pushes everything staged since the
+ *   last commit in a single bus transaction (no-op for direct GPIO).
+ * - Transaction/byte counters make bus cost visible on the Serial side; a commit the
+ *   bus rejected is counted as a failure and retried by the next commit().
+ * - writeDuty() drives a channel with PWM where the driver supports it; elsewhere
+ *   any non-zero duty is plain HIGH.
+ */
+class OutputDriver {
+public:
+  virtual ~OutputDriver() {}
+
+  virtual void configure(uint8_t channel, uint8_t level = LOW) = 0; // make channel an output at level
+  virtual void write(uint8_t channel, uint8_t level) = 0; // stage HIGH/LOW
+  virtual void commit() {}                                // flush staged levels
+  virtual bool isDirectGpio() const { return false; }     // channel == GPIO and writes are immediate
+  virtual bool supportsPwm()  const { return false; }
+  virtual void writeDuty(uint8_t channel, uint8_t duty) { write(channel, duty ? HIGH : LOW); } // 0..255
+  // Two channels changed together (drive pin + LED); a single store where the driver can
+  virtual void writePair(uint8_t channelA, uint8_t levelA, uint8_t channelB, uint8_t levelB) {
+    write(channelA, levelA);
+    write(channelB, levelB);
+  }
+
+  uint32_t getTransactionCount() const { return transactions; }
+  uint32_t getBytesWritten()     const { return bytesWritten; }
+  uint32_t getFailureCount()     const { return failures; }
+  void     resetCounters()             { transactions = 0; bytesWritten = 0; failures = 0; }
+
+protected:
+  uint32_t transactions = 0;
+  uint32_t bytesWritten = 0;
+  uint32_t failures     = 0;
+};
+
+/** Direct ESP32 GPIO: channel == pin number, writes take effect immediately; PWM via LEDC. */
+class GpioOutputDriver : public OutputDriver {
+public:
+  static GpioOutputDriver& instance(); // shared driver for Valve's pin-based constructor
+
+  void configure(uint8_t channel, uint8_t level = LOW) override;
+  void write(uint8_t channel, uint8_t level) override;
+  bool isDirectGpio() const override { return true; }
+  bool supportsPwm()  const override { return true; }
+  void writeDuty(uint8_t channel, uint8_t duty) override;
+
+private:
+  bool attachPwm(uint8_t pin);         // lazily hand the pin to an LEDC channel
+  uint64_t pwmPins = 0;                // bit n set => GPIO n is routed to LEDC
+#if ESP_ARDUINO_VERSION_MAJOR < 3
+  int8_t  ledcChannelOf[64];           // 2.x core: pin -> LEDC channel
+  uint8_t ledcChannelsUsed = 0;
+  bool    ledcMapReady = false;
+#endif
+};
+
+/**
+ * GPIO output set/clear registers (write-1-to-set / write-1-to-clear), bank = pin / 32.
+ * One store changes any number of pins in a bank and leaves the rest alone, so it needs
+ * no read-modify-write and is safe against timer callbacks touching other pins.
+ * Host builds: latch[] mirrors the output levels and onStore sees every store in order.
+ * Always inlined: PulseTimer's IRAM callback stores through clear().
+ */
+struct GpioOutputRegs {
+  static inline __attribute__((always_inline)) void set(uint8_t bank, uint32_t mask) {
+#if OUTPUT_DRIVER_GPIO_REGS
+  #if SOC_GPIO_PIN_COUNT > 32
+    if (bank) { GPIO.out1_w1ts.val = mask; return; }
+  #endif
+    GPIO.out_w1ts = mask;
+#else
+    latch[bank & 1] |= mask;
+    if (onStore) onStore(bank, mask, 0);
+#endif
+  }
+
+  static inline __attribute__((always_inline)) void clear(uint8_t bank, uint32_t mask) {
+#if OUTPUT_DRIVER_GPIO_REGS
+  #if SOC_GPIO_PIN_COUNT > 32
+    if (bank) { GPIO.out1_w1tc.val = mask; return; }
+  #endif
+    GPIO.out_w1tc = mask;
+#else
+    latch[bank & 1] &= ~mask;
+    if (onStore) onStore(bank, 0, mask);
+#endif
+  }
+
+#if !OUTPUT_DRIVER_GPIO_REGS
+  static uint32_t latch[2];
+  static void (*onStore)(uint8_t bank, uint32_t setMask, uint32_t clearMask);
+#endif
+};
+
+/**
+ * Direct GPIO with the pins fixed at compile time (one valve's open, close and LED pins).
+ * - Pin masks are constants, so write() folds to a compare and one register store:
+ *   no pin lookup or driver layers as in digitalWrite().
+ * - writePair() merges both channels into one set and/or one clear store per bank;
+ *   opening (drive + LED on) is a single store.
+ * - Pins handed to LEDC by writeDuty() go through GpioOutputDriver from then on.
+ * - 0xFF (VALVE_NO_PIN) leaves a pin unused.
+ */
+template<uint8_t OpenPin, uint8_t ClosePin, uint8_t LedPin = 0xFF>
+class FixedGpioOutputDriver final : public OutputDriver {
+  static_assert((OpenPin < 64 || OpenPin == 0xFF) && (ClosePin < 64 || ClosePin == 0xFF) && (LedPin < 64 || LedPin == 0xFF),
+                "FixedGpioOutputDriver pins must be GPIO 0..63 or 0xFF");
+
+public:
+  static FixedGpioOutputDriver& instance() { // one per pin set, shared like GpioOutputDriver::instance()
+    static FixedGpioOutputDriver driver;
+    return driver;
+  }
+
+  void configure(uint8_t channel, uint8_t level = LOW) override {
+    if (!owns(channel) || onLedc(channel)) return;
+    write(channel, level);             // level latched before the output is enabled: no glitch
+    pinMode(channel, OUTPUT);
+  }
+
+  void write(uint8_t channel, uint8_t level) override {
+    if (onLedc(channel)) { GpioOutputDriver::instance().write(channel, level); return; }
+    for (uint8_t bank = 0; bank < 2; ++bank) {
+      const uint32_t mask = maskIn(bank, channel);
+      if (!mask) continue;
+      if (level) GpioOutputRegs::set(bank, mask);
+      else       GpioOutputRegs::clear(bank, mask);
+      transactions++;
+    }
+  }
+
+  void writePair(uint8_t channelA, uint8_t levelA, uint8_t channelB, uint8_t levelB) override {
+    if (onLedc(channelA) || onLedc(channelB)) {
+      write(channelA, levelA);
+      write(channelB, levelB);
+      return;
+    }
+    for (uint8_t bank = 0; bank < 2; ++bank) {
+      const uint32_t a = maskIn(bank, channelA);
+      const uint32_t b = maskIn(bank, channelB);
+      const uint32_t setMask   = (levelA ? a : 0) | (levelB ? b : 0);
+      const uint32_t clearMask = (levelA ? 0 : a) | (levelB ? 0 : b);
+      if (setMask)   { GpioOutputRegs::set(bank, setMask);     transactions++; }
+      if (clearMask) { GpioOutputRegs::clear(bank, clearMask); transactions++; }
+    }
+  }
+
+  void writeDuty(uint8_t channel, uint8_t duty) override {
+    if (!owns(channel)) return;
+    ledcPins |= (1ULL << channel);
+    GpioOutputDriver::instance().writeDuty(channel, duty);
+  }
+
+  bool isDirectGpio() const override { return true; }
+  bool supportsPwm()  const override { return true; }
+
+private:
+  static constexpr uint32_t pinMask(uint8_t bank, uint8_t pin) {
+    return (pin != 0xFF && (pin >> 5) == bank) ? (1UL << (pin & 31)) : 0;
+  }
+  static constexpr uint32_t maskIn(uint8_t bank, uint8_t channel) {
+    return (channel == OpenPin  ? pinMask(bank, OpenPin)  : 0) |
+           (channel == ClosePin ? pinMask(bank, ClosePin) : 0) |
+           (channel == LedPin   ? pinMask(bank, LedPin)   : 0);
+  }
+  static constexpr bool owns(uint8_t channel) { return (maskIn(0, channel) | maskIn(1, channel)) != 0; }
+  bool onLedc(uint8_t channel) const { return channel < 64 && ((ledcPins >> channel) & 1); }
+
+  uint64_t ledcPins = 0;               // bit n set => GPIO n was given to LEDC by writeDuty()
+};
+
+/**
+ * Common shadow-register logic for bus-attached outputs.
+ * Staged writes only touch the RAM image; commit() calls flush() once if anything changed.
+ * A failed flush leaves the bytes dirty, so the next commit() sends them again.
+ */
+class ShadowOutputDriver : public OutputDriver {
+public:
+  void configure(uint8_t channel, uint8_t level = LOW) override;
+  void write(uint8_t channel, uint8_t level) override;
+  void commit() override;
+
+protected:
+  explicit ShadowOutputDriver(uint8_t byteCount);
+  virtual bool flush() = 0;       // push image[0..imageBytes) to the hardware; false = bus error
+
+  uint8_t  image[OUTPUT_DRIVER_MAX_BYTES] = {0};
+  uint8_t  imageBytes;
+  uint32_t dirtyBytes = 0;         // bit n set => image[n] changed since last flush
+};
+
+/** Chain of 74HC595 shift registers clocked by the SPI peripheral (one burst per commit). */
+class ShiftRegisterDriver : public ShadowOutputDriver {
+public:
+  ShiftRegisterDriver(uint8_t dataPin, uint8_t clockPin, uint8_t latchPin, uint8_t chipCount, uint32_t spiHz = 8000000);
+  void begin();                    // SPI.begin(...) and clear the chain
+
+protected:
+  bool flush() override;
+
+private:
+  uint8_t  dataPin;
+  uint8_t  clockPin;
+  uint8_t  latchPin;
+  uint32_t spiHz;
+};
+
+/**
+ * MCP23017 I2C expanders at consecutive addresses (up to 8). Each commit writes OLATA+OLATB
+ * of every changed chip in one transaction, chips joined by repeated STARTs. ESP32 3.x
+ * cores have no write-restart-write through Wire and fall back to one STOP per chip.
+ */
+class Mcp23017Driver : public ShadowOutputDriver {
+public:
+  Mcp23017Driver(uint8_t chipCount, uint8_t baseAddr = 0x20);
+  void begin();                    // all pins output, latches cleared (Wire must be started)
+
+protected:
+  bool flush() override;
+
+private:
+  uint8_t baseAddr;
+};
+
+#endif // OUTPUT_DRIVER_H
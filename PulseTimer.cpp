@@ -0,0 +1,106 @@
+#include "PulseTimer.h"
+
+#include "OutputDriver.h"              // GpioOutputRegs: the pin-clear store (or its host mock)
+
+// Called from onExpire(): must stay in IRAM with it
+static inline int64_t IRAM_ATTR pulseNowUs() {
+#if PULSE_TIMER_HAS_ESP_TIMER
+  return esp_timer_get_time();
+#else
+  return (int64_t)micros();
+#endif
+}
+
+// --- ctor/dtor ---------------------------------------------------------------
+
+PulseTimer::PulseTimer() {}
+
+PulseTimer::~PulseTimer() {
+#if PULSE_TIMER_HAS_ESP_TIMER
+  if (handle) {
+    esp_timer_stop(handle);
+    esp_timer_delete(handle);
+  }
+#endif
+}
+
+bool PulseTimer::begin() {
+#if PULSE_TIMER_HAS_ESP_TIMER
+  if (handle) return true;
+  esp_timer_create_args_t args = {};
+  args.callback = &PulseTimer::onExpire;
+  args.arg      = this;
+  args.name     = "valve_pulse";
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+  args.dispatch_method = ESP_TIMER_ISR;   // microsecond-level latency
+#else
+  args.dispatch_method = ESP_TIMER_TASK;  // high-priority esp_timer task, still loop-independent
+#endif
+  available = (esp_timer_create(&args, &handle) == ESP_OK);
+#endif
+  return available;
+}
+
+bool PulseTimer::isAvailable() const { return available; }
+
+// --- pulse control -------------------------------------------------------------
+
+void PulseTimer::start(uint8_t p, uint32_t durationUs) {
+  pin         = p;
+  requestedUs = durationUs;
+  completed   = false;
+  running     = true;
+  startUs     = pulseNowUs();
+#if PULSE_TIMER_HAS_ESP_TIMER
+  if (available) esp_timer_start_once(handle, durationUs);
+#endif
+}
+
+void PulseTimer::cancel() {
+  if (!running) return;
+#if PULSE_TIMER_HAS_ESP_TIMER
+  if (available) esp_timer_stop(handle);
+#endif
+  clearPin(pin);
+  running = false;
+}
+
+void PulseTimer::poll() {
+  if (!running || available) return;
+  if ((uint32_t)(pulseNowUs() - startUs) >= requestedUs) onExpire(this);
+}
+
+bool PulseTimer::isRunning() const { return running; }
+
+bool PulseTimer::consumeCompleted() {
+  if (!completed) return false;
+  completed = false;
+  return true;
+}
+
+int32_t  PulseTimer::getLastErrorUs() const { return lastErrorUs; }
+uint32_t PulseTimer::getMaxErrorUs()  const { return maxErrorUs; }
+
+// --- timer context ---------------------------------------------------------------
+
+void IRAM_ATTR PulseTimer::onExpire(void* arg) {
+  PulseTimer* self = static_cast<PulseTimer*>(arg);
+  clearPin(self->pin);
+  const int64_t width = pulseNowUs() - self->startUs;
+  const int32_t err   = (int32_t)(width - (int64_t)self->requestedUs);
+  self->lastErrorUs = err;
+  const uint32_t mag = (uint32_t)(err < 0 ? -err : err);
+  if (mag > self->maxErrorUs) self->maxErrorUs = mag;
+  self->running   = false;
+  self->completed = true;
+}
+
+void IRAM_ATTR PulseTimer::clearPin(uint8_t p) {
+  if (p == 0xFF) return;
+#if PULSE_TIMER_HAS_ESP_TIMER
+  // Direct write-1-to-clear store: safe from ISR/timer context, no driver locks
+  GpioOutputRegs::clear(uint8_t(p >> 5), 1UL << (p & 31));
+#else
+  digitalWrite(p, LOW);
+#endif
+}
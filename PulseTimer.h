@@ -0,0 +1,61 @@
+#ifndef PULSE_TIMER_H
+#define PULSE_TIMER_H
+
+#include <Arduino.h>
+
+#ifndef PULSE_TIMER_HAS_ESP_TIMER         // host builds set it to run the timer path on an esp_timer stand-in
+  #if defined(ARDUINO_ARCH_ESP32)
+    #define PULSE_TIMER_HAS_ESP_TIMER 1
+  #else
+    #define PULSE_TIMER_HAS_ESP_TIMER 0
+  #endif
+#endif
+#if PULSE_TIMER_HAS_ESP_TIMER
+  #include <esp_timer.h>
+#endif
+
+/**
+ * One-shot hardware timer that ends a drive pulse on time, independent of loop().
+ * - ESP32: esp_timer one-shot; the callback clears the pin with a single GPIO
+ *   register store, so pulse width no longer depends on the slowest loop pass.
+ * - Elsewhere: poll() from loop() ends the pulse (loop-resolution fallback).
+ * - The owner only observes completion via consumeCompleted().
+ */
+class PulseTimer {
+public:
+  PulseTimer();
+  ~PulseTimer();
+
+  bool begin();                               // create the timer; false = fall back to loop timing
+  bool isAvailable() const;
+
+  void start(uint8_t pin, uint32_t durationUs); // pin must already be driven HIGH
+  void cancel();                              // drop the pin now (e.g. end stop reached)
+  void poll();                                // only needed without esp_timer
+  bool isRunning() const;
+  bool consumeCompleted();                    // true once after the timer ended a pulse
+
+  int32_t  getLastErrorUs() const;            // measured - requested width of the last timed pulse
+  uint32_t getMaxErrorUs() const;             // worst |error| seen
+
+private:
+  static void IRAM_ATTR onExpire(void* arg);
+  static void IRAM_ATTR clearPin(uint8_t pin);
+
+#if PULSE_TIMER_HAS_ESP_TIMER
+  esp_timer_handle_t handle = nullptr;
+#endif
+  bool              available  = false;
+  volatile uint8_t  pin        = 0xFF;
+  volatile bool     running    = false;
+  volatile bool     completed  = false;
+  volatile int64_t  startUs    = 0;
+  volatile uint32_t requestedUs = 0;
+  volatile int32_t  lastErrorUs = 0;
+  volatile uint32_t maxErrorUs  = 0;
+
+  PulseTimer(const PulseTimer&) = delete;
+  PulseTimer& operator=(const PulseTimer&) = delete;
+};
+
+#endif // PULSE_TIMER_H
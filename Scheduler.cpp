@@ -0,0 +1,171 @@
+#include "Scheduler.h"
+
+// --- registration ------------------------------------------------------------
+
+int8_t Scheduler::addTask(const char* name, TaskFn fn, void* ctx, uint8_t priority,
+                          uint32_t periodUs, uint32_t budgetUs, bool deferrable) {
+  if (taskCount >= MAX_TASKS || !fn) return -1;
+
+  const uint8_t id = taskCount;
+  Task& t = tasks[id];
+  t.name        = name;
+  t.fn          = fn;
+  t.ctx         = ctx;
+  t.priority    = priority;
+  t.deferrable  = deferrable;
+  t.deferStreak = 0;
+  t.periodUs    = periodUs;
+  t.budgetUs    = budgetUs;
+  t.nextRunUs   = micros();
+  t.woken       = false;
+  t.stats       = TaskStats();
+
+  // Insert into the priority order (stable for equal priorities)
+  uint8_t rank = taskCount;
+  while (rank > 0 && tasks[order[rank - 1]].priority > priority) {
+    order[rank] = order[rank - 1];
+    --rank;
+  }
+  order[rank] = id;
+  ++taskCount;
+  return (int8_t)id;
+}
+
+// --- dispatch ------------------------------------------------------------------
+
+void Scheduler::run() {
+  bool ran[MAX_TASKS] = {false};
+
+  // Rescan from the top after every task so anything that became due meanwhile
+  // is served in priority order; each task runs at most once per pass.
+  for (;;) {
+    const uint32_t now = micros();
+    int8_t pick = -1;
+    for (uint8_t rank = 0; rank < taskCount; ++rank) {
+      const uint8_t id = order[rank];
+      Task& t = tasks[id];
+      if (ran[id] || !isDue(t, now)) continue;
+
+      if (t.deferrable && t.deferStreak < MAX_DEFER_STREAK &&
+          higherPriorityDeadlineWithin(rank, now, t.budgetUs)) {
+        // Running now could push a more important task past its due time
+        t.stats.deferrals++;
+        t.deferStreak++;
+        ran[id] = true;
+        continue;
+      }
+      pick = (int8_t)id;
+      break;
+    }
+    if (pick < 0) return;
+    ran[pick] = true;
+    runTask(tasks[pick], now);
+  }
+}
+
+void Scheduler::runTask(Task& t, uint32_t now) {
+  const uint32_t lateUs = now - t.nextRunUs;
+  if (lateUs > t.stats.maxLatencyUs) t.stats.maxLatencyUs = lateUs;
+
+  sliceStartUs  = micros();
+  sliceBudgetUs = t.budgetUs;
+  t.woken       = false;
+  t.fn(t.ctx);
+  const uint32_t dt = micros() - sliceStartUs;
+  sliceBudgetUs = 0;
+
+  t.stats.runs++;
+  t.stats.totalUs += dt;
+  if (dt > t.stats.maxUs) t.stats.maxUs = dt;
+  if (dt > t.budgetUs) t.stats.overruns++;
+  t.deferStreak = 0;
+
+  // Woken from inside its own run (split work): stay due for the next pass
+  if (t.woken) {
+    t.woken = false;
+    return;
+  }
+  // Keep the phase; if we fell more than a period behind, restart from now
+  t.nextRunUs += t.periodUs;
+  if ((int32_t)(micros() - t.nextRunUs) >= 0) t.nextRunUs = micros() + t.periodUs;
+}
+
+bool Scheduler::higherPriorityDeadlineWithin(uint8_t rank, uint32_t now, uint32_t windowUs) const {
+  for (uint8_t r = 0; r < rank; ++r) {
+    const Task& h = tasks[order[r]];
+    if (h.priority >= tasks[order[rank]].priority) break;
+    if ((int32_t)(h.nextRunUs - now) < (int32_t)windowUs) return true;
+  }
+  return false;
+}
+
+void Scheduler::wake(uint8_t id) {
+  if (id >= taskCount) return;
+  tasks[id].nextRunUs = micros();
+  tasks[id].woken     = true;
+}
+
+uint32_t Scheduler::remainingBudgetUs() const {
+  if (!sliceBudgetUs) return 0;
+  const uint32_t used = micros() - sliceStartUs;
+  return (used >= sliceBudgetUs) ? 0 : sliceBudgetUs - used;
+}
+
+uint32_t Scheduler::getIdleUs() const {
+  const uint32_t now = micros();
+  uint32_t idle = 0xFFFFFFFFUL;
+  for (uint8_t i = 0; i < taskCount; ++i) {
+    const int32_t until = (int32_t)(tasks[i].nextRunUs - now);
+    if (until <= 0) return 0;
+    if ((uint32_t)until < idle) idle = (uint32_t)until;
+  }
+  return taskCount ? idle : 0;
+}
+
+// --- statistics ----------------------------------------------------------------
+
+uint8_t Scheduler::getTaskCount() const { return taskCount; }
+
+const char* Scheduler::getTaskName(uint8_t id) const {
+  return (id < taskCount) ? tasks[id].name : "";
+}
+
+const Scheduler::TaskStats& Scheduler::getStats(uint8_t id) const {
+  static const TaskStats empty;
+  return (id < taskCount) ? tasks[id].stats : empty;
+}
+
+uint32_t Scheduler::getLatencyBoundUs(uint8_t id) const {
+  // Non-preemptive: a due task waits at most for one other task already running,
+  // plus every task ranked ahead of it (higher priority, or equal and added earlier)
+  // that becomes due in the same pass.
+  if (id >= taskCount) return 0;
+  uint32_t longestOther = 0;
+  for (uint8_t i = 0; i < taskCount; ++i) {
+    if (i != id && tasks[i].budgetUs > longestOther) longestOther = tasks[i].budgetUs;
+  }
+  uint32_t ahead = 0;
+  for (uint8_t rank = 0; rank < taskCount && order[rank] != id; ++rank) ahead += tasks[order[rank]].budgetUs;
+  return longestOther + ahead;
+}
+
+void Scheduler::resetStats() {
+  for (uint8_t i = 0; i < taskCount; ++i) tasks[i].stats = TaskStats();
+}
+
+void Scheduler::printStats(Print& out) const {
+  for (uint8_t rank = 0; rank < taskCount; ++rank) {
+    const uint8_t id = order[rank];
+    const Task& t = tasks[id];
+    out.print(t.name);
+    out.print(F(": runs="));     out.print(t.stats.runs);
+    out.print(F(" avg="));       out.print(t.stats.runs ? t.stats.totalUs / t.stats.runs : 0);
+    out.print(F("us max="));     out.print(t.stats.maxUs);
+    out.print(F("us budget="));  out.print(t.budgetUs);
+    out.print(F("us over="));    out.print(t.stats.overruns);
+    out.print(F(" defer="));     out.print(t.stats.deferrals);
+    out.print(F(" lateMax="));   out.print(t.stats.maxLatencyUs);
+    out.print(F("us bound="));   out.print(getLatencyBoundUs(id));
+    out.println(F("us"));
+  }
+}
@@ -0,0 +1,76 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+/**
+ * Small cooperative scheduler replacing a hand-written loop() body.
+ * - Tasks run to completion, highest priority (lowest number) first, at most once per pass.
+ * - Each task has a period and a time budget; runtime, overruns and start
+ *   latency (how late it started) are tracked per task.
+ * - Deferrable tasks are postponed while a higher-priority deadline falls inside
+ *   their budget, and can split their work using remainingBudgetUs().
+ * - No preemption: a task's start latency is bounded by one other task's budget
+ *   plus the budgets of every task ranked ahead of it (getLatencyBoundUs()), as long as
+ *   budgets hold.
+ * - A task that wake()s itself runs again on the next pass; its period restarts from that run.
+ */
+class Scheduler {
+public:
+  typedef void (*TaskFn)(void* ctx);
+
+  static const uint8_t MAX_TASKS         = 10;
+  static const uint8_t MAX_DEFER_STREAK  = 8;   // a deferrable task runs anyway after this many skips
+
+  struct TaskStats {
+    uint32_t runs         = 0;
+    uint32_t totalUs      = 0;
+    uint32_t maxUs        = 0;
+    uint32_t overruns     = 0;   // runs longer than the budget
+    uint32_t deferrals    = 0;   // passes skipped to protect a higher-priority deadline
+    uint32_t maxLatencyUs = 0;   // worst start time past the due time
+  };
+
+  // Returns the task id, or -1 when the table is full
+  int8_t addTask(const char* name, TaskFn fn, void* ctx, uint8_t priority,
+                 uint32_t periodUs, uint32_t budgetUs, bool deferrable = false);
+
+  void run();                                  // one scheduler pass, call from loop()
+  void wake(uint8_t id);                       // make a task due now (e.g. unfinished split work)
+  uint32_t remainingBudgetUs() const;          // inside a task: budget left for this run
+  uint32_t getIdleUs() const;                  // until the earliest task is due, 0 = one is due now
+
+  uint8_t          getTaskCount() const;
+  const char*      getTaskName(uint8_t id) const;
+  const TaskStats& getStats(uint8_t id) const;
+  uint32_t         getLatencyBoundUs(uint8_t id) const;
+  void             resetStats();
+  void             printStats(Print& out) const;
+
+private:
+  struct Task {
+    const char* name;
+    TaskFn      fn;
+    void*       ctx;
+    uint8_t     priority;
+    bool        deferrable;
+    uint8_t     deferStreak;
+    uint32_t    periodUs;
+    uint32_t    budgetUs;
+    uint32_t    nextRunUs;
+    bool        woken;              // wake() ran since the task last started: due at once, not a period later
+    TaskStats   stats;
+  };
+
+  bool isDue(const Task& t, uint32_t now) const { return (int32_t)(now - t.nextRunUs) >= 0; }
+  bool higherPriorityDeadlineWithin(uint8_t rank, uint32_t now, uint32_t windowUs) const;
+  void runTask(Task& t, uint32_t now);
+
+  Task     tasks[MAX_TASKS];            // indexed by task id
+  uint8_t  order[MAX_TASKS];            // task ids, highest priority first
+  uint8_t  taskCount = 0;
+  uint32_t sliceStartUs  = 0;
+  uint32_t sliceBudgetUs = 0;
+};
+
+#endif // SCHEDULER_H
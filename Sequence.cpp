@@ -0,0 +1,160 @@
+#include "Sequence.h"
+
+// --- frame pool --------------------------------------------------------------
+
+namespace {
+  struct FreeSlot { FreeSlot* next; };
+
+  alignas(alignof(max_align_t)) uint8_t framePool[SEQUENCE_MAX_FRAMES][SEQUENCE_FRAME_BYTES];
+  FreeSlot* freeList    = nullptr;
+  bool      poolReady   = false;
+  uint16_t  inUse       = 0;
+  uint16_t  peakInUse   = 0;
+  uint32_t  failures    = 0;
+  size_t    largestAsk  = 0;
+
+  static_assert(SEQUENCE_FRAME_BYTES % alignof(max_align_t) == 0, "SEQUENCE_FRAME_BYTES must keep slots aligned");
+  static_assert(SEQUENCE_FRAME_BYTES >= sizeof(FreeSlot), "SEQUENCE_FRAME_BYTES too small");
+}
+
+void* SequencePool::allocate(size_t bytes) {
+  if (!poolReady) {
+    // Thread the slots back to front so the first allocation gets slot 0
+    for (int i = SEQUENCE_MAX_FRAMES - 1; i >= 0; --i) {
+      FreeSlot* slot = reinterpret_cast<FreeSlot*>(framePool[i]);
+      slot->next = freeList;
+      freeList = slot;
+    }
+    poolReady = true;
+  }
+  if (bytes > largestAsk) largestAsk = bytes;
+  if (bytes > SEQUENCE_FRAME_BYTES || freeList == nullptr) { failures++; return nullptr; }
+
+  FreeSlot* slot = freeList;
+  freeList = slot->next;
+  if (++inUse > peakInUse) peakInUse = inUse;
+  return slot;
+}
+
+void SequencePool::release(void* frame) {
+  if (frame == nullptr) return;
+  FreeSlot* slot = static_cast<FreeSlot*>(frame);
+  slot->next = freeList;
+  freeList = slot;
+  inUse--;
+}
+
+uint16_t SequencePool::getInUse()          { return inUse; }
+uint16_t SequencePool::getPeakInUse()      { return peakInUse; }
+uint32_t SequencePool::getFailures()       { return failures; }
+size_t   SequencePool::getLargestRequest() { return largestAsk; }
+
+#if SEQUENCE_HAS_COROUTINES
+
+// --- Sequence ----------------------------------------------------------------
+
+Sequence Sequence::promise_type::get_return_object() noexcept {
+  return Sequence(Handle::from_promise(*this));
+}
+
+Sequence Sequence::promise_type::get_return_object_on_allocation_failure() noexcept {
+  return Sequence();
+}
+
+Sequence& Sequence::operator=(Sequence&& other) noexcept {
+  if (this != &other) {
+    if (handle) handle.destroy();
+    handle = other.handle;
+    other.handle = nullptr;
+  }
+  return *this;
+}
+
+Sequence::~Sequence() {
+  if (handle) handle.destroy();
+}
+
+// --- executor ------------------------------------------------------------------
+
+bool SequenceExecutor::start(Sequence&& sequence) {
+  if (!sequence.handle) return false;
+  Sequence::promise_type& p = sequence.handle.promise();
+  p.executor = this;
+  p.wait     = Sequence::promise_type::Wait::None; // runs up to its first await on the next run()
+  p.next     = head;
+  head       = &p;
+  sequence.handle = nullptr; // frame is owned by the executor now
+  activeCount++;
+  return true;
+}
+
+void SequenceExecutor::run(uint32_t nowMs) {
+  clockMs = nowMs;
+  // Sequences started from inside a resumed one go to the head and wait for the next pass;
+  // a start() during resume() can put one in front of p, so its link is looked up again
+  Sequence::promise_type** link = &head;
+  while (*link) {
+    Sequence::promise_type* p = *link;
+    if (p->wait == Sequence::promise_type::Wait::Valve && !p->issued) reissue(*p);
+    if (!isReady(*p)) { link = &p->next; continue; }
+
+    p->wait = Sequence::promise_type::Wait::None;
+    Sequence::Handle h = Sequence::Handle::from_promise(*p);
+    h.resume();
+    if (h.done()) {
+      while (*link != p) link = &(*link)->next;
+      *link = p->next;
+      h.destroy();
+      activeCount--;
+      completedCount++;
+      continue;
+    }
+    link = &p->next;
+  }
+}
+
+void SequenceExecutor::cancelAll() {
+  while (head) {
+    Sequence::promise_type* p = head;
+    head = p->next;
+    Sequence::Handle::from_promise(*p).destroy();
+  }
+  activeCount = 0;
+}
+
+void SequenceExecutor::reissue(Sequence::promise_type& p) {
+  p.issued = p.target ? p.valve->requestOpen() : p.valve->requestClose();
+}
+
+bool SequenceExecutor::isReady(const Sequence::promise_type& p) const {
+  switch (p.wait) {
+    case Sequence::promise_type::Wait::Sleep:
+      return (int32_t)(clockMs - p.wakeAt) >= 0;
+    case Sequence::promise_type::Wait::Valve:
+      return p.issued && !p.valve->isInTransition();
+    default:
+      return true;
+  }
+}
+
+// --- awaiters ------------------------------------------------------------------
+
+namespace seq {
+
+void SleepAwaiter::await_suspend(Sequence::Handle h) const noexcept {
+  Sequence::promise_type& p = h.promise();
+  p.wakeAt = p.executor->now() + ms;
+  p.wait   = Sequence::promise_type::Wait::Sleep;
+}
+
+void ValveAwaiter::await_suspend(Sequence::Handle h) const noexcept {
+  Sequence::promise_type& p = h.promise();
+  p.valve  = &valve;
+  p.target = target;
+  p.issued = target ? valve.requestOpen() : valve.requestClose();
+  p.wait   = Sequence::promise_type::Wait::Valve;
+}
+
+} // namespace seq
+
+#endif // SEQUENCE_HAS_COROUTINES
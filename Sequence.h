@@ -0,0 +1,152 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include "Valve.h"
+
+#ifndef SEQUENCE_MAX_FRAMES
+  #define SEQUENCE_MAX_FRAMES 16   // Concurrent sequences (frame pool slots)
+#endif
+#ifndef SEQUENCE_FRAME_BYTES
+  #define SEQUENCE_FRAME_BYTES 160 // Per-slot size; a larger frame fails to start (see getLargestRequest())
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+  #include <coroutine>
+  #include <chrono>
+  #define SEQUENCE_HAS_COROUTINES 1
+#else
+  #define SEQUENCE_HAS_COROUTINES 0 // needs -std=gnu++20 or later (default on arduino-esp32 3.x)
+#endif
+
+/**
+ * Fixed pool of coroutine frames: SEQUENCE_MAX_FRAMES slots of SEQUENCE_FRAME_BYTES,
+ * statically allocated, intrusive free list, no heap at any time.
+ * A running sequence costs exactly one slot.
+ */
+class SequencePool {
+public:
+  static void*    allocate(size_t bytes);   // nullptr if too large or the pool is exhausted
+  static void     release(void* frame);
+
+  static uint16_t getInUse();
+  static uint16_t getPeakInUse();
+  static uint32_t getFailures();            // starts refused for size or exhaustion
+  static size_t   getLargestRequest();      // biggest frame asked for, to size SEQUENCE_FRAME_BYTES
+};
+
+#if SEQUENCE_HAS_COROUTINES
+
+class SequenceExecutor;
+
+/**
+ * Stackless coroutine describing a valve program, e.g.
+ *
+ *   Sequence zones(Valve& z1, Valve& z2, Valve& main) {
+ *     co_await seq::open(z1);  co_await seq::sleep_for(10min); co_await seq::close(z1);
+ *     co_await seq::open(z2);  co_await seq::sleep_for(5min);  co_await seq::close(z2);
+ *     co_await seq::open(main); co_await seq::sleep_for(30s);  co_await seq::close(main);
+ *   }
+ *   executor.start(zones(valve, valve2, valve3));
+ *
+ * - Created suspended; nothing runs until SequenceExecutor::start() adopts it.
+ * - Valves used by a sequence should have setAutoCycle(false).
+ */
+class Sequence {
+public:
+  struct promise_type {
+    // What the suspended sequence waits for; polled by the executor
+    enum class Wait : uint8_t { None, Sleep, Valve };
+
+    promise_type*     next      = nullptr; // executor's intrusive list
+    SequenceExecutor* executor  = nullptr;
+    ::Valve*          valve     = nullptr;
+    uint32_t          wakeAt    = 0;       // Sleep: executor clock (ms) to resume at
+    Wait              wait      = Wait::None;
+    bool              target    = false;   // Valve: true = open, false = closed
+    bool              issued    = false;   // Valve: request accepted (valve was not busy)
+
+    Sequence get_return_object() noexcept;
+    static Sequence get_return_object_on_allocation_failure() noexcept;
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; } // executor destroys the frame
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {}
+
+    static void* operator new(size_t bytes) noexcept { return SequencePool::allocate(bytes); }
+    static void  operator delete(void* frame) noexcept { SequencePool::release(frame); }
+  };
+  typedef std::coroutine_handle<promise_type> Handle;
+
+  Sequence() {}
+  Sequence(Sequence&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+  Sequence& operator=(Sequence&& other) noexcept;
+  ~Sequence();                     // destroys a sequence that was never started
+
+  bool isValid() const { return (bool)handle; } // false when the frame pool was full
+
+private:
+  friend class SequenceExecutor;
+  explicit Sequence(Handle h) : handle(h) {}
+  Handle handle = nullptr;
+
+  Sequence(const Sequence&) = delete;
+  Sequence& operator=(const Sequence&) = delete;
+};
+
+/**
+ * Runs sequences off the same millisecond clock the valves use.
+ * - run() resumes every sequence whose sleep expired or whose valve finished its move;
+ *   call it from loop()/a scheduler task. Pass a time to drive it from a virtual clock.
+ * - Cost per pass is one short check per live sequence; no allocation after start().
+ */
+class SequenceExecutor {
+public:
+  bool start(Sequence&& sequence); // false if the frame could not be allocated
+  void run() { run(millis()); }
+  void run(uint32_t nowMs);
+  void cancelAll();                // drops every sequence at its current await; valves stay as they are
+
+  uint32_t now() const { return clockMs; }
+  uint16_t getActiveCount() const { return activeCount; }
+  uint32_t getCompletedCount() const { return completedCount; }
+
+private:
+  static void reissue(Sequence::promise_type& p); // valve was busy when the await started: ask again
+  bool isReady(const Sequence::promise_type& p) const;
+
+  Sequence::promise_type* head = nullptr;
+  uint32_t clockMs        = 0;
+  uint16_t activeCount    = 0;
+  uint32_t completedCount = 0;
+};
+
+namespace seq {
+
+  // co_await seq::sleep_for(10min) / sleep_for(30s) / sleep_for(500ms)
+  struct SleepAwaiter {
+    uint32_t ms;
+    bool await_ready() const noexcept { return ms == 0; }
+    void await_suspend(Sequence::Handle h) const noexcept;
+    void await_resume() const noexcept {}
+  };
+
+  // co_await seq::open(v) resumes once the valve is open and its move has finished
+  struct ValveAwaiter {
+    Valve& valve;
+    bool   target;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Sequence::Handle h) const noexcept;
+    void await_resume() const noexcept {}
+  };
+
+  inline SleepAwaiter sleep_for(std::chrono::milliseconds d) { return SleepAwaiter{ (uint32_t)d.count() }; }
+  inline ValveAwaiter open(Valve& v)  { return ValveAwaiter{ v, true }; }
+  inline ValveAwaiter close(Valve& v) { return ValveAwaiter{ v, false }; }
+
+} // namespace seq
+
+#endif // SEQUENCE_HAS_COROUTINES
+
+#endif // SEQUENCE_H
@@ -0,0 +1,209 @@
+#include "TrendStore.h"
+
+#define TREND_MINUTE_MS 60000UL
+
+static const uint8_t TREND_CAPACITY[4] = { TREND_RAW_SAMPLES, TREND_MINUTES, TREND_HOURS, TREND_DAYS };
+static const char    TREND_TIER_NAME[4][4] = { "raw", "min", "hr", "day" };
+
+static_assert(TREND_RAW_SAMPLES <= 255 && TREND_MINUTES <= 255 && TREND_HOURS <= 255 && TREND_DAYS <= 255,
+              "trend rings are indexed with uint8_t");
+
+// --- accumulator -------------------------------------------------------------
+
+void TrendStore::Accumulator::addSample(int16_t v) {
+  if (!count || v < min) min = v;
+  if (!count || v > max) max = v;
+  sum += v;
+  count++;
+}
+
+void TrendStore::Accumulator::merge(const Accumulator& other) {
+  if (!other.count) return;
+  if (!count || other.min < min) min = other.min;
+  if (!count || other.max > max) max = other.max;
+  sum   += other.sum;
+  count += other.count;
+}
+
+TrendStore::Bucket TrendStore::Accumulator::close() const {
+  Bucket b = { min, max, 0, (uint16_t)(count > 0xFFFF ? 0xFFFF : count) };
+  if (count) {
+    const int64_t half = count / 2;     // round to nearest
+    b.mean = (int16_t)((sum >= 0 ? sum + half : sum - half) / (int64_t)count);
+  }
+  return b;
+}
+
+// --- setup -------------------------------------------------------------------
+
+TrendStore::TrendStore(uint8_t frac) : fracBits(frac > 14 ? 14 : frac) {}
+
+void TrendStore::begin(uint32_t nowMs) {
+  for (uint8_t t = 0; t < 4; ++t) { head[t] = 0; count[t] = 0; revision[t]++; }
+  minuteAcc = Accumulator();
+  hourAcc   = Accumulator();
+  dayAcc    = Accumulator();
+  minutesInHour = 0;
+  hoursInDay    = 0;
+  minuteStartMs = nowMs;
+}
+
+// --- sampling ----------------------------------------------------------------
+
+void TrendStore::add(int32_t value, uint32_t nowMs) {
+  // Close every minute that ended before this sample (empty ones included, so age = time)
+  const uint32_t ended = (nowMs - minuteStartMs) / TREND_MINUTE_MS;
+  if (ended) {
+    closeMinutes(ended);
+    minuteStartMs += ended * TREND_MINUTE_MS;
+  }
+
+  const int16_t v = (int16_t)constrain(value, (int32_t)INT16_MIN, (int32_t)INT16_MAX);
+  raw[head[0]] = v;
+  head[0] = uint8_t((head[0] + 1) % TREND_RAW_SAMPLES);
+  if (count[0] < TREND_RAW_SAMPLES) count[0]++;
+  revision[0]++;
+  minuteAcc.addSample(v);
+}
+
+void TrendStore::closeMinute() {
+  push(Tier::Minute, minuteAcc.close());
+  hourAcc.merge(minuteAcc);
+  minuteAcc = Accumulator();
+  if (++minutesInHour < 60) return;
+
+  minutesInHour = 0;
+  push(Tier::Hour, hourAcc.close());
+  dayAcc.merge(hourAcc);
+  hourAcc = Accumulator();
+  if (++hoursInDay < 24) return;
+
+  hoursInDay = 0;
+  push(Tier::Day, dayAcc.close());
+  dayAcc = Accumulator();
+}
+
+void TrendStore::closeMinutes(uint32_t n) {
+  closeMinute();                        // the open minute, with its samples
+  if (--n == 0) return;
+
+  // The rest are empty: each tier moves by the whole gap at once, whatever its length
+  pushEmpty(Tier::Minute, n);
+  const uint32_t minutes = minutesInHour + n;
+  minutesInHour = uint8_t(minutes % 60);
+  const uint32_t hours = minutes / 60;  // hours closed, the running one first
+  if (!hours) return;
+
+  push(Tier::Hour, hourAcc.close());
+  dayAcc.merge(hourAcc);
+  hourAcc = Accumulator();
+  pushEmpty(Tier::Hour, hours - 1);
+  const uint32_t hoursTotal = hoursInDay + hours;
+  hoursInDay = uint8_t(hoursTotal % 24);
+  const uint32_t days = hoursTotal / 24;
+  if (!days) return;
+
+  push(Tier::Day, dayAcc.close());
+  dayAcc = Accumulator();
+  pushEmpty(Tier::Day, days - 1);
+}
+
+void TrendStore::pushEmpty(Tier tier, uint32_t n) {
+  if (!n) return;
+  const uint8_t t   = (uint8_t)tier;
+  const uint8_t cap = TREND_CAPACITY[t];
+  Bucket* slots = const_cast<Bucket*>(ring(tier));
+  // Only the last cap of them can still be in the ring
+  const uint8_t writes = uint8_t(n < cap ? n : cap);
+  uint8_t slot = uint8_t((head[t] + (n - writes)) % cap);
+  for (uint8_t i = 0; i < writes; ++i) {
+    slots[slot] = Bucket{ 0, 0, 0, 0 };
+    slot = uint8_t((slot + 1) % cap);
+  }
+  head[t]  = slot;
+  count[t] = uint8_t(count[t] + n < cap ? count[t] + n : cap);
+  revision[t] += n;
+}
+
+void TrendStore::push(Tier tier, const Bucket& bucket) {
+  const uint8_t t = (uint8_t)tier;
+  Bucket* slots = const_cast<Bucket*>(ring(tier));
+  slots[head[t]] = bucket;
+  head[t] = uint8_t((head[t] + 1) % TREND_CAPACITY[t]);
+  if (count[t] < TREND_CAPACITY[t]) count[t]++;
+  revision[t]++;
+}
+
+// --- readers -----------------------------------------------------------------
+
+const TrendStore::Bucket* TrendStore::ring(Tier tier) const {
+  switch (tier) {
+    case Tier::Minute: return minutes;
+    case Tier::Hour:   return hours;
+    case Tier::Day:    return days;
+    default:           return nullptr;  // raw samples are plain int16
+  }
+}
+
+uint8_t  TrendStore::getCapacity(Tier tier) const { return TREND_CAPACITY[(uint8_t)tier]; }
+uint8_t  TrendStore::getCount(Tier tier)    const { return count[(uint8_t)tier]; }
+uint32_t TrendStore::getRevision(Tier tier) const { return revision[(uint8_t)tier]; }
+
+bool TrendStore::getBucket(Tier tier, uint8_t age, Bucket& out) const {
+  const uint8_t t = (uint8_t)tier;
+  if (age >= count[t]) return false;
+  const uint8_t slot = uint8_t((head[t] + TREND_CAPACITY[t] - 1 - age) % TREND_CAPACITY[t]);
+  if (tier == Tier::Raw) {
+    out = { raw[slot], raw[slot], raw[slot], 1 };
+  } else {
+    out = ring(tier)[slot];
+  }
+  return true;
+}
+
+TrendStore::Bucket TrendStore::getOpen(Tier tier) const {
+  if (tier == Tier::Raw) {
+    Bucket b = { 0, 0, 0, 0 };
+    getBucket(Tier::Raw, 0, b);
+    return b;
+  }
+  // The open day includes the open hour, which includes the open minute
+  Accumulator acc;
+  if (tier == Tier::Day) acc.merge(dayAcc);
+  if (tier != Tier::Minute) acc.merge(hourAcc);
+  acc.merge(minuteAcc);
+  return acc.close();
+}
+
+// --- dump --------------------------------------------------------------------
+
+void TrendStore::printFixed(Print& out, int16_t v) const {
+  int32_t x = v;
+  if (x < 0) { out.print('-'); x = -x; }
+  if (!fracBits) { out.print(x); return; }
+  const uint32_t hundredths = ((uint32_t)x * 100 + (1UL << (fracBits - 1))) >> fracBits; // rounded
+  out.print(hundredths / 100);
+  out.print('.');
+  if (hundredths % 100 < 10) out.print('0');
+  out.print(hundredths % 100);
+}
+
+void TrendStore::printCsv(Print& out, Tier tier) const {
+  Bucket b;
+  for (uint8_t age = 0; getBucket(tier, age, b); ++age) {
+    out.print(TREND_TIER_NAME[(uint8_t)tier]);
+    out.print(',');  out.print(age);
+    out.print(',');  printFixed(out, b.min);
+    out.print(',');  printFixed(out, b.max);
+    out.print(',');  printFixed(out, b.mean);
+    out.print(',');  out.println(b.count);
+  }
+}
+
+void TrendStore::printCsv(Print& out) const {
+  out.println(F("tier,age,min,max,mean,count"));
+  printCsv(out, Tier::Raw);
+  printCsv(out, Tier::Minute);
+  printCsv(out, Tier::Hour);
+  printCsv(out, Tier::Day);
+}
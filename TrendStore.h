@@ -0,0 +1,83 @@
+#ifndef TREND_STORE_H
+#define TREND_STORE_H
+
+#include <Arduino.h>
+
+#define TREND_RAW_SAMPLES 60  // newest samples at the caller's rate
+#define TREND_MINUTES     60  // 1 h of minute buckets
+#define TREND_HOURS       48  // 2 days of hour buckets
+#define TREND_DAYS        30  // a month of day buckets
+
+/**
+ * Tiered time series for on-device trends (valve duty, sensor readings).
+ * - Samples are int16 fixed point with fracBits fractional bits (e.g. 7: 100 % = 12800);
+ *   add() saturates anything wider.
+ * - Raw ring of the newest samples, then minute, hour and day rings of 8-byte buckets
+ *   (min, max, mean, count). Each add() only touches the open minute; a closing minute
+ *   merges into the open hour and that into the open day, so the work per sample is O(1).
+ * - Minutes without samples are kept as empty buckets (count 0), so age = time; a long gap
+ *   moves every tier by its length in one step instead of closing it minute by minute.
+ * - Readers get buckets by age (0 = newest closed) and a per-tier revision that bumps when
+ *   the tier gains a bucket: a display can tell "nothing new" without looking at the data.
+ * - printCsv() dumps one tier or all of them for offline plotting.
+ */
+class TrendStore {
+public:
+  enum class Tier : uint8_t { Raw, Minute, Hour, Day };
+  struct Bucket {
+    int16_t  min;
+    int16_t  max;
+    int16_t  mean;
+    uint16_t count;                     // samples merged, 0 = gap
+  };
+
+  explicit TrendStore(uint8_t fracBits = 0);
+  void begin(uint32_t nowMs);           // starts the first minute; also clears all tiers
+  void add(int32_t value, uint32_t nowMs);
+
+  uint8_t  getCapacity(Tier tier) const;
+  uint8_t  getCount(Tier tier) const;   // closed buckets held (raw: samples)
+  bool     getBucket(Tier tier, uint8_t age, Bucket& out) const; // false past getCount()
+  Bucket   getOpen(Tier tier) const;    // bucket still filling (raw: newest sample)
+  uint32_t getRevision(Tier tier) const;
+  uint8_t  getFracBits() const { return fracBits; }
+
+  void printCsv(Print& out, Tier tier) const; // "tier,age,min,max,mean,count", values in units
+  void printCsv(Print& out) const;            // all tiers, newest first
+
+private:
+  struct Accumulator {
+    int64_t  sum   = 0;
+    uint32_t count = 0;
+    int16_t  min   = 0;
+    int16_t  max   = 0;
+    void   addSample(int16_t v);
+    void   merge(const Accumulator& other);
+    Bucket close() const;
+  };
+
+  void closeMinute();
+  void closeMinutes(uint32_t n);        // n >= 1: the open minute, then n - 1 empty ones
+  void push(Tier tier, const Bucket& bucket);
+  void pushEmpty(Tier tier, uint32_t n); // n empty buckets, at most one ring's worth written
+  const Bucket* ring(Tier tier) const;
+  void printFixed(Print& out, int16_t v) const;
+
+  int16_t  raw[TREND_RAW_SAMPLES];
+  Bucket   minutes[TREND_MINUTES];
+  Bucket   hours[TREND_HOURS];
+  Bucket   days[TREND_DAYS];
+  uint8_t  head[4]     = {0, 0, 0, 0};  // next write slot per tier
+  uint8_t  count[4]    = {0, 0, 0, 0};
+  uint32_t revision[4] = {0, 0, 0, 0};
+
+  Accumulator minuteAcc;
+  Accumulator hourAcc;                  // closed minutes of the running hour
+  Accumulator dayAcc;                   // closed hours of the running day
+  uint8_t  minutesInHour = 0;
+  uint8_t  hoursInDay    = 0;
+  uint32_t minuteStartMs = 0;
+  uint8_t  fracBits;
+};
+
+#endif // TREND_STORE_H
@@ -1,26 +1,57 @@
 #include <Valve.h>
 
 Valve::Valve(uint16_t openTimeMinutes, uint16_t closedTimeMinutes, uint16_t cycleTimeMillis) {
-    this->openTime = openTimeMinutes * 60000;   // Convert minutes to milliseconds
-    this->closedTime = closedTimeMinutes * 60000; // Convert minutes to milliseconds
+    this->openTime = openTimeMinutes * 60000UL;   // Convert minutes to milliseconds
+    this->closedTime = closedTimeMinutes * 60000UL; // Convert minutes to milliseconds
     //this->valveCycleTime = 3500; // Default valve cycle time in milliseconds for US Solid Model: USS-MSV00002
-    this->valveCycleTime = valveCycleTime; // in milliseconds
+    this->valveCycleTime = cycleTimeMillis; // in milliseconds
     this->lastToggleTime = millis();
     this->isOpen = false; // Start with valve closed
     this->vavleInTransition = false;
-    this->dwellTimeStart = 0;
+    this->outputs = &GpioOutputDriver::instance();
+    this->valveOpenPin = VALVE_NO_PIN;
+    this->valveClosePin = VALVE_NO_PIN;
+    this->valveLEDStatePin = VALVE_NO_PIN;
+    this->outputsReady = false;
+    this->openLimitPin = VALVE_NO_PIN;
+    this->closedLimitPin = VALVE_NO_PIN;
+    this->limitActiveLevel = LOW;
+    this->limitInputs = nullptr;
+    this->drivePin = VALVE_NO_PIN;
+    this->pulseStartTime = 0;
+    this->learnedTravelTime[0] = 0;
+    this->learnedTravelTime[1] = 0;
+    this->lastTravelTime = 0;
+    this->limitAtStart = false;
+    this->fault = Fault::None;
+    this->flowMeter = nullptr;
+    this->closeAfterMl = 0;
+    this->flowStartCount = 0;
+    this->sensors = nullptr;
+    this->sensorChannel = 0;
+    this->sensorStopLevel = AnalogSensors::Level::High;
+    this->stats.begin(this->lastToggleTime);
+    this->hardwarePulse = false;
+    this->driveMode = DriveMode::LatchingPulse;
+    this->pullInTime = 150;
+    this->holdDuty = 77;
+    this->holdPending = false;
+    this->autoCycle = true;
+    this->transitionFn = nullptr;
+    this->transitionCtx = nullptr;
 }
 
-Valve::Valve(uint16_t openTimeMinutes, uint16_t closedTimeMinutes, uint16_t cycleTimeMillis, uint8_t openPin, uint8_t closePin, uint8_t ledPin) : Valve(openTimeMinutes, closedTimeMinutes, cycleTimeMinutes) {
-    this->valveOpenPin = openPin;
-    this->valveClosePin = closePin;
-    this->valveLEDStatePin = ledPin;
-    pinMode(this->valveOpenPin, OUTPUT);
-    pinMode(this->valveClosePin, OUTPUT);
-    pinMode(this->valveLEDStatePin, OUTPUT);
-    digitalWrite(this->valveOpenPin, LOW);
-    digitalWrite(this->valveClosePin, LOW);
-    digitalWrite(this->valveLEDStatePin, LOW); // LED OFF when valve is closed
+Valve::Valve(uint16_t openTimeMinutes, uint16_t closedTimeMinutes, uint16_t cycleTimeMillis, uint8_t openPin, uint8_t closePin, uint8_t ledPin)
+    : Valve(openTimeMinutes, closedTimeMinutes, cycleTimeMillis, GpioOutputDriver::instance(), openPin, closePin, ledPin) {
+}
+
+Valve::Valve(uint16_t openTimeMinutes, uint16_t closedTimeMinutes, uint16_t cycleTimeMillis, OutputDriver& driver, uint8_t openChannel, uint8_t closeChannel, uint8_t ledChannel) : Valve(openTimeMinutes, closedTimeMinutes, cycleTimeMillis) {
+    this->outputs = &driver;
+    this->valveOpenPin = openChannel;
+    this->valveClosePin = closeChannel;
+    this->valveLEDStatePin = ledChannel;
+    // Channels are configured on first use (configureOutputs()), not here: global valves are
+    // built before setup(), and driving the pins then would undo a warm restart's state
 }
 
 Valve::~Valve() {
@@ -29,32 +60,27 @@ Valve::~Valve() {
 
 void Valve::update() {
     unsigned long currentTime = millis();
+    if (!outputsReady) configureOutputs();
+    servicePulse(currentTime); // Cut the running pulse at the end stop or after valveCycleTime
+    if (holdPending && (currentTime - pulseStartTime >= pullInTime)) {
+        outputs->writeDuty(valveOpenPin, holdDuty); // Armature is in: drop to hold current
+        holdPending = false;
+    }
+    if (!autoCycle) return; // Opened/closed only through requestOpen()/requestClose()
     if (isOpen) {
         // Valve is currently open
-        if ((currentTime - lastToggleTime >= openTime) && !vavleInTransition) {
+        bool volumeReached = (flowMeter != nullptr) && (closeAfterMl != 0) && (getDispensedVolume() >= closeAfterMl);
+        if ((currentTime - lastToggleTime >= openTime || volumeReached || isSensorStop()) && !vavleInTransition) {
             // Time to close the valve
-            digitalWrite(valveClosePin, HIGH);
-            //delay(valveCycleTime);
-            valveDelay(currentTime);
-            digitalWrite(valveClosePin, LOW);
-            isOpen = false;
-            lastToggleTime = currentTime;
-            digitalWrite(valveLEDStatePin, LOW); // LED OFF when valve is closed
+            closeNow(currentTime);
         }
     } else {
         // Valve is currently closed
-        if ((currentTime - lastToggleTime >= closedTime) && !vavleInTransition) {
-            // Time to open the valve
-            digitalWrite(valveOpenPin, HIGH);
-            //delay(valveCycleTime);
-            valveDelay(currentTime);
-            digitalWrite(valveOpenPin, LOW);
-            isOpen = true;
-            lastToggleTime = currentTime;
-            digitalWrite(valveLEDStatePin, HIGH); // LED ON when valve is open
+        if ((currentTime - lastToggleTime >= closedTime) && !vavleInTransition && !isSensorStop()) {
+            // Time to open the valve (held off while the sensor condition stands)
+            openNow(currentTime);
         }
     }
-    valveDelay(); // Check and update transition state
 }
 
 bool Valve::getState() {
@@ -70,12 +96,18 @@ uint32_t Valve::getCurrentCycleTime() {
     }
 }
 
+uint32_t Valve::getRemainingTime() {
+    unsigned long elapsed = millis() - lastToggleTime;
+    uint32_t dwell = isOpen ? openTime : closedTime;
+    return (elapsed >= dwell) ? 0 : (dwell - elapsed) / 1000; // in seconds
+}
+
 void Valve::setOpenTime(uint16_t openTimeMinutes) {
-    this->openTime = openTimeMinutes * 60000; // Convert minutes to milliseconds
+    this->openTime = openTimeMinutes * 60000UL; // Convert minutes to milliseconds
 }
 
 void Valve::setClosedTime(uint16_t closedTimeMinutes) {
-    this->closedTime = closedTimeMinutes * 60000; // Convert minutes to milliseconds
+    this->closedTime = closedTimeMinutes * 60000UL; // Convert minutes to milliseconds
 }
 
 void Valve::setCycleTime(uint16_t cycleTime) {
@@ -94,23 +126,320 @@ uint16_t Valve::getCycleTime() {
     return this->valveCycleTime; // in milliseconds
 }
 
-private:
+// --- End-of-travel feedback ---
+
+void Valve::setLimitPins(uint8_t openLimit, uint8_t closedLimit, uint8_t activeLevel) {
+    this->openLimitPin = openLimit;
+    this->closedLimitPin = closedLimit;
+    this->limitActiveLevel = activeLevel;
+    uint8_t mode = (activeLevel == LOW) ? INPUT_PULLUP : INPUT;
+    if (this->openLimitPin != VALVE_NO_PIN) pinMode(this->openLimitPin, mode);
+    if (this->closedLimitPin != VALVE_NO_PIN) pinMode(this->closedLimitPin, mode);
+    this->limitInputs = nullptr;
+}
+
+void Valve::setLimitPins(InputScanner& scanner, uint8_t openLimit, uint8_t closedLimit, bool activeLow) {
+    this->openLimitPin = openLimit;
+    this->closedLimitPin = closedLimit;
+    this->limitActiveLevel = activeLow ? LOW : HIGH;
+    if (this->openLimitPin != VALVE_NO_PIN) scanner.addInput(this->openLimitPin, activeLow, activeLow);
+    if (this->closedLimitPin != VALVE_NO_PIN) scanner.addInput(this->closedLimitPin, activeLow, activeLow);
+    this->limitInputs = &scanner; // the scanner inverts active-low inputs: isActive() means "at the stop"
+}
+
+bool Valve::isInTransition() {
+    return this->vavleInTransition;
+}
+
+uint16_t Valve::getLearnedTravelTime(bool opening) {
+    return this->learnedTravelTime[opening ? 1 : 0]; // in milliseconds
+}
+
+uint16_t Valve::getLastTravelTime() {
+    return this->lastTravelTime; // in milliseconds
+}
+
+uint16_t Valve::getActuationWindow() {
+    // Without a learned value the full cycle time is budgeted
+    bool opening = this->vavleInTransition ? isOpen : !isOpen;
+    uint16_t bound = getTravelBound(opening);
+    return (bound == 0 || bound > this->valveCycleTime) ? this->valveCycleTime : bound;
+}
+
+Valve::Fault Valve::getFault() {
+    return this->fault;
+}
+
+void Valve::clearFault() {
+    this->fault = Fault::None;
+}
+
+// --- Volume-based closing ---
+
+void Valve::setFlowMeter(FlowMeter* meter, uint32_t closeAfterMillilitres) {
+    this->flowMeter = meter;
+    this->closeAfterMl = closeAfterMillilitres;
+    if (this->flowMeter != nullptr) this->flowStartCount = this->flowMeter->getPulseCount();
+}
+
+void Valve::setCloseVolume(uint32_t closeAfterMillilitres) {
+    this->closeAfterMl = closeAfterMillilitres; // in millilitres
+}
+
+uint32_t Valve::getCloseVolume() {
+    return this->closeAfterMl; // in millilitres
+}
+
+uint32_t Valve::getDispensedVolume() {
+    if (this->flowMeter == nullptr || !isOpen) return 0;
+    return this->flowMeter->pulsesToMillilitres(this->flowMeter->getPulseCount() - this->flowStartCount);
+}
+
+// --- Sensor condition ---
+
+void Valve::setSensorCondition(const AnalogSensors* sensors, uint8_t channel, AnalogSensors::Level stopLevel) {
+    this->sensors = sensors;
+    this->sensorChannel = channel;
+    this->sensorStopLevel = stopLevel;
+}
+
+bool Valve::isSensorStop() {
+    // Published level only: O(1), no ADC access from the control path
+    return this->sensors != nullptr && this->sensors->getLevel(this->sensorChannel) == this->sensorStopLevel;
+}
+
+// --- Runtime statistics ---
+
+ValveStats& Valve::getStats() {
+    return this->stats;
+}
+
+// --- Hardware-timed pulse end ---
 
-void Valve::valveDelay(uint32_t startTime) {
-    //delay(this->valveCycleTime);
-    this->dwellTimeStart = startTime;
-    valveDelay();
+bool Valve::setHardwarePulseTiming(bool enable) {
+    if (enable && !this->outputs->isDirectGpio()) return false; // timer context can't run a bus transaction
+    if (enable) this->pulseTimer.begin(); // without esp_timer the pulse is still ended from update()
+    this->hardwarePulse = enable;
+    return true;
 }
 
-void Valve::valveDelay() {
-    //delay(this->valveCycleTime);
-    if (!this->vavleInTransition && this->dwellTimeStart == 0) {
-        this->vavleInTransition = true;
-        this->dwellTimeStart = millis();
+int32_t Valve::getLastPulseErrorUs() {
+    return this->pulseTimer.getLastErrorUs();
+}
+
+uint32_t Valve::getMaxPulseErrorUs() {
+    return this->pulseTimer.getMaxErrorUs();
+}
+
+// --- Drive mode ---
+
+void Valve::setDriveMode(DriveMode mode, uint16_t pullInMillis, uint8_t holdDutyCycle) {
+    this->driveMode = mode;
+    this->pullInTime = pullInMillis;
+    this->holdDuty = holdDutyCycle;
+    this->holdPending = false;
+    if (!this->outputsReady) configureOutputs();
+    // Re-apply the current state in the new mode
+    if (mode == DriveMode::PeakHold) {
+        this->outputs->writeDuty(this->valveOpenPin, this->isOpen ? this->holdDuty : 0);
+    } else {
+        this->outputs->write(this->valveOpenPin, LOW);
     }
-    
-    if (this->dwellTimeStart + this->valveCycleTime >= millis()) {
-        vavleInTransition = false;
-        this->dwellTimeStart = 0;
+}
+
+Valve::DriveMode Valve::getDriveMode() {
+    return this->driveMode;
+}
+
+// --- Manual control ---
+
+void Valve::setAutoCycle(bool enable) {
+    this->autoCycle = enable;
+    this->lastToggleTime = millis(); // Restart the dwell from now when handing control back
+}
+
+bool Valve::getAutoCycle() {
+    return this->autoCycle;
+}
+
+bool Valve::requestOpen() {
+    if (this->vavleInTransition) return false; // Busy: caller retries once the move is done
+    if (!this->isOpen) openNow(millis());
+    return true;
+}
+
+bool Valve::requestClose() {
+    if (this->vavleInTransition) return false;
+    if (this->isOpen) closeNow(millis());
+    return true;
+}
+
+// --- Warm restart ---
+
+Valve::Snapshot Valve::getSnapshot() {
+    Snapshot snapshot;
+    snapshot.elapsedMs = millis() - this->lastToggleTime;
+    snapshot.learnedTravelTime[0] = this->learnedTravelTime[0];
+    snapshot.learnedTravelTime[1] = this->learnedTravelTime[1];
+    snapshot.flowPulses = (this->flowMeter != nullptr) ? this->flowMeter->getPulseCount() - this->flowStartCount : 0;
+    snapshot.flags = (this->isOpen ? SNAPSHOT_OPEN : 0) | (this->vavleInTransition ? SNAPSHOT_MOVING : 0);
+    return snapshot;
+}
+
+void Valve::restoreSnapshot(const Snapshot& snapshot, uint32_t downtimeMs) {
+    unsigned long currentTime = millis();
+    uint32_t elapsed = snapshot.elapsedMs + downtimeMs;
+    if (elapsed < snapshot.elapsedMs || elapsed > 0x7FFFFFFFUL) elapsed = 0x7FFFFFFFUL; // long outage: phase is simply over
+    this->isOpen = (snapshot.flags & SNAPSHOT_OPEN) != 0;
+    this->lastToggleTime = currentTime - elapsed; // update() sees the phase as already running
+    this->learnedTravelTime[0] = snapshot.learnedTravelTime[0];
+    this->learnedTravelTime[1] = snapshot.learnedTravelTime[1];
+    // The meter counts from 0 again: start that many pulses back (mod 2^32), so the volume
+    // dispensed before the reset still counts towards closeAfterMl
+    if (this->flowMeter != nullptr) this->flowStartCount = this->flowMeter->getPulseCount() - snapshot.flowPulses;
+    if (this->isOpen) this->stats.recordOpen(currentTime);
+
+    const bool wasConfigured = this->outputsReady;
+    if (!wasConfigured) configureOutputs(); // LED comes up at the restored level, never LOW first
+
+    if (snapshot.flags & SNAPSHOT_MOVING) {
+        beginMove(this->isOpen, currentTime); // The reset cut the pulse: end position unknown, repeat the move
+    } else if (this->isOpen && this->driveMode == DriveMode::PeakHold) {
+        beginMove(true, currentTime);         // The solenoid dropped out with the reset: pull it in again
+    } else if (wasConfigured && this->valveLEDStatePin != VALVE_NO_PIN) {
+        this->outputs->write(this->valveLEDStatePin, this->isOpen ? HIGH : LOW);
+    }
+}
+
+void Valve::setTransitionHandler(TransitionFn fn, void* ctx) {
+    this->transitionFn = fn;
+    this->transitionCtx = ctx;
+}
+
+void Valve::notifyTransition() {
+    if (this->transitionFn != nullptr) this->transitionFn(this->transitionCtx, *this);
+}
+
+void Valve::openNow(unsigned long currentTime) {
+    beginMove(true, currentTime);
+    if (flowMeter != nullptr) flowStartCount = flowMeter->getPulseCount();
+    isOpen = true;
+    lastToggleTime = currentTime;
+    stats.recordOpen(currentTime);
+    notifyTransition();
+}
+
+void Valve::closeNow(unsigned long currentTime) {
+    beginMove(false, currentTime);
+    isOpen = false;
+    lastToggleTime = currentTime;
+    stats.recordClose(currentTime);
+    notifyTransition();
+}
+
+void Valve::configureOutputs() {
+    if (this->valveOpenPin != VALVE_NO_PIN) this->outputs->configure(this->valveOpenPin);
+    if (this->valveClosePin != VALVE_NO_PIN) this->outputs->configure(this->valveClosePin);
+    if (this->valveLEDStatePin != VALVE_NO_PIN) this->outputs->configure(this->valveLEDStatePin, this->isOpen ? HIGH : LOW); // LED ON = OPEN
+    this->outputsReady = true;
+}
+
+void Valve::beginMove(bool opening, unsigned long currentTime) {
+    if (!this->outputsReady) configureOutputs();
+    uint8_t ledLevel = opening ? HIGH : LOW; // LED ON = OPEN, OFF = CLOSED
+    if (this->driveMode == DriveMode::PeakHold) {
+        // Solenoid: energised for the whole open period, closing is just releasing it
+        this->outputs->writeDuty(this->valveOpenPin, opening ? 255 : 0);
+        if (this->valveLEDStatePin != VALVE_NO_PIN) this->outputs->write(this->valveLEDStatePin, ledLevel);
+        this->holdPending = opening;
+        this->pulseStartTime = currentTime;
+        return;
     }
-}
\ No newline at end of file
+    this->limitAtStart = isLimitActive(opening); // e.g. cold boot with the valve already at the stop
+    startPulse(opening ? this->valveOpenPin : this->valveClosePin, ledLevel, currentTime);
+}
+
+void Valve::startPulse(uint8_t pin, uint8_t ledLevel, unsigned long currentTime) {
+    // Drive pin and LED together: one register store on a FixedGpioOutputDriver
+    if (pin != VALVE_NO_PIN && this->valveLEDStatePin != VALVE_NO_PIN) {
+        this->outputs->writePair(pin, HIGH, this->valveLEDStatePin, ledLevel);
+    } else if (pin != VALVE_NO_PIN) {
+        this->outputs->write(pin, HIGH);
+    } else if (this->valveLEDStatePin != VALVE_NO_PIN) {
+        this->outputs->write(this->valveLEDStatePin, ledLevel);
+    }
+    if (this->hardwarePulse && pin != VALVE_NO_PIN) this->pulseTimer.start(pin, this->valveCycleTime * 1000UL);
+    this->drivePin = pin;
+    this->pulseStartTime = currentTime;
+    this->vavleInTransition = true;
+}
+
+void Valve::servicePulse(unsigned long currentTime) {
+    if (!this->vavleInTransition) return;
+
+    unsigned long elapsed = currentTime - this->pulseStartTime;
+    if (this->hardwarePulse) this->pulseTimer.poll();
+    if (isLimitReached()) {
+        if (this->hardwarePulse) this->pulseTimer.cancel();
+        endPulse(currentTime, true);
+        notifyTransition();
+    } else if (this->hardwarePulse ? this->pulseTimer.consumeCompleted() : (elapsed >= this->valveCycleTime)) {
+        endPulse(currentTime, false); // with the timer, the pin is already low: this only books the result
+        notifyTransition();
+    } else if (this->fault == Fault::None && getTravelBound(isOpen) != 0 && elapsed > getTravelBound(isOpen)) {
+        this->fault = Fault::Slow; // Flag early; keep driving until the limit or valveCycleTime
+    }
+}
+
+void Valve::endPulse(unsigned long currentTime, bool limitReached) {
+    if (this->drivePin != VALVE_NO_PIN) this->outputs->write(this->drivePin, LOW);
+    this->drivePin = VALVE_NO_PIN;
+    this->vavleInTransition = false;
+
+    unsigned long elapsed = currentTime - this->pulseStartTime;
+    this->lastTravelTime = (elapsed > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed;
+
+    uint8_t limitPin = isOpen ? this->openLimitPin : this->closedLimitPin;
+    if (limitPin == VALVE_NO_PIN) return; // Fixed-time pulse, nothing to learn
+
+    if (!limitReached) {
+        this->fault = Fault::Stuck;
+        return;
+    }
+
+    if (this->limitAtStart || this->lastTravelTime < VALVE_MIN_TRAVEL_MS) return; // Not a travel: nothing to learn
+
+    uint16_t bound = getTravelBound(isOpen);
+    uint16_t& learned = this->learnedTravelTime[isOpen ? 1 : 0];
+    uint16_t sample = this->lastTravelTime;
+    if (bound != 0 && sample > bound) {
+        // Flag it, but still learn from the bound: one jump moves the estimate by at most
+        // 1/8, a valve that stays slower is re-learned over a few moves
+        this->fault = Fault::Slow;
+        sample = bound;
+    }
+    if (learned == 0) {
+        learned = sample;
+    } else {
+        learned = (uint16_t)(learned + ((int32_t)sample - (int32_t)learned) / 4); // EWMA, alpha = 1/4
+    }
+}
+
+bool Valve::isLimitReached() const {
+    // isOpen already holds the target state while the pulse is running
+    return isLimitActive(isOpen);
+}
+
+bool Valve::isLimitActive(bool opening) const {
+    uint8_t limitPin = opening ? this->openLimitPin : this->closedLimitPin;
+    if (limitPin == VALVE_NO_PIN) return false;
+    if (this->limitInputs != nullptr) return this->limitInputs->isActive(limitPin);
+    return digitalRead(limitPin) == this->limitActiveLevel;
+}
+
+uint16_t Valve::getTravelBound(bool opening) const {
+    // 150% of the learned travel, 0 while nothing has been learned
+    uint16_t learned = this->learnedTravelTime[opening ? 1 : 0];
+    uint32_t bound = (uint32_t)learned + (learned >> 1);
+    return (bound > 0xFFFF) ? 0xFFFF : (uint16_t)bound;
+}
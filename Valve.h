@@ -1,36 +1,188 @@
 #ifndef VALVE_H
 #define VALVE_H
 #include <Arduino.h>
+#include "OutputDriver.h"
+#include "FlowMeter.h"
+#include "AnalogSensors.h"
+#include "InputScanner.h"
+#include "ValveStats.h"
+#include "PulseTimer.h"
+
+#define VALVE_NO_PIN 0xFF // Marks an optional pin (limit switch, LED...) as not connected
+#define VALVE_MIN_TRAVEL_MS 50 // Shorter limit-terminated pulses are not learned (switch chatter, already at the stop)
 
 class Valve {
+  public:
+    // Compact state for a snapshot that outlives a reset (see WarmState)
+    struct Snapshot {
+        uint32_t elapsedMs;            // Time since the last actuation, i.e. into the current phase
+        uint16_t learnedTravelTime[2]; // [closing, opening] (ms)
+        uint32_t flowPulses;           // Meter pulses since the valve last opened (0 without a meter)
+        uint8_t flags;                 // SNAPSHOT_OPEN | SNAPSHOT_MOVING
+    };
+    static const uint8_t SNAPSHOT_OPEN   = 0x01;
+    static const uint8_t SNAPSHOT_MOVING = 0x02; // A pulse was running when the snapshot was taken
+
+    typedef void (*TransitionFn)(void* ctx, Valve& valve);
+
+    // Travel supervision result, only meaningful when limit switches are fitted
+    enum class Fault : uint8_t {
+      None,  // Travel finished within the learned bound
+      Slow,  // Limit reached, but later than the learned bound
+      Stuck  // Limit never reached within valveCycleTime
+    };
+
+    // How the actuator is driven
+    enum class DriveMode : uint8_t {
+      LatchingPulse, // Motor/latching valve: open or close pin pulsed for the travel time
+      PeakHold       // Solenoid: open pin pulled in at full duty, then held at a reduced PWM duty
+    };
+
   private:
-    uint16_t openTime;    // Time the valve remains open (in milliseconds)
-    uint16_t closedTime;  // Time the valve remains closed (in milliseconds)
-    uint16_t valveCycleTime; // Total cycle time time it takes the valve to open or close (in milliseconds)
-    uint16_t dwellTimeStart; // Start time Millis() for the valve to opening/closing. (in milliseconds)
+    uint32_t openTime;    // Time the valve remains open (in milliseconds)
+    uint32_t closedTime;  // Time the valve remains closed (in milliseconds)
+    uint16_t valveCycleTime; // Maximum time the motor is driven to open or close (in milliseconds)
     bool vavleInTransition; // Flag to indicate if the valve is currently in transition
     unsigned long lastToggleTime; // Last time the valve state was toggled
     bool isOpen;          // Current state of the valve
-    uint8_t valveOpenPin;     // Pin controlling the opening of the valve
-    uint8_t valveClosePin;    // Pin controlling the closing of the valve
-    uint8_t valveLEDStatePin; // Pin for valve state LED ON = OPEN, OFF = CLOSED
+    OutputDriver* outputs;    // Driver owning the open/close/LED channels below
+    uint8_t valveOpenPin;     // Channel controlling the opening of the valve
+    uint8_t valveClosePin;    // Channel controlling the closing of the valve
+    uint8_t valveLEDStatePin; // Channel for valve state LED ON = OPEN, OFF = CLOSED
+    bool outputsReady;        // Channels configured; deferred to the first output access
+
+    // --- End-of-travel feedback (optional) ---
+    uint8_t openLimitPin;      // Input active when the valve is fully open, VALVE_NO_PIN if not fitted
+    uint8_t closedLimitPin;    // Input active when the valve is fully closed, VALVE_NO_PIN if not fitted
+    uint8_t limitActiveLevel;  // Level read on a limit input when the end stop is reached
+    const InputScanner* limitInputs; // Debounced limit states, nullptr = read the pins directly
+    uint8_t drivePin;          // Pin driven by the pulse in progress, VALVE_NO_PIN when idle
+    unsigned long pulseStartTime; // millis() when the pulse in progress started
+    uint16_t learnedTravelTime[2]; // Running travel estimate [closing, opening] (ms), 0 = not learned yet
+    uint16_t lastTravelTime;   // Measured duration of the last completed pulse (ms)
+    bool limitAtStart;         // Target limit was already active when the pulse started: don't learn
+    Fault fault;               // Result of the last supervised travel
+
+    // --- Volume-based closing (optional) ---
+    FlowMeter* flowMeter;      // Meter on this valve's line, nullptr if none
+    uint32_t closeAfterMl;     // Close once this much has passed while open, 0 = time only
+    uint32_t flowStartCount;   // Meter pulse count when the valve was last opened
+
+    // --- Sensor condition (optional) ---
+    const AnalogSensors* sensors;       // Filtered inputs, nullptr if none
+    uint8_t sensorChannel;              // Channel watched by this valve
+    AnalogSensors::Level sensorStopLevel; // Level that closes the valve and holds it closed
+
+    ValveStats stats;          // Rolling runtime statistics, fed at each transition
+
+    // --- Hardware-timed pulse end (direct GPIO only) ---
+    PulseTimer pulseTimer;     // Drops the drive pin after valveCycleTime from timer context
+    bool hardwarePulse;        // Pulse end owned by pulseTimer instead of update()
+
+    // --- Peak-and-hold drive (solenoids) ---
+    DriveMode driveMode;
+    uint16_t pullInTime;       // Full-duty pull-in before dropping to holdDuty (ms)
+    uint8_t holdDuty;          // Hold duty cycle, 0..255
+    bool holdPending;          // Pull-in running, hold duty not applied yet
+
+    bool autoCycle;            // update() toggles on openTime/closedTime; false = manual/sequence control
 
-    valveDelay();
-    valveDelay(unint32_t currentTime);
+    TransitionFn transitionFn; // Told about every move start and pulse end (state snapshots)
+    void* transitionCtx;
+
+    void openNow(unsigned long currentTime);
+    void closeNow(unsigned long currentTime);
+    void beginMove(bool opening, unsigned long currentTime);
+    void configureOutputs();
+
+    void startPulse(uint8_t pin, uint8_t ledLevel, unsigned long currentTime);
+    void servicePulse(unsigned long currentTime);
+    void endPulse(unsigned long currentTime, bool limitReached);
+    bool isLimitReached() const;
+    bool isLimitActive(bool opening) const;
+    void notifyTransition();
+    uint16_t getTravelBound(bool opening) const;
 
   public:
     Valve(uint16_t openTimeMinutes, uint16_t closedTimeMinutes, uint16_t cycleTimeMillis);
     Valve(uint16_t openTimeMinutes, uint16_t closedTimeMinutes, uint16_t cycleTimeMiillis, uint8_t openPin, uint8_t closePin, uint8_t ledPin);
+    // Outputs on a shared driver (shift register / expander); call driver.commit() once per service pass
+    Valve(uint16_t openTimeMinutes, uint16_t closedTimeMinutes, uint16_t cycleTimeMillis, OutputDriver& driver, uint8_t openChannel, uint8_t closeChannel, uint8_t ledChannel);
     ~Valve();
     void update();
     bool getState();
-    unint32_t getCurrentCycleTime();
+    uint32_t getCurrentCycleTime();
+    uint32_t getRemainingTime();   // Seconds until the next scheduled open/close
     void setOpenTime(uint16_t openTimeMinutes);
     void setClosedTime(uint16_t closedTimeMinutes);
     void setCycleTime(uint16_t cycleTime);
     uint16_t getOpenTime();
     uint16_t getClosedTime();
     uint16_t getCycleTime();
+
+    // --- End-of-travel feedback ---
+    void setLimitPins(uint8_t openLimit, uint8_t closedLimit, uint8_t activeLevel = LOW); // VALVE_NO_PIN to skip one
+    // Limits registered with the scanner and read debounced (stop seen 4 scans after contact)
+    void setLimitPins(InputScanner& scanner, uint8_t openLimit, uint8_t closedLimit, bool activeLow = true);
+    bool isInTransition();
+    uint16_t getLearnedTravelTime(bool opening); // 0 until the first limit-terminated pulse
+    uint16_t getLastTravelTime();
+    uint16_t getActuationWindow();  // Expected motor-on time for the next move (ms)
+    Fault getFault();
+    void clearFault();
+
+    // --- Volume-based closing ---
+    void setFlowMeter(FlowMeter* meter, uint32_t closeAfterMillilitres); // closes on volume or openTime, whichever first
+    void setCloseVolume(uint32_t closeAfterMillilitres);
+    uint32_t getCloseVolume();
+    uint32_t getDispensedVolume(); // mL since the valve last opened (0 without a meter)
+
+    // --- Sensor condition ---
+    // While the channel reads stopLevel the valve closes and the next open is held off
+    // (e.g. line pressure High, soil moisture Low = wet). nullptr removes the condition.
+    void setSensorCondition(const AnalogSensors* sensors, uint8_t channel, AnalogSensors::Level stopLevel);
+    bool isSensorStop();
+
+    // --- Runtime statistics ---
+    ValveStats& getStats();
+
+    // --- Hardware-timed pulse end ---
+    bool setHardwarePulseTiming(bool enable); // false if the outputs are not direct GPIO
+    int32_t getLastPulseErrorUs();            // measured - requested width of the last timed pulse
+    uint32_t getMaxPulseErrorUs();
+
+    // --- Drive mode ---
+    void setDriveMode(DriveMode mode, uint16_t pullInMillis = 150, uint8_t holdDutyCycle = 77); // 77/255 ~ 30%
+    DriveMode getDriveMode();
+
+    // --- Manual control ---
+    void setAutoCycle(bool enable); // false: only requestOpen()/requestClose() move the valve
+    bool getAutoCycle();
+    bool requestOpen();             // false while a move is still in progress; true if open or opening
+    bool requestClose();
+
+    // --- Warm restart ---
+    Snapshot getSnapshot();
+    // Resume the phase a snapshot describes, downtime included. Call once the pins, drive
+    // mode and flow meter are set up, before the first update(). Only a move the reset cut short
+    // is driven again (and a solenoid that was held open); an open latching valve is not re-pulsed.
+    // The outputs are first configured here, the LED straight at the restored level.
+    void restoreSnapshot(const Snapshot& snapshot, uint32_t downtimeMs);
+    void setTransitionHandler(TransitionFn fn, void* ctx);
+};
+
+/**
+ * Valve with its pins fixed at compile time. Actuation goes through
+ * FixedGpioOutputDriver: direct GPIO set/clear stores instead of digitalWrite(),
+ * drive pin and LED changed in the same store.
+ */
+template<uint8_t OpenPin, uint8_t ClosePin, uint8_t LedPin = VALVE_NO_PIN>
+class FixedValve : public Valve {
+  public:
+    FixedValve(uint16_t openTimeMinutes, uint16_t closedTimeMinutes, uint16_t cycleTimeMillis)
+        : Valve(openTimeMinutes, closedTimeMinutes, cycleTimeMillis,
+                FixedGpioOutputDriver<OpenPin, ClosePin, LedPin>::instance(), OpenPin, ClosePin, LedPin) {
+    }
 };
 
-#endif // VALVE_H
\ No newline at end of file
+#endif // VALVE_H
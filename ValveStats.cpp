@@ -0,0 +1,103 @@
+#include "ValveStats.h"
+
+// --- transitions ---------------------------------------------------------------
+
+void ValveStats::begin(uint32_t now) {
+  headStartMs    = now;
+  accountedUntil = now;
+}
+
+void ValveStats::recordOpen(uint32_t now) {
+  advance(now);
+  if (open) return;
+  open = true;
+  accountedUntil = now;
+  bucketCycles[head]++;
+  windowCycles++;
+  totalCycles++;
+}
+
+void ValveStats::recordClose(uint32_t now) {
+  advance(now);
+  if (!open) return;
+  creditOpen(now);
+  open = false;
+}
+
+// --- queries -------------------------------------------------------------------
+
+uint32_t ValveStats::getOpenSecondsLast24h(uint32_t now) {
+  advance(now);
+  const uint32_t live = open ? (now - accountedUntil) : 0;
+  return (windowOpenMs + live) / 1000UL;
+}
+
+uint16_t ValveStats::getCyclesLast24h(uint32_t now) {
+  advance(now);
+  return (uint16_t)windowCycles;
+}
+
+uint8_t ValveStats::getDutyPercentLast24h(uint32_t now) {
+  advance(now);
+  const uint32_t span = (uint32_t)(bucketsFilled - 1) * BUCKET_MS + (now - headStartMs);
+  if (!span) return 0;
+  const uint32_t live = open ? (now - accountedUntil) : 0;
+  return (uint8_t)(((uint64_t)(windowOpenMs + live) * 100UL) / span);
+}
+
+uint32_t ValveStats::getTotalOpenMinutes(uint32_t now) {
+  advance(now);
+  const uint32_t live = open ? (now - accountedUntil) : 0;
+  return (uint32_t)((totalOpenMs + live) / 60000UL);
+}
+
+uint32_t ValveStats::getTotalCycles() const { return totalCycles; }
+
+uint8_t ValveStats::getLifetimeDutyPercent(uint32_t now) {
+  advance(now);
+  const uint64_t span = trackedMs + (now - headStartMs);
+  if (!span) return 0;
+  const uint32_t live = open ? (now - accountedUntil) : 0;
+  return (uint8_t)(((totalOpenMs + live) * 100ULL) / span);
+}
+
+// --- bucket maintenance --------------------------------------------------------
+
+void ValveStats::creditOpen(uint32_t until) {
+  const uint32_t ms = until - accountedUntil;
+  bucketOpenMs[head] += ms;
+  windowOpenMs       += ms;
+  totalOpenMs        += ms;
+  accountedUntil      = until;
+}
+
+void ValveStats::advance(uint32_t now) {
+  if (now - headStartMs < BUCKET_MS) return; // the common case: still inside the head bucket
+
+  uint32_t missed = (now - headStartMs) / BUCKET_MS;
+  if (missed > BUCKET_COUNT) {
+    // Hours older than the window only matter for the lifetime totals; book them in one go
+    const uint32_t skipTo = headStartMs + (missed - BUCKET_COUNT) * BUCKET_MS;
+    if (open) {
+      totalOpenMs   += skipTo - accountedUntil;
+      accountedUntil = skipTo;
+    }
+    trackedMs  += skipTo - headStartMs;
+    headStartMs = skipTo;
+    missed      = BUCKET_COUNT;
+  }
+
+  while (missed--) {
+    const uint32_t boundary = headStartMs + BUCKET_MS;
+    if (open) creditOpen(boundary);      // split a long open period at the hour mark
+    trackedMs  += BUCKET_MS;
+    headStartMs = boundary;
+
+    head = (head + 1) % BUCKET_COUNT;
+    windowOpenMs -= bucketOpenMs[head];  // oldest hour leaves the window
+    windowCycles -= bucketCycles[head];
+    bucketOpenMs[head] = 0;
+    bucketCycles[head] = 0;
+    if (bucketsFilled < BUCKET_COUNT) bucketsFilled++;
+  }
+}
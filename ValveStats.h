@@ -0,0 +1,51 @@
+#ifndef VALVE_STATS_H
+#define VALVE_STATS_H
+
+#include <Arduino.h>
+
+/**
+ * Rolling runtime statistics for one valve.
+ * - Updated only at open/close transitions (plus an O(1) bucket-boundary check).
+ * - Last-24h figures come from 24 hourly buckets with a running window sum,
+ *   so every query is a handful of additions, never a history scan.
+ * - "Last 24 h" is the 23 full hours before the head bucket plus the current partial
+ *   hour, so the window spans 23-24 h and an hour drops out whole at each boundary.
+ * - A running open period is credited live; nothing has to be closed to be counted.
+ */
+class ValveStats {
+public:
+  static const uint8_t  BUCKET_COUNT = 24;
+  static const uint32_t BUCKET_MS    = 3600000UL; // 1 hour
+
+  void begin(uint32_t now);
+  void recordOpen(uint32_t now);
+  void recordClose(uint32_t now);
+
+  // Queries (now = millis()); each one rolls expired buckets out first
+  uint32_t getOpenSecondsLast24h(uint32_t now);
+  uint16_t getCyclesLast24h(uint32_t now);
+  uint8_t  getDutyPercentLast24h(uint32_t now);
+  uint32_t getTotalOpenMinutes(uint32_t now);
+  uint32_t getTotalCycles() const;
+  uint8_t  getLifetimeDutyPercent(uint32_t now);
+
+private:
+  void advance(uint32_t now);     // roll buckets up to now
+  void creditOpen(uint32_t until); // book open time since accountedUntil into the head bucket
+
+  uint32_t bucketOpenMs[BUCKET_COUNT] = {0};
+  uint16_t bucketCycles[BUCKET_COUNT] = {0};
+  uint8_t  head          = 0;     // bucket currently being filled
+  uint32_t headStartMs   = 0;
+  uint32_t windowOpenMs  = 0;     // sum of bucketOpenMs[]
+  uint32_t windowCycles  = 0;     // sum of bucketCycles[]
+  uint8_t  bucketsFilled = 1;     // buckets covering tracked time (<= BUCKET_COUNT)
+
+  bool     open           = false;
+  uint32_t accountedUntil = 0;    // open time before this instant is already booked
+  uint64_t totalOpenMs    = 0;
+  uint64_t trackedMs      = 0;    // time covered by closed buckets (lifetime duty)
+  uint32_t totalCycles    = 0;
+};
+
+#endif // VALVE_STATS_H
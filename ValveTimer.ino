@@ -1,7 +1,12 @@
 
 #include "MENU.h"
 #include <Valve.h>
-#include <ezButton.h>
+#include "InputScanner.h"
+#include "Scheduler.h"
+#include "Sequence.h"
+#include "MemoryMonitor.h"
+#include "WarmState.h"
+#include "TrendStore.h"
 
 #define VALVE2_OPEN_PIN 13
 #define VALVE2_CLOSE_PIN 12
@@ -15,14 +20,17 @@
 #define OLED_ADDR 0x3C
 #define SDA_PIN 21
 #define SCL_PIN 22
-#define BUTTON_DEBOUNCE_TIME 50
+#define BUTTON_DEBOUNCE_TIME 50 // ms
+#define INPUT_SCAN_PERIOD_US (BUTTON_DEBOUNCE_TIME * 1000UL / 4) // a change must hold for 4 scans
 
-Menu mainMenu(128, 64, -1, 0x3C, 21, 22, false);
+// 128x64, 3 rows x 2 columns, no status bar, pre-rendered neighbour pages: every buffer is static
+FixedMenu<128, 64, 3, 2, false, true> mainMenu(-1, 0x3C, 21, 22);
+// Faster panel writes: IDF I2C driver at 1 MHz, each flushed window in one transaction
+//IdfI2cDisplayTransport displayBus(SDA_PIN, SCL_PIN, 1000000);
 
 
-ezButton btnSelect(BUTTON_1);
-ezButton btnEnter(BUTTON_2);
-ezButton btnMinus(BUTTON_3);
+// Buttons (and limit switches, when fitted) debounced together: one GPIO register read per bank
+InputScanner inputs;
 
 uint8_t stateValve2Open = LOW;
 uint8_t stateValve2Close = LOW;
@@ -36,16 +44,86 @@ uint16_t valveDelay = 3500; // Delay for valve operation in milliseconds
 uint16_t valveOpenTime = 18; // Time to keep valve open in minutes
 uint16_t valveClosedTime = 5; // Time to keep valve closed in minutes
 
-Valve valve(valveOpenTime, valveClosedTime, valveDelay, VALVE_OPEN_PIN, VALVE_CLOSE_PIN, VALVE_LED_PIN);
-Valve valve2(valveOpenTime, valveClosedTime, valveDelay, VALVE2_OPEN_PIN, VALVE2_CLOSE_PIN, VALVE2_LED_PIN);
+// Pins fixed at compile time: each toggle is a direct GPIO register store (drive pin + LED together)
+FixedValve<VALVE_OPEN_PIN, VALVE_CLOSE_PIN, VALVE_LED_PIN> valve(valveOpenTime, valveClosedTime, valveDelay);
+FixedValve<VALVE2_OPEN_PIN, VALVE2_CLOSE_PIN, VALVE2_LED_PIN> valve2(valveOpenTime, valveClosedTime, valveDelay);
+// Pins chosen at runtime (digitalWrite path):
+//Valve valve(valveOpenTime, valveClosedTime, valveDelay, VALVE_OPEN_PIN, VALVE_CLOSE_PIN, VALVE_LED_PIN);
+// Larger installs: put the valves on a 74HC595 chain (3 channels each) and commit once per loop
+//ShiftRegisterDriver valveOutputs(23, 18, 5, 3);  // data, clock, latch, chips
+//Valve valve3(valveOpenTime, valveClosedTime, valveDelay, valveOutputs, 0, 1, 2);
+// Volume-based closing: hall-effect meter on the main line
+//FlowMeter flowMeter(FLOW_METER_PIN, 450); // pulses per litre
+// Sensor conditions: ADC sampled by DMA, median + IIR filtered, thresholds in mV with hysteresis
+//AnalogSensors sensors;
+//int8_t soilChannel = sensors.addChannel(SOIL_SENSOR_PIN, 1300, 1600); // capacitive probe: lower = wetter
 
 uint8_t menuItem = 0;
+
+// Status page: live countdown and state per valve, redrawn only when the text changes
+uint32_t valveRemaining(void* v) { return static_cast<Valve*>(v)->getRemainingTime(); }
+bool valveIsOpen(void* v)        { return static_cast<Valve*>(v)->getState(); }
+
+CountdownWidget valve1Countdown(0, 16, 12, "V1 next", valveRemaining, &valve);
+IndicatorWidget valve1State(78, 16, 8, "", valveIsOpen, &valve, "OPEN", "CLOSED");
+CountdownWidget valve2Countdown(0, 24, 12, "V2 next", valveRemaining, &valve2);
+IndicatorWidget valve2State(78, 24, 8, "", valveIsOpen, &valve2, "OPEN", "CLOSED");
+MenuWidget* const statusWidgets[] = { &valve1Countdown, &valve1State, &valve2Countdown, &valve2State };
+bool showingStatus = false; // a widget page (status or diagnostics) is up
+
+// Diagnostics page: heap, fragmentation, loop stack and what the menu holds
+MemoryMonitor memory;
+WarmState warmState;                   // valve phases + menu position across warm resets
+int32_t heapFreeKb(void*)     { return memory.getFreeHeap() / 1024; }
+int32_t heapMinFreeKb(void*)  { return memory.getMinFreeHeap() / 1024; }
+int32_t heapLargestKb(void*)  { return memory.getLargestFreeBlock() / 1024; }
+int32_t heapFragPercent(void*) { return memory.getFragmentationPercent(); }
+int32_t loopStackFree(void*)  { return memory.getStackFreeMin(0); } // "loop" is registered first
+int32_t menuBytes(void*)      { return mainMenu.getMemoryUsage().total(); }
+
+NumberWidget diagHeapFree(0, 16, 21, "Heap free", heapFreeKb, nullptr, " KB");
+NumberWidget diagHeapMin(0, 24, 21, "Heap min", heapMinFreeKb, nullptr, " KB");
+NumberWidget diagHeapLargest(0, 32, 21, "Largest blk", heapLargestKb, nullptr, " KB");
+NumberWidget diagHeapFrag(0, 40, 21, "Fragmented", heapFragPercent, nullptr, "%");
+NumberWidget diagLoopStack(0, 48, 21, "Loop stack", loopStackFree, nullptr, " B free");
+NumberWidget diagMenu(0, 56, 21, "Menu", menuBytes, nullptr, " B");
+MenuWidget* const diagWidgets[] = { &diagHeapFree, &diagHeapMin, &diagHeapLargest, &diagHeapFrag, &diagLoopStack, &diagMenu };
+
+// Trend page: valve duty sampled every 10 s (open = 100 %), rolled up into minute/hour/day buckets
+#define TREND_SAMPLE_PERIOD_US 10000000UL
+#define TREND_DUTY_FRAC 7                   // Q7: 100 % = 12800
+#define TREND_DUTY_FULL (100 << TREND_DUTY_FRAC)
+TrendStore valve1Duty(TREND_DUTY_FRAC);
+TrendStore valve2Duty(TREND_DUTY_FRAC);
+int32_t dutyThisHour(void* store) {
+  return static_cast<TrendStore*>(store)->getOpen(TrendStore::Tier::Hour).mean >> TREND_DUTY_FRAC;
+}
+
+NumberWidget    trendV1Hour(0, 16, 21, "V1 duty this hr", dutyThisHour, &valve1Duty, "%");
+SparklineWidget trendV1Minutes(0, 24, 60, 15, valve1Duty, TrendStore::Tier::Minute, 0, TREND_DUTY_FULL); // last hour
+SparklineWidget trendV1Hours(68, 24, 48, 15, valve1Duty, TrendStore::Tier::Hour, 0, TREND_DUTY_FULL);    // last 2 days
+NumberWidget    trendV2Hour(0, 40, 21, "V2 duty this hr", dutyThisHour, &valve2Duty, "%");
+SparklineWidget trendV2Minutes(0, 48, 60, 15, valve2Duty, TrendStore::Tier::Minute, 0, TREND_DUTY_FULL);
+SparklineWidget trendV2Hours(68, 48, 48, 15, valve2Duty, TrendStore::Tier::Hour, 0, TREND_DUTY_FULL);
+MenuWidget* const trendWidgets[] = { &trendV1Hour, &trendV1Minutes, &trendV1Hours, &trendV2Hour, &trendV2Minutes, &trendV2Hours };
+
+// Per-subsystem footprints for the memory report
+uint32_t menuCanvasFootprint(void*) {
+  Menu::MemoryUsage m = mainMenu.getMemoryUsage();
+  return m.frameBuffer + m.canvases + m.snapshot + m.prerender;
+}
+uint32_t menuDataFootprint(void*) {
+  Menu::MemoryUsage m = mainMenu.getMemoryUsage();
+  return m.items + m.marquee + m.object;
+}
 // Menu items
 const char* items[] = {
   "Device Status",
   "Adjust time",
   "Open Valve",
-  "Close Valve"
+  "Close Valve",
+  "Diagnostics",
+  "Trends"
 };
   const char* adjustTime[] = {
   "Add 1 minute",
@@ -53,16 +131,29 @@ const char* items[] = {
   "Return to Main Menu"
 };
 
+// Runtime statistics for one valve; every figure is a few counter reads
+void printValveStats(const char* name, Valve& v) {
+  ValveStats& st = v.getStats();
+  uint32_t now = millis();
+  Serial.print(name);
+  Serial.print(F(": duty24h="));    Serial.print(st.getDutyPercentLast24h(now));
+  Serial.print(F("% open24h="));    Serial.print(st.getOpenSecondsLast24h(now) / 60);
+  Serial.print(F("min cycles24h=")); Serial.print(st.getCyclesLast24h(now));
+  Serial.print(F(" totalOpen="));   Serial.print(st.getTotalOpenMinutes(now) / 60);
+  Serial.print(F("h cycles="));     Serial.print(st.getTotalCycles());
+  Serial.print(F(" pulseErrMax="));  Serial.print(v.getMaxPulseErrorUs());
+  Serial.println(F("us"));
+}
 
 function adjustTime() {
   mainMenu.setMenuSubtitle("Open Time: " + String(valveOpenTime) + " mins, Closed Time: " + String(valveClosedTime) + " mins.");
   // Update display with Time adustment on the bottom screen.
-  mainMenu.setMenuItems(adjustTime, sizeof(adjustTime)/sizeof(adjustTime[0]));
+  mainMenu.borrowMenuItems(adjustTime, sizeof(adjustTime)/sizeof(adjustTime[0]));
   mainMenu.setCurrentItemIndex(0);
-  if (btnSelect.isPressed()){
+  if (inputs.pressed(BUTTON_1)){
     mainMenu.nextItem();
   }
-  if (btnEnter.isPressed()){
+  if (inputs.pressed(BUTTON_2)){
     menuItem = mainMenu.getCurrentItemIndex();
     if (menuItem == 0) { // Add 1 minute
       valveOpenTime += 1; // Increase open time by 1 minute
@@ -77,29 +168,76 @@ function adjustTime() {
       mainMenu.setMenuSubtitle("Open Time: " + String(valveOpenTime) + " mins, Closed Time: " + String(valveClosedTime) + " mins.");
     }
     if (menuItem == 2) { // Return to Main Menu
-      mainMenu.setMenuItems(items, sizeof(items)/sizeof(items[0]));
+      mainMenu.borrowMenuItems(items, sizeof(items)/sizeof(items[0]));
       mainMenu.setMenuSubtitle("Valve Countdown.");
       mainMenu.setCurrentItemIndex(0);
     }
   }
 }
 
+#if SEQUENCE_HAS_COROUTINES
+// Irrigation program: zone 1 then zone 2, each for its open time, then both stay closed.
+// Valves driven by a sequence need setAutoCycle(false) so update() leaves them alone.
+SequenceExecutor sequences;
+
+Sequence zoneProgram(Valve& zone1, Valve& zone2) {
+  using namespace std::chrono_literals;
+  co_await seq::open(zone1);
+  co_await seq::sleep_for(std::chrono::minutes(valveOpenTime));
+  co_await seq::close(zone1);
+  co_await seq::sleep_for(2s); // let line pressure settle before the next zone
+  co_await seq::open(zone2);
+  co_await seq::sleep_for(std::chrono::minutes(valveOpenTime));
+  co_await seq::close(zone2);
+}
+
+void serviceSequences(void*) {
+  sequences.run();
+}
+#endif
+
+// --- Cooperative scheduler: priority, period and budget per subsystem ---
+Scheduler scheduler;
+int8_t uiTask    = -1;
+int8_t flushTask = -1;
+#define FLUSH_PAGES_PER_SLICE 2 // ~128 bytes per page; a full frame goes out over 4 slices
+
 void setup() {
   Serial.begin(115200);
   
+  // End the valve pulses from a hardware timer instead of waiting for loop()
+  valve.setHardwarePulseTiming(true);
+  valve2.setHardwarePulseTiming(true);
+  // Solenoid variant: 150 ms full-duty pull-in, then ~30% PWM hold for the open period
+  //valve2.setDriveMode(Valve::DriveMode::PeakHold, 150, 77);
+
+  // Optional end-of-travel switches: pulse is cut at the stop and travel time is learned
+  //valve.setLimitPins(inputs, VALVE_OPEN_LIMIT_PIN, VALVE_CLOSED_LIMIT_PIN); // debounced with the buttons
+  //flowMeter.begin();
+  //valve.setFlowMeter(&flowMeter, 20000); // close after 20 L or valveOpenTime
+  //sensors.begin();                                                          // 2 kHz per channel
+  //valve.setSensorCondition(&sensors, soilChannel, AnalogSensors::Level::Low); // wet soil: close, skip the next run
+
+  // Warm restart (brownout, watchdog, deep sleep): valves resume their phase from RTC memory
+  // before the display init, so control is back within milliseconds of boot
+  warmState.track(valve);
+  warmState.track(valve2);
+  const bool warmStart = warmState.restore();
+  warmState.printReport(Serial);
+
+  //mainMenu.setDisplayTransport(&displayBus); // falls back to Wire if the driver is unavailable
   mainMenu.initializeDisplay();
 
-  btnSelect.setDebounceTime(BUTTON_DEBOUNCE_TIME); // set debounce time to 50 milliseconds
-  btnEnter.setDebounceTime(BUTTON_DEBOUNCE_TIME); // set debounce time to 50 milliseconds
-  btnMinus.setDebounceTime(BUTTON_DEBOUNCE_TIME); // set debounce time to 50 milliseconds
+  inputs.addInput(BUTTON_1); // active low, internal pull-up
+  inputs.addInput(BUTTON_2);
+  inputs.addInput(BUTTON_3);
 
-  mainMenu.setMenuItems(items, sizeof(items)/sizeof(items[0]));
+  mainMenu.borrowMenuItems(items, sizeof(items)/sizeof(items[0]));   // global table: borrowed, not copied
+  if (warmStart) mainMenu.setCurrentItemIndex(warmState.getMenuIndex());
   mainMenu.setMenuTitle("Valve Timer", 1);
   mainMenu.setMenuSubtitle("Valve Countdown.", 1);
 
-  // Layout
-  mainMenu.setMenuColumns(2);            // 2 columns
-  mainMenu.setMenuRows(3);               // 3 rows per column -> 6 items/page
+  // Layout (2 columns x 3 rows fixed by the FixedMenu type)
   mainMenu.setColumnNumberOfCharacters(14);
   mainMenu.setMenuItemScrolling(true);
 
@@ -116,28 +254,108 @@ void setup() {
 
   // Page transition: slide (left/right)
   mainMenu.setPageTransition(Menu::TransitionType::Slide, 280);
+  mainMenu.setPrerenderEnabled(true);   // neighbour pages drawn in idle frames (static 1.5 KB): page change starts at once
   // To try fade instead:
   // mainMenu.setPageTransition(Menu::TransitionType::Fade, 300);
+  // Panel-driven: contrast fade through blank (no frame-buffer traffic except the page swap)
+  // mainMenu.setPageTransition(Menu::TransitionType::ContrastFade, 400);
+  // Hardware ticker for a lone long row (single-column layouts only)
+  // mainMenu.setHardwareScrollEnabled(true);
+
+  // Idle blanking: dim after 30 s, panel off after 2 min; a button press wakes it at once
+  mainMenu.setIdleTimeouts(30000, 120000);
 
   mainMenu.showMenu();
+
+  //                 name      fn             ctx      prio period  budget  deferrable
+  scheduler.addTask("valves", serviceValves, nullptr, 0,   10000,  300);
+  scheduler.addTask("input",  serviceInput,  nullptr, 1,   INPUT_SCAN_PERIOD_US, 300);
+  uiTask =
+  scheduler.addTask("ui",     serviceUi,     nullptr, 2,   20000,  4000);
+  flushTask =
+  scheduler.addTask("flush",  serviceFlush,  nullptr, 3,   20000,  6000,   true);
+  scheduler.addTask("serial", serviceSerial, nullptr, 4,   50000,  2000,   true);
+  scheduler.addTask("trend",  serviceTrends, nullptr, 5,   TREND_SAMPLE_PERIOD_US, 200, true);
+  valve1Duty.begin(millis());
+  valve2Duty.begin(millis());
+
+  // Memory report: what each part holds, heap health, stack headroom
+  memory.addSubsystem("menu canvases", menuCanvasFootprint, nullptr);
+  memory.addSubsystem("menu data",     menuDataFootprint,   nullptr);
+  memory.addSubsystem("valves",        sizeof(valve) + sizeof(valve2)); // state + 24 h stats buckets
+  memory.addSubsystem("scheduler",     sizeof(scheduler));
+  memory.addSubsystem("sequences",     SEQUENCE_MAX_FRAMES * SEQUENCE_FRAME_BYTES);
+  memory.addSubsystem("trends",        sizeof(valve1Duty) + sizeof(valve2Duty));
+  memory.addTask("loop");              // setup() runs on the loop task; so do all scheduler tasks
+  memory.addTaskByName("esp_timer");   // valve pulse-end callbacks
+#if SEQUENCE_HAS_COROUTINES
+  scheduler.addTask("seq",    serviceSequences, nullptr, 0,   100000, 200);
+  // Run the zone program instead of the fixed open/closed cycle:
+  //valve.setAutoCycle(false);
+  //valve2.setAutoCycle(false);
+  //sequences.start(zoneProgram(valve, valve2));
+#endif
 }
 
 uint32_t lastNav = 0;
 bool goForward = true;
 
-void loop() {
-  // Drive animations
+void serviceValves(void*) {
+  //sensors.service();     // filtered levels published before the valves look at them
+  valve.update();
+  valve2.update();
+  //valveOutputs.commit(); // one SPI burst for every output changed above
+  //flowMeter.service();    // flow-rate estimate; counting itself runs in hardware
+}
+
+void serviceInput(void*) {
+  inputs.scan(); // edges below are from this scan
+  handleButtons();
+  // Render what the press changed on the next pass instead of up to a frame later
+  if (inputs.pressed(BUTTON_1) || inputs.pressed(BUTTON_2) || inputs.pressed(BUTTON_3)) scheduler.wake(uiTask);
+}
+
+void serviceUi(void*) {
+  // Drive animations and render into the frame buffer; the flush task sends it
   mainMenu.tick();
-  mainMenu.refreshMenu();
+  mainMenu.renderMenu();
+  warmState.setMenuIndex(mainMenu.getCurrentItemIndex()); // saves only when it changed
+  scheduler.wake(flushTask); // off-period renders (after a press) go out right away too
+}
 
-  // setup the buttons
-  btnSelect.loop();
-  btnEnter.loop();
-  btnMinus.loop();
+void serviceFlush(void*) {
+  if (!mainMenu.flushDisplay(FLUSH_PAGES_PER_SLICE)) scheduler.wake(flushTask); // rest on the next pass
+}
 
-  valve.update();
-  valve2.update();
-  
+void serviceTrends(void*) {
+  const uint32_t now = millis();
+  valve1Duty.add(valve.getState()  ? TREND_DUTY_FULL : 0, now);
+  valve2Duty.add(valve2.getState() ? TREND_DUTY_FULL : 0, now);
+}
+
+void serviceSerial(void*) {
+  // Serial diagnostics: 's' = render stats, 'p' = dump current frame as PBM, 't' = task stats, 'm' = memory,
+  // 'w' = warm-restart state, 'd' = trend dump (CSV)
+  if (Serial.available()) {
+    char cmd = Serial.read();
+    if (cmd == 's') mainMenu.printRenderStats(Serial);
+    if (cmd == 'p') mainMenu.dumpFramePBM(Serial);
+    if (cmd == 't') scheduler.printStats(Serial);
+    if (cmd == 'm') { memory.printReport(Serial); mainMenu.printMemoryUsage(Serial); }
+    if (cmd == 'w') warmState.printReport(Serial);
+    if (cmd == 'd') { valve1Duty.printCsv(Serial); valve2Duty.printCsv(Serial); }
+  }
+}
+
+void loop() {
+  scheduler.run();
+
+  // Panel off: nothing animates or flushes, so give the wait for the next task back to
+  // FreeRTOS (idle task; automatic light sleep when power management is enabled)
+  if (mainMenu.isDisplayAsleep()) {
+    const uint32_t idleMs = scheduler.getIdleUs() / 1000;
+    if (idleMs) delay(idleMs);
+  }
 
   // Demo: change selection every 900ms
   /*if (millis() - lastNav > 2000) {
@@ -147,15 +365,35 @@ void loop() {
     // Toggle direction occasionally
     if ((mainMenu.getCurrentItemIndex() % 12) == 0) goForward = !goForward;
   }*/
-  if (btnSelect.isPressed()){
+}
+
+void handleButtons() {
+  if (inputs.pressed(BUTTON_1) || inputs.pressed(BUTTON_2) || inputs.pressed(BUTTON_3)) {
+    if (mainMenu.wakeDisplay()) return; // first press on a blank panel only wakes it
+  }
+  if (showingStatus) {
+    // Any button leaves the live status/diagnostics page
+    if (inputs.pressed(BUTTON_1) || inputs.pressed(BUTTON_2) || inputs.pressed(BUTTON_3)) {
+      showingStatus = false;
+      mainMenu.clearWidgets();
+      mainMenu.setMenuSubtitle("Valve Countdown.");
+    }
+    return;
+  }
+  if (inputs.pressed(BUTTON_1)){
     mainMenu.nextItem();
   }
-  if (btnEnter.isPressed()){
+  if (inputs.pressed(BUTTON_2)){
     menuItem = mainMenu.getCurrentItemIndex();
     mainMenu.setMenuSubtitle("Menu Item Selected: " +  mainMenu.getCurrentItemS() + ".");
     
     if (menuItem == 0) { // Device Status
-      mainMenu.setMenuSubtitle("Valve Open Time: " + String(valveOpenTime) + " mins, Closed Time: " + String(valveClosedTime) + " mins.");
+      mainMenu.setMenuSubtitle("Valve Open Time: " + String(valveOpenTime) + " mins, Closed Time: " + String(valveClosedTime) + " mins."
+                               + " Duty 24h: " + String(valve.getStats().getDutyPercentLast24h(millis())) + "%.");
+      printValveStats("Valve 1", valve);
+      printValveStats("Valve 2", valve2);
+      mainMenu.setWidgets(statusWidgets, sizeof(statusWidgets)/sizeof(statusWidgets[0]));
+      showingStatus = true;
     }
     if (menuItem == 1) { // Adjust Time
       // Simulate time adjustment
@@ -165,20 +403,27 @@ void loop() {
 
     }
     if (menuItem == 2) { // Open Valve
-      digitalWrite(VALVE_OPEN_PIN, HIGH);
-      delay(valveDelay);
-      digitalWrite(VALVE_OPEN_PIN, LOW);
-      mainMenu.setMenuSubtitle("Valve Opened.");
+      // Non-blocking: the pulse is ended by the valve itself, the menu keeps running
+      mainMenu.setMenuSubtitle(valve.requestOpen() ? "Valve Opened." : "Valve busy, try again.");
     }
     if (menuItem == 3) { // Close Valve
-      digitalWrite(VALVE_CLOSE_PIN, HIGH);
-      delay(valveDelay);
-      digitalWrite(VALVE_CLOSE_PIN, LOW);
-      mainMenu.setMenuSubtitle("Valve Closed.");
+      mainMenu.setMenuSubtitle(valve.requestClose() ? "Valve Closed." : "Valve busy, try again.");
+    }
+    if (menuItem == 4) { // Diagnostics
+      mainMenu.setMenuSubtitle("Memory.");
+      memory.printReport(Serial);
+      mainMenu.printMemoryUsage(Serial);
+      mainMenu.setWidgets(diagWidgets, sizeof(diagWidgets)/sizeof(diagWidgets[0]));
+      showingStatus = true;
+    }
+    if (menuItem == 5) { // Trends
+      mainMenu.setMenuSubtitle("Duty: 60 min | 48 h.");
+      mainMenu.setWidgets(trendWidgets, sizeof(trendWidgets)/sizeof(trendWidgets[0]));
+      showingStatus = true;
     }
 
   }
-  if (btnMinus.isPressed()) {
+  if (inputs.pressed(BUTTON_3)) {
     mainMenu.previousItem();
   }
 }
@@ -0,0 +1,128 @@
+#include "WarmState.h"
+#include <stddef.h>
+#include <sys/time.h>
+
+#if WARM_STATE_RTC
+  #include <esp_attr.h>
+  RTC_NOINIT_ATTR WarmState::Block WarmState::block;
+#else
+  #include <stdio.h>
+  WarmState::Block WarmState::block;
+#endif
+
+#define WARM_STATE_LAYOUT 2         // bump when Block or Valve::Snapshot changes
+#define WARM_STATE_MAGIC  (0x57520000UL | (WARM_STATE_LAYOUT << 8) | WARM_STATE_MAX_VALVES) // "WR" + layout
+
+// --- setup -------------------------------------------------------------------
+
+bool WarmState::track(Valve& valve) {
+  if (valveCount >= WARM_STATE_MAX_VALVES) return false;
+  valves[valveCount++] = &valve;
+  valve.setTransitionHandler(&WarmState::onTransition, this);
+  return true;
+}
+
+bool WarmState::restore() {
+#if !WARM_STATE_RTC
+  if (FILE* f = fopen(WARM_STATE_FILE, "rb")) {
+    if (fread(&block, sizeof(block), 1, f) != 1) block.magic = 0;
+    fclose(f);
+  } else {
+    block.magic = 0;
+  }
+#endif
+  warm = isValid() && block.valveCount == valveCount;
+  downtimeMs = 0;
+  if (warm) {
+    const uint64_t now = clockUs();
+    if (now > block.savedAtUs) {
+      const uint64_t ms = (now - block.savedAtUs) / 1000;
+      downtimeMs = (ms > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t)ms;
+    }
+    for (uint8_t i = 0; i < valveCount; ++i) valves[i]->restoreSnapshot(block.valves[i], downtimeMs);
+  } else {
+    block.menuIndex = 0;
+    block.saves     = 0;
+  }
+  restored = true;
+  save();                               // the block now describes this boot either way
+  restoreMs = millis();
+  return warm;
+}
+
+void WarmState::setMenuIndex(uint16_t index) {
+  if (restored && index == block.menuIndex) return;
+  block.menuIndex = index;
+  save();
+}
+
+void WarmState::invalidate() {
+  block.magic = 0;
+  block.crc   = 0;
+  restored    = false;                  // no further saves until the next restore()
+#if !WARM_STATE_RTC
+  remove(WARM_STATE_FILE);
+#endif
+}
+
+// --- saving ------------------------------------------------------------------
+
+void WarmState::onTransition(void* ctx, Valve&) {
+  static_cast<WarmState*>(ctx)->save();
+}
+
+void WarmState::save() {
+  if (!restored) return;
+  block.magic      = WARM_STATE_MAGIC;
+  block.valveCount = valveCount;
+  block.saves++;
+  block.savedAtUs  = clockUs();
+  for (uint8_t i = 0; i < valveCount; ++i) block.valves[i] = valves[i]->getSnapshot();
+  block.crc = crc32(reinterpret_cast<const uint8_t*>(&block), offsetof(Block, crc));
+#if !WARM_STATE_RTC
+  if (FILE* f = fopen(WARM_STATE_FILE, "wb")) {
+    fwrite(&block, sizeof(block), 1, f);
+    fclose(f);
+  }
+#endif
+}
+
+bool WarmState::isValid() const {
+  return block.magic == WARM_STATE_MAGIC && block.valveCount <= WARM_STATE_MAX_VALVES &&
+         block.crc == crc32(reinterpret_cast<const uint8_t*>(&block), offsetof(Block, crc));
+}
+
+uint64_t WarmState::clockUs() {
+  // ESP-IDF keeps system time in the RTC timer across software resets and deep sleep;
+  // after a power-on it starts again at 0, which restore() reads as unknown downtime
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+}
+
+uint32_t WarmState::crc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFFUL;
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+  }
+  return ~crc;
+}
+
+// --- results -----------------------------------------------------------------
+
+bool     WarmState::isWarm()        const { return warm; }
+uint16_t WarmState::getMenuIndex()  const { return block.menuIndex; }
+uint32_t WarmState::getDowntimeMs() const { return downtimeMs; }
+uint32_t WarmState::getRestoreMs()  const { return restoreMs; }
+uint32_t WarmState::getSaveCount()  const { return block.saves; }
+
+void WarmState::printReport(Print& out) const {
+  out.print(warm ? F("warm start") : F("cold start"));
+  out.print(F(": downtime="));  out.print(downtimeMs);
+  out.print(F(" ms, control at ")); out.print(restoreMs);
+  out.print(F(" ms, menu="));   out.print(block.menuIndex);
+  out.print(F(", saves="));     out.print(block.saves);
+  out.print(F(", block="));     out.print((uint32_t)sizeof(Block));
+  out.println(F(" B"));
+}
@@ -0,0 +1,71 @@
+#ifndef WARM_STATE_H
+#define WARM_STATE_H
+
+#include <Arduino.h>
+#include "Valve.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+  #define WARM_STATE_RTC 1          // block in RTC slow memory (RTC_NOINIT_ATTR)
+#else
+  #define WARM_STATE_RTC 0          // block mirrored to WARM_STATE_FILE
+#endif
+
+#define WARM_STATE_MAX_VALVES 4
+#define WARM_STATE_FILE       "warmstate.bin" // host builds only
+
+/**
+ * Valve phases and menu position carried across a warm restart (brownout, watchdog, deep sleep).
+ * - One small block in RTC slow memory, which the boot code leaves alone; a layout magic and
+ *   a CRC-32 tell a valid snapshot from power-on garbage or another firmware's block.
+ * - Tracked valves save at every transition (move start, pulse end), the sketch saves the menu
+ *   position when it changes. A save is a ~100-byte copy plus CRC: no flash wear, no bus traffic.
+ * - Metered volume is as fresh as the last save: call save() every few seconds while a valve
+ *   with a flow meter is open.
+ * - restore() in setup(), before the first valve update(): each valve resumes its phase with
+ *   the downtime credited (when the clock kept running), so no cycle restarts and an open
+ *   latching valve is not pulsed again.
+ * - Host builds keep the block in WARM_STATE_FILE instead.
+ */
+class WarmState {
+public:
+  bool track(Valve& valve);             // slot = call order; false when full
+  bool restore();                       // false = cold start: valves keep their defaults
+  void setMenuIndex(uint16_t index);
+  void save();                          // snapshot every tracked valve, seal, persist
+  void invalidate();                    // the next boot starts cold
+
+  bool     isWarm() const;              // the last restore() found a valid block
+  uint16_t getMenuIndex() const;
+  uint32_t getDowntimeMs() const;       // last save -> restore, 0 if the clock did not survive
+  uint32_t getRestoreMs() const;        // millis() when restore() returned: boot-to-control
+  uint32_t getSaveCount() const;        // saves since the last cold start
+
+  void printReport(Print& out) const;
+
+private:
+  struct Block {
+    uint32_t        magic;
+    uint8_t         valveCount;
+    uint16_t        menuIndex;
+    uint32_t        saves;
+    uint64_t        savedAtUs;          // clockUs() at the last save
+    Valve::Snapshot valves[WARM_STATE_MAX_VALVES];
+    uint32_t        crc;                // over everything above
+  };
+
+  bool isValid() const;
+  static void onTransition(void* ctx, Valve& valve);
+  static uint64_t clockUs();            // keeps counting across soft resets and deep sleep on ESP32
+  static uint32_t crc32(const uint8_t* data, size_t length);
+
+  Valve*   valves[WARM_STATE_MAX_VALVES] = {nullptr};
+  uint8_t  valveCount = 0;
+  bool     restored   = false;          // block initialised: saves may go out
+  bool     warm       = false;
+  uint32_t downtimeMs = 0;
+  uint32_t restoreMs  = 0;
+
+  static Block block;                   // one RTC block per chip, so one per sketch
+};
+
+#endif // WARM_STATE_H
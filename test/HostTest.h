@@ -0,0 +1,77 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * Minimal test runner for the host builds: TEST() registers a case, CHECK*() report
+ * failures with file:line and carry on, HOST_TEST_MAIN() runs every case and returns
+ * the failure count as the exit status.
+ */
+namespace hosttest {
+
+  typedef void (*CaseFn)();
+  struct Case { const char* name; CaseFn fn; };
+
+  inline Case* cases()      { static Case list[64]; return list; }
+  inline int&  caseCount()  { static int n = 0; return n; }
+  inline int&  failures()   { static int n = 0; return n; }
+  inline int&  checks()     { static int n = 0; return n; }
+
+  struct Registrar {
+    Registrar(const char* name, CaseFn fn) {
+      if (caseCount() < 64) cases()[caseCount()++] = Case{ name, fn };
+    }
+  };
+
+  inline void fail(const char* file, int line, const char* what) {
+    failures()++;
+    printf("  FAIL %s:%d: %s\n", file, line, what);
+  }
+
+  inline int runAll(const char* suite) {
+    for (int i = 0; i < caseCount(); ++i) {
+      const int before = failures();
+      cases()[i].fn();
+      printf("%s %s.%s\n", failures() == before ? "ok  " : "FAIL", suite, cases()[i].name);
+    }
+    printf("%s: %d cases, %d checks, %d failed\n", suite, caseCount(), checks(), failures());
+    return failures() ? 1 : 0;
+  }
+
+} // namespace hosttest
+
+#define TEST(name) \
+  static void name(); \
+  static hosttest::Registrar name##_registrar(#name, name); \
+  static void name()
+
+#define CHECK(cond) do { \
+    hosttest::checks()++; \
+    if (!(cond)) hosttest::fail(__FILE__, __LINE__, #cond); \
+  } while (0)
+
+#define CHECK_EQ(a, b) do { \
+    hosttest::checks()++; \
+    const long long va_ = (long long)(a), vb_ = (long long)(b); \
+    if (va_ != vb_) { \
+      char msg_[192]; \
+      snprintf(msg_, sizeof(msg_), "%s == %s (%lld vs %lld)", #a, #b, va_, vb_); \
+      hosttest::fail(__FILE__, __LINE__, msg_); \
+    } \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tol) do { \
+    hosttest::checks()++; \
+    const double va_ = (double)(a), vb_ = (double)(b); \
+    if (va_ - vb_ > (tol) || vb_ - va_ > (tol)) { \
+      char msg_[192]; \
+      snprintf(msg_, sizeof(msg_), "%s ~ %s (%g vs %g, tol %g)", #a, #b, va_, vb_, (double)(tol)); \
+      hosttest::fail(__FILE__, __LINE__, msg_); \
+    } \
+  } while (0)
+
+#define HOST_TEST_MAIN(suite) int main() { return hosttest::runAll(suite); }
+
+#endif // HOST_TEST_H
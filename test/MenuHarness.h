@@ -0,0 +1,93 @@
+#ifndef MENU_HARNESS_H
+#define MENU_HARNESS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Ssd1306Panel.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include "MENU.h"
+
+/** Print into a std::string (PBM dumps, reports). */
+struct StringPrint : public Print {
+  std::string data;
+  size_t write(uint8_t c) override { data += char(c); return 1; }
+  using Print::write;
+};
+
+/** Fresh virtual clock and Wire with an SSD1306 model listening at 0x3C. */
+inline void startDisplayBus(Ssd1306Panel& panel) {
+  host::reset();
+  Wire.end();
+  Wire.resetCounters();
+  panel.attach(Wire);
+}
+
+inline std::string framePBM(const MenuBase& menu) {
+  StringPrint out;
+  menu.dumpFramePBM(out);
+  return out.data;
+}
+
+inline std::string panelPBM(const Ssd1306Panel& panel) {
+  StringPrint out;
+  panel.dumpPBM(out);
+  return out.data;
+}
+
+/**
+ * Compares a P4 frame with golden/<name>.pbm. UPDATE_GOLDENS=1 (make goldens) rewrites
+ * the file instead; a mismatch leaves build/<name>.actual.pbm next to it for a diff.
+ */
+inline bool matchesGolden(const char* name, const std::string& pbm) {
+  char path[160];
+  snprintf(path, sizeof(path), "golden/%s.pbm", name);
+  if (getenv("UPDATE_GOLDENS")) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    fwrite(pbm.data(), 1, pbm.size(), f);
+    fclose(f);
+    return true;
+  }
+  std::string golden;
+  if (FILE* f = fopen(path, "rb")) {
+    char buf[512];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) golden.append(buf, n);
+    fclose(f);
+  }
+  if (golden == pbm) return true;
+  snprintf(path, sizeof(path), "build/%s.actual.pbm", name);
+  if (FILE* f = fopen(path, "wb")) {
+    fwrite(pbm.data(), 1, pbm.size(), f);
+    fclose(f);
+  }
+  return false;
+}
+
+/** One frame the way the sketch runs it: tick, render, flush, then advance the clock. */
+template <class MenuType>
+void runFrames(MenuType& menu, uint32_t frames, uint32_t frameMs = 20) {
+  for (uint32_t i = 0; i < frames; ++i) {
+    menu.tick();
+    menu.renderMenu();
+    menu.flushDisplay();
+    host::advanceMs(frameMs);
+  }
+}
+
+/** Provider with numbered rows, some long enough to marquee. */
+class NumberedRows : public MenuItemProvider {
+public:
+  explicit NumberedRows(uint16_t n) : n(n) {}
+  uint16_t count() const override { return n; }
+  void format(uint16_t index, char* buf, size_t cap) const override {
+    if (index % 5 == 4) snprintf(buf, cap, "Row %u has a label too long to fit", index);
+    else                snprintf(buf, cap, "Row %u", index);
+  }
+private:
+  uint16_t n;
+};
+
+#endif // MENU_HARNESS_H
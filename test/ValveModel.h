@@ -0,0 +1,56 @@
+#ifndef VALVE_MODEL_H
+#define VALVE_MODEL_H
+
+#include <Arduino.h>
+#include "Valve.h"
+
+/**
+ * Motorised valve with end stops, driven from the host pin levels: the actuator moves
+ * while exactly one of the open/close pins is HIGH, and the limit inputs (active LOW)
+ * follow its position. setTravelMs() changes the speed, not the position.
+ */
+struct ValveModel {
+  uint8_t  openPin, closePin, openLimit, closedLimit;
+  uint32_t travelUs;
+  uint32_t positionUs = 0;       // 0 = closed, travelUs = open
+
+  ValveModel(uint8_t openPin, uint8_t closePin, uint8_t openLimit, uint8_t closedLimit, uint32_t travelMs)
+    : openPin(openPin), closePin(closePin), openLimit(openLimit), closedLimit(closedLimit), travelUs(travelMs * 1000) {
+    publish();
+  }
+
+  void setTravelMs(uint32_t ms) {
+    const uint64_t scaled = (uint64_t)positionUs * ms * 1000 / travelUs;
+    travelUs   = ms * 1000;
+    positionUs = (uint32_t)scaled;
+  }
+  void placeOpen()   { positionUs = travelUs; publish(); }
+  void placeClosed() { positionUs = 0;        publish(); }
+  bool isFullyOpen()   const { return positionUs >= travelUs; }
+  bool isFullyClosed() const { return positionUs == 0; }
+
+  void step(uint32_t us) {
+    const bool opening = host::pinLevel(openPin) == HIGH, closing = host::pinLevel(closePin) == HIGH;
+    if (opening && !closing)      positionUs = min<uint32_t>(positionUs + us, travelUs);
+    else if (closing && !opening) positionUs = positionUs > us ? positionUs - us : 0;
+    publish();
+  }
+
+  void publish() {
+    host::setInput(openLimit,   isFullyOpen()   ? LOW : HIGH);
+    host::setInput(closedLimit, isFullyClosed() ? LOW : HIGH);
+  }
+};
+
+/** 1 ms steps of model + valve.update() until the move in progress ends (or maxMs). */
+inline uint32_t runMove(Valve& valve, ValveModel& model, uint32_t maxMs = 10000) {
+  uint32_t ms = 0;
+  do {
+    host::advanceMs(1);
+    model.step(1000);
+    valve.update();
+  } while (valve.isInTransition() && ++ms < maxMs);
+  return ms;
+}
+
+#endif // VALVE_MODEL_H
@@ -0,0 +1,129 @@
+// Menu rendering benchmark on the host stand-ins: ns per frame (host CPU, for comparing
+// changes, not ESP32 timings) and bytes per frame on the bus (exact: same framing as the device).
+#include <chrono>
+#include "MenuHarness.h"
+
+struct Layout { const char* name; uint8_t cols; uint8_t rows; bool statusBar; bool prerender; };
+static const Layout layouts[] = {
+  { "1x6",           1, 6, false, false },
+  { "2x3",           2, 3, false, false },
+  { "2x6",           2, 6, false, false },
+  { "2x4+status",    2, 4, true,  false },
+  { "2x3+prerender", 2, 3, false, true  },
+};
+
+static const uint32_t FRAMES = 2000;
+
+struct Result { uint64_t ns; uint32_t frames; uint32_t bytes; uint64_t busUs; };
+
+static uint64_t nowNs() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void report(const Layout& l, const char* scenario, const Result& r) {
+  printf("%-14s %-12s %6u frames %9.0f ns/frame %7.1f B/frame %8.1f us bus/frame\n", l.name, scenario, r.frames,
+         r.frames ? double(r.ns) / r.frames : 0.0, r.frames ? double(r.bytes) / r.frames : 0.0,
+         r.frames ? double(r.busUs) / r.frames : 0.0);
+}
+
+// Fresh menu on the given layout, first frame already out
+struct Bench {
+  Ssd1306Panel panel;
+  NumberedRows rows{ 500 };
+  Menu         menu;
+
+  Bench(const Layout& l, Menu::TransitionType transition)
+    : menu(128, 64, -1, 0x3C, 21, 22, l.statusBar) {
+    startDisplayBus(panel);
+    menu.initializeDisplay();
+    menu.setMenuItems(&rows);
+    menu.setMenuTitle("Bench", 1);
+    menu.setMenuColumns(l.cols);
+    menu.setMenuRows(l.rows);
+    menu.setColumnNumberOfCharacters(l.cols == 1 ? 21 : 10);
+    menu.setMarqueeMode(Menu::MarqueeMode::AllOverflow);
+    menu.setPageTransition(transition, 300);
+    menu.setPrerenderEnabled(l.prerender);
+    menu.showMenu();
+    runFrames(menu, 5);
+    Wire.resetCounters();
+  }
+
+  Result measure(uint64_t ns, uint32_t frames) {
+    Result r = { ns, frames, Wire.getBytesWritten(), Wire.getBusTimeUs() };
+    return r;
+  }
+};
+
+static Result benchDrawBody(const Layout& l) {
+  Bench b(l, Menu::TransitionType::None);
+  uint64_t ns = 0;
+  for (uint32_t i = 0; i < FRAMES; ++i) {
+    b.menu.markBodyDirty();
+    const uint64_t t0 = nowNs();
+    b.menu.renderMenu();
+    ns += nowNs() - t0;
+    b.menu.flushDisplay();
+  }
+  return b.measure(ns, FRAMES);
+}
+
+static Result benchTick(const Layout& l) {
+  Bench b(l, Menu::TransitionType::None);
+  uint64_t ns = 0;
+  for (uint32_t i = 0; i < FRAMES; ++i) {
+    host::advanceMs(20);
+    const uint64_t t0 = nowNs();
+    b.menu.tick();
+    ns += nowNs() - t0;
+    b.menu.renderMenu();
+    b.menu.flushDisplay();
+  }
+  return b.measure(ns, FRAMES);
+}
+
+static Result benchRefresh(const Layout& l) {
+  Bench b(l, Menu::TransitionType::None);
+  uint64_t ns = 0;
+  for (uint32_t i = 0; i < FRAMES; ++i) {
+    host::advanceMs(20);
+    const uint64_t t0 = nowNs();
+    b.menu.tick();
+    b.menu.refreshMenu();
+    ns += nowNs() - t0;
+  }
+  return b.measure(ns, FRAMES);
+}
+
+// Page changes back to back; only frames of a running transition are counted
+static Result benchTransition(const Layout& l, Menu::TransitionType type) {
+  Bench b(l, type);
+  const uint8_t perPage = uint8_t(l.cols * l.rows);
+  uint64_t ns = 0;
+  uint32_t frames = 0;
+  while (frames < FRAMES) {
+    for (uint8_t i = 0; i < perPage; ++i) b.menu.nextItem();   // lands on the next page
+    for (uint8_t f = 0; f < 20; ++f) {
+      host::advanceMs(20);
+      const uint64_t t0 = nowNs();
+      b.menu.tick();
+      b.menu.refreshMenu();
+      ns += nowNs() - t0;
+      ++frames;
+    }
+  }
+  return b.measure(ns, frames);
+}
+
+int main() {
+  printf("Menu benchmark, %u frames per row, Wire at 400 kHz (bus time from the mock's bit count)\n", FRAMES);
+  for (const Layout& l : layouts) {
+    report(l, "drawBody",   benchDrawBody(l));
+    report(l, "tick",       benchTick(l));
+    report(l, "refresh",    benchRefresh(l));
+    report(l, "slide",      benchTransition(l, Menu::TransitionType::Slide));
+    report(l, "fade",       benchTransition(l, Menu::TransitionType::Fade));
+  }
+  return 0;
+}
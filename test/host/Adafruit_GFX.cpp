@@ -0,0 +1,193 @@
+#include "Adafruit_GFX.h"
+
+// Public-domain 5x7 font, ASCII 0x20..0x7E: five column bytes per glyph, bit 0 = top row
+static const uint8_t hostFont[95][5] = {
+  {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14},
+  {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00},
+  {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x14,0x08,0x3E,0x08,0x14}, {0x08,0x08,0x3E,0x08,0x08},
+  {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02},
+  {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31},
+  {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
+  {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00},
+  {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06},
+  {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
+  {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A},
+  {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41},
+  {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
+  {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31},
+  {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F},
+  {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00},
+  {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40},
+  {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20},
+  {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E},
+  {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00},
+  {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38},
+  {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20},
+  {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C},
+  {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00},
+  {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x10,0x08,0x08,0x10,0x08},
+};
+
+static uint8_t glyphColumn(unsigned char c, uint8_t column) {
+  if (c < 0x20 || c > 0x7E) return column == 2 ? 0x7F : 0x00; // outside the table: a bar, visible in goldens
+  return hostFont[c - 0x20][column];
+}
+
+// --- Adafruit_GFX ----------------------------------------------------------------
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  for (int16_t i = 0; i < h; ++i) drawPixel(x, int16_t(y + i), color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  for (int16_t i = 0; i < w; ++i) drawPixel(int16_t(x + i), y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t i = x; i < x + w; ++i) drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  const int16_t dx = int16_t(abs(x1 - x0)), dy = int16_t(-abs(y1 - y0));
+  const int16_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+  int16_t err = int16_t(dx + dy);
+  for (;;) {
+    drawPixel(x0, y0, color);
+    if (x0 == x1 && y0 == y1) break;
+    const int16_t e2 = int16_t(2 * err);
+    if (e2 >= dy) { err = int16_t(err + dy); x0 = int16_t(x0 + sx); }
+    if (e2 <= dx) { err = int16_t(err + dx); y0 = int16_t(y0 + sy); }
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, int16_t(y + h - 1), w, color);
+  drawFastVLine(x, y, h, color);
+  drawFastVLine(int16_t(x + w - 1), y, h, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+  const int16_t byteWidth = int16_t((w + 7) / 8);
+  for (int16_t j = 0; j < h; ++j) {
+    for (int16_t i = 0; i < w; ++i) {
+      if (bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7))) drawPixel(int16_t(x + i), int16_t(y + j), color);
+    }
+  }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+  const int16_t byteWidth = int16_t((w + 7) / 8);
+  for (int16_t j = 0; j < h; ++j) {
+    for (int16_t i = 0; i < w; ++i) {
+      const bool on = bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7));
+      drawPixel(int16_t(x + i), int16_t(y + j), on ? color : bg);
+    }
+  }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+  drawBitmap(x, y, (const uint8_t*)bitmap, w, h, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+  drawBitmap(x, y, (const uint8_t*)bitmap, w, h, color, bg);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+  if (x >= _width || y >= _height || (x + 6 * size - 1) < 0 || (y + 8 * size - 1) < 0) return;
+  for (uint8_t i = 0; i < 5; ++i) {
+    uint8_t line = glyphColumn(c, i);
+    for (uint8_t j = 0; j < 8; ++j, line >>= 1) {
+      if (line & 1) {
+        if (size == 1) drawPixel(int16_t(x + i), int16_t(y + j), color);
+        else           fillRect(int16_t(x + i * size), int16_t(y + j * size), size, size, color);
+      } else if (bg != color) {
+        if (size == 1) drawPixel(int16_t(x + i), int16_t(y + j), bg);
+        else           fillRect(int16_t(x + i * size), int16_t(y + j * size), size, size, bg);
+      }
+    }
+  }
+  if (bg != color) fillRect(int16_t(x + 5 * size), y, size, int16_t(8 * size), bg); // spacing column
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y = int16_t(cursor_y + textsize_y * 8);
+  } else if (c != '\r') {
+    if (wrap && (cursor_x + textsize_x * 6) > _width) {
+      cursor_x = 0;
+      cursor_y = int16_t(cursor_y + textsize_y * 8);
+    }
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x);
+    cursor_x = int16_t(cursor_x + textsize_x * 6);
+  }
+  return 1;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx, int16_t* miny, int16_t* maxx, int16_t* maxy) {
+  if (c == '\n') {
+    *x = 0;
+    *y = int16_t(*y + textsize_y * 8);
+  } else if (c != '\r') {
+    if (wrap && (*x + textsize_x * 6) > _width) {
+      *x = 0;
+      *y = int16_t(*y + textsize_y * 8);
+    }
+    const int16_t x2 = int16_t(*x + textsize_x * 6 - 1), y2 = int16_t(*y + textsize_y * 8 - 1);
+    if (x2 > *maxx) *maxx = x2;
+    if (y2 > *maxy) *maxy = y2;
+    if (*x < *minx) *minx = *x;
+    if (*y < *miny) *miny = *y;
+    *x = int16_t(*x + textsize_x * 6);
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+  for (; str && *str; ++str) charBounds((unsigned char)*str, &x, &y, &minx, &miny, &maxx, &maxy);
+  if (maxx >= minx) { *x1 = minx; *w = uint16_t(maxx - minx + 1); }
+  if (maxy >= miny) { *y1 = miny; *h = uint16_t(maxy - miny + 1); }
+}
+
+void Adafruit_GFX::getTextBounds(const String& str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+  getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+}
+
+// --- GFXcanvas1 ------------------------------------------------------------------------
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, bool allocate_buffer)
+  : Adafruit_GFX(int16_t(w), int16_t(h)), buffer(nullptr), buffer_owned(false) {
+  if (!allocate_buffer) return;
+  const size_t bytes = size_t((w + 7) / 8) * h;
+  buffer = (uint8_t*)malloc(bytes);
+  if (buffer) { memset(buffer, 0, bytes); buffer_owned = true; }
+}
+
+GFXcanvas1::~GFXcanvas1() {
+  if (buffer && buffer_owned) free(buffer);
+}
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+  uint8_t* ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+  if (color) *ptr |= uint8_t(0x80 >> (x & 7));
+  else       *ptr &= uint8_t(~(0x80 >> (x & 7)));
+}
+
+void GFXcanvas1::fillScreen(uint16_t color) {
+  if (buffer) memset(buffer, color ? 0xFF : 0x00, size_t((WIDTH + 7) / 8) * HEIGHT);
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+  if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return false;
+  return buffer[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+}
@@ -0,0 +1,85 @@
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for Adafruit_GFX and GFXcanvas1, drawing into memory.
+ * - Same public/protected surface the sketch's code uses, same buffer layouts
+ *   (GFXcanvas1: rows MSB-first) and the same classic 6x8 text cell rules
+ *   (transparent or opaque background, wrap, getTextBounds()).
+ * - Glyphs come from a public-domain 5x7 font in the classic layout, not from glcdfont.c:
+ *   golden frames made here match each other, not a photo of the panel.
+ * - Custom GFXfonts are not supported; setFont() only accepts NULL.
+ */
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h);
+  virtual ~Adafruit_GFX() {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+  virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  virtual void fillScreen(uint16_t color);
+  virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg);
+  void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg);
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+  void getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h);
+  void getTextBounds(const String& str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h);
+
+  void setTextSize(uint8_t s) { textsize_x = textsize_y = s ? s : 1; }
+  void setFont(const void* f) { (void)f; }
+  void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+  void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+  void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+  void setTextWrap(bool w) { wrap = w; }
+  void cp437(bool x = true) { _cp437 = x; }
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  int16_t width()  const { return _width; }
+  int16_t height() const { return _height; }
+  int16_t getCursorX() const { return cursor_x; }
+  int16_t getCursorY() const { return cursor_y; }
+
+protected:
+  void charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx, int16_t* miny, int16_t* maxx, int16_t* maxy);
+
+  const int16_t WIDTH;
+  const int16_t HEIGHT;
+  int16_t  _width;
+  int16_t  _height;
+  int16_t  cursor_x = 0;
+  int16_t  cursor_y = 0;
+  uint16_t textcolor   = 0xFFFF;
+  uint16_t textbgcolor = 0xFFFF;
+  uint8_t  textsize_x  = 1;
+  uint8_t  textsize_y  = 1;
+  bool     wrap   = true;
+  bool     _cp437 = false;
+};
+
+/** 1-bit canvas: rows of (w + 7) / 8 bytes, MSB = leftmost pixel. */
+class GFXcanvas1 : public Adafruit_GFX {
+public:
+  GFXcanvas1(uint16_t w, uint16_t h, bool allocate_buffer = true);
+  ~GFXcanvas1();
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+  bool getPixel(int16_t x, int16_t y) const;
+  uint8_t* getBuffer() const { return buffer; }
+
+protected:
+  uint8_t* buffer;
+  bool     buffer_owned;
+};
+
+#endif // HOST_ADAFRUIT_GFX_H
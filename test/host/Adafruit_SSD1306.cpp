@@ -0,0 +1,153 @@
+#include "Adafruit_SSD1306.h"
+
+#define WIRE_MAX (I2C_BUFFER_LENGTH < 256 ? I2C_BUFFER_LENGTH : 256) // as the library picks it
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rst_pin, uint32_t clkDuring, uint32_t clkAfter)
+  : Adafruit_GFX(w, h), wire(twi ? twi : &Wire), buffer(nullptr), i2caddr(0), vccstate(0),
+    rstPin(rst_pin), contrast(0), wireClk(clkDuring), restoreClk(clkAfter) {}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() {
+  if (buffer) free(buffer);
+}
+
+void Adafruit_SSD1306::ssd1306_command1(uint8_t c) {
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  wire->write(c);
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_commandList(const uint8_t* c, uint8_t n) {
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  uint16_t bytesOut = 1;
+  while (n--) {
+    if (bytesOut >= WIRE_MAX) {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x00);
+      bytesOut = 1;
+    }
+    wire->write(*c++);
+    bytesOut++;
+  }
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+  wire->setClock(wireClk);
+  ssd1306_command1(c);
+  wire->setClock(restoreClk);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool reset, bool periphBegin) {
+  (void)reset;
+  if (!buffer && !(buffer = (uint8_t*)malloc(size_t(WIDTH) * ((HEIGHT + 7) / 8)))) return false;
+  clearDisplay();
+  vccstate = int8_t(vcs);
+  i2caddr  = int8_t(addr ? addr : ((HEIGHT == 32) ? 0x3C : 0x3D));
+  if (periphBegin) wire->begin();
+
+  wire->setClock(wireClk);
+  static const uint8_t init1[] = { SSD1306_DISPLAYOFF, SSD1306_SETDISPLAYCLOCKDIV, 0x80, SSD1306_SETMULTIPLEX };
+  ssd1306_commandList(init1, sizeof(init1));
+  ssd1306_command1(uint8_t(HEIGHT - 1));
+  static const uint8_t init2[] = { SSD1306_SETDISPLAYOFFSET, 0x0, SSD1306_SETSTARTLINE | 0x0, SSD1306_CHARGEPUMP };
+  ssd1306_commandList(init2, sizeof(init2));
+  ssd1306_command1((vccstate == SSD1306_EXTERNALVCC) ? 0x10 : 0x14);
+  static const uint8_t init3[] = { SSD1306_MEMORYMODE, 0x00, SSD1306_SEGREMAP | 0x1, SSD1306_COMSCANDEC };
+  ssd1306_commandList(init3, sizeof(init3));
+  const uint8_t comPins = (HEIGHT == 32) ? 0x02 : 0x12;
+  contrast = (HEIGHT == 32) ? 0x8F : ((vccstate == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF);
+  ssd1306_command1(SSD1306_SETCOMPINS);
+  ssd1306_command1(comPins);
+  ssd1306_command1(SSD1306_SETCONTRAST);
+  ssd1306_command1(contrast);
+  ssd1306_command1(SSD1306_SETPRECHARGE);
+  ssd1306_command1((vccstate == SSD1306_EXTERNALVCC) ? 0x22 : 0xF1);
+  static const uint8_t init5[] = { SSD1306_SETVCOMDETECT, 0x40, SSD1306_DISPLAYALLON_RESUME,
+                                   SSD1306_NORMALDISPLAY, SSD1306_DEACTIVATE_SCROLL, SSD1306_DISPLAYON };
+  ssd1306_commandList(init5, sizeof(init5));
+  wire->setClock(restoreClk);
+  return true;
+}
+
+void Adafruit_SSD1306::display() {
+  wire->setClock(wireClk);
+  static const uint8_t dlist1[] = { SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0 };
+  ssd1306_commandList(dlist1, sizeof(dlist1));
+  ssd1306_command1(uint8_t(WIDTH - 1));
+
+  uint16_t count = uint16_t(WIDTH * ((HEIGHT + 7) / 8));
+  const uint8_t* ptr = buffer;
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x40);
+  uint16_t bytesOut = 1;
+  while (count--) {
+    if (bytesOut >= WIRE_MAX) {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x40);
+      bytesOut = 1;
+    }
+    wire->write(*ptr++);
+    bytesOut++;
+  }
+  wire->endTransmission();
+  wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+  if (buffer) memset(buffer, 0, size_t(WIDTH) * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i) {
+  ssd1306_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+}
+
+void Adafruit_SSD1306::dim(bool d) {
+  ssd1306_command(SSD1306_SETCONTRAST);
+  ssd1306_command(d ? 0 : contrast);
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!buffer || x < 0 || y < 0 || x >= width() || y >= height()) return;
+  uint8_t& b = buffer[x + (y / 8) * WIDTH];
+  const uint8_t bit = uint8_t(1 << (y & 7));
+  switch (color) {
+    case WHITE:   b |= bit;           break;
+    case BLACK:   b &= uint8_t(~bit); break;
+    case INVERSE: b ^= bit;           break;
+  }
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  for (int16_t i = 0; i < w; ++i) drawPixel(int16_t(x + i), y, color);
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  for (int16_t i = 0; i < h; ++i) drawPixel(x, int16_t(y + i), color);
+}
+
+void Adafruit_SSD1306::startscrollright(uint8_t start, uint8_t stop) {
+  const uint8_t list[] = { SSD1306_RIGHT_HORIZONTAL_SCROLL, 0x00, start, 0x00, stop, 0x00, 0xFF, SSD1306_ACTIVATE_SCROLL };
+  wire->setClock(wireClk);
+  ssd1306_commandList(list, sizeof(list));
+  wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::startscrollleft(uint8_t start, uint8_t stop) {
+  const uint8_t list[] = { SSD1306_LEFT_HORIZONTAL_SCROLL, 0x00, start, 0x00, stop, 0x00, 0xFF, SSD1306_ACTIVATE_SCROLL };
+  wire->setClock(wireClk);
+  ssd1306_commandList(list, sizeof(list));
+  wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::stopscroll() {
+  ssd1306_command(SSD1306_DEACTIVATE_SCROLL);
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+  if (!buffer || x < 0 || y < 0 || x >= width() || y >= height()) return false;
+  return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
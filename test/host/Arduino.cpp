@@ -0,0 +1,269 @@
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+#define HOST_MAX_TIMERS 48
+
+namespace {
+  struct Timer {
+    host::TimerFn fn    = nullptr;
+    void*         ctx   = nullptr;
+    uint64_t      atUs  = 0;
+    bool          armed = false;
+  };
+
+  uint64_t clockUs = 0;
+  uint32_t timerLatencyUs = 0;
+  Timer    timers[HOST_MAX_TIMERS];
+
+  uint8_t  levels[HOST_PIN_COUNT];
+  uint8_t  inputs[HOST_PIN_COUNT];
+  uint8_t  modes[HOST_PIN_COUNT];
+  uint16_t analog[HOST_PIN_COUNT];
+  uint32_t writes[HOST_PIN_COUNT];
+  uint32_t duty[HOST_PIN_COUNT];
+  bool     ledc[HOST_PIN_COUNT];
+
+  void (*isr[HOST_PIN_COUNT])(void*);
+  void*    isrArg[HOST_PIN_COUNT];
+  uint32_t strayDetachCount = 0;
+
+  host::PinHook  pinHook  = nullptr;
+  void*          pinCtx   = nullptr;
+  host::DutyHook dutyHook = nullptr;
+  void*          dutyCtx  = nullptr;
+
+  bool        capture = false;
+  std::string captured;
+  std::string serialIn;
+
+  void (*plainIsr[HOST_PIN_COUNT])();
+  void callPlain(void* arg) { plainIsr[(uintptr_t)arg](); }
+}
+
+// --- clock -------------------------------------------------------------------------
+
+unsigned long millis() { return (unsigned long)(uint32_t)(clockUs / 1000); }
+unsigned long micros() { return (unsigned long)(uint32_t)clockUs; }
+void delay(uint32_t ms) { host::advanceUs((uint64_t)ms * 1000); }
+void delayMicroseconds(uint32_t us) { host::advanceUs(us); }
+void yield() {}
+
+// --- pins ----------------------------------------------------------------------------
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= HOST_PIN_COUNT) return;
+  modes[pin] = mode;
+  if (mode == INPUT_PULLUP && !inputs[pin]) inputs[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+  if (pin >= HOST_PIN_COUNT) return;
+  level = level ? HIGH : LOW;
+  writes[pin]++;
+  if (levels[pin] == level) return;
+  levels[pin] = level;
+  if (pinHook) pinHook(pinCtx, pin, level);
+}
+
+int digitalRead(uint8_t pin) {
+  if (pin >= HOST_PIN_COUNT) return LOW;
+  return (modes[pin] == OUTPUT) ? levels[pin] : inputs[pin];
+}
+
+uint16_t analogRead(uint8_t pin) { return pin < HOST_PIN_COUNT ? analog[pin] : 0; }
+uint32_t analogReadMilliVolts(uint8_t pin) { return (uint32_t)analogRead(pin) * 3300 / 4095; }
+
+// --- interrupts ---------------------------------------------------------------------
+
+void attachInterruptArg(uint8_t pin, void (*fn)(void*), void* arg, int mode) {
+  (void)mode;
+  if (pin >= HOST_PIN_COUNT) return;
+  isr[pin]    = fn;
+  isrArg[pin] = arg;
+}
+
+void attachInterrupt(uint8_t pin, void (*fn)(void), int mode) {
+  if (pin >= HOST_PIN_COUNT) return;
+  plainIsr[pin] = fn;
+  attachInterruptArg(pin, callPlain, (void*)(uintptr_t)pin, mode);
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin >= HOST_PIN_COUNT || !isr[pin]) { strayDetachCount++; return; }
+  isr[pin] = nullptr;
+}
+
+void noInterrupts() {}
+void interrupts() {}
+
+// --- LEDC -----------------------------------------------------------------------------
+
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution) {
+  if (pin >= HOST_PIN_COUNT || !freq || !resolution) return false;
+  ledc[pin] = true;
+  duty[pin] = 0;
+  return true;
+}
+
+bool ledcWrite(uint8_t pin, uint32_t value) {
+  if (pin >= HOST_PIN_COUNT || !ledc[pin]) return false;
+  duty[pin] = value;
+  if (dutyHook) dutyHook(dutyCtx, pin, value);
+  return true;
+}
+
+// --- String --------------------------------------------------------------------------
+
+String::String(int v)           : s(std::to_string(v)) {}
+String::String(unsigned v)      : s(std::to_string(v)) {}
+String::String(long v)          : s(std::to_string(v)) {}
+String::String(unsigned long v) : s(std::to_string(v)) {}
+
+String String::substring(unsigned from, unsigned to) const {
+  if (from > to) std::swap(from, to);
+  if (from >= s.size()) return String();
+  return String(s.substr(from, to - from));
+}
+
+// --- Print -----------------------------------------------------------------------------
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::print(const char* s) { return write(s); }
+
+size_t Print::print(long v, int base) {
+  if (base == DEC) { char buf[24]; snprintf(buf, sizeof(buf), "%ld", v); return write(buf); }
+  return print((unsigned long)v, base);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", v);
+  return write(buf);
+}
+
+size_t Print::print(long long v, int base)           { return base == DEC ? print((long)v) : print((unsigned long)v, base); }
+size_t Print::print(unsigned long long v, int base)  { return print((unsigned long)v, base); }
+
+size_t Print::print(double v, int digits) {
+  char buf[40];
+  snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  return write(buf);
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  return write(buf);
+}
+
+int HardwareSerial::available() { return (int)serialIn.size(); }
+
+int HardwareSerial::read() {
+  if (serialIn.empty()) return -1;
+  const int c = (uint8_t)serialIn[0];
+  serialIn.erase(0, 1);
+  return c;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (capture) captured += (char)c;
+  else         fputc(c, stdout);
+  return 1;
+}
+
+// --- test controls -------------------------------------------------------------------------
+
+namespace host {
+
+void reset() {
+  clockUs = 0;
+  timerLatencyUs = 0;
+  for (uint8_t i = 0; i < HOST_MAX_TIMERS; ++i) timers[i] = Timer();
+  memset(levels, 0, sizeof(levels));
+  memset(inputs, 0, sizeof(inputs));
+  memset(modes, 0, sizeof(modes));
+  memset(analog, 0, sizeof(analog));
+  memset(writes, 0, sizeof(writes));
+  memset(duty, 0, sizeof(duty));
+  memset(ledc, 0, sizeof(ledc));
+  memset(isr, 0, sizeof(isr));
+  strayDetachCount = 0;
+  pinHook  = nullptr;
+  dutyHook = nullptr;
+  captured.clear();
+  serialIn.clear();
+  resetAdc();
+}
+
+uint64_t nowUs() { return clockUs; }
+
+void advanceUs(uint64_t us) {
+  const uint64_t target = clockUs + us;
+  for (;;) {
+    // Earliest armed timer due by the target; ties go in handle order
+    int next = -1;
+    for (int i = 0; i < HOST_MAX_TIMERS; ++i) {
+      if (!timers[i].armed || timers[i].atUs > target) continue;
+      if (next < 0 || timers[i].atUs < timers[next].atUs) next = i;
+    }
+    if (next < 0) break;
+    if (timers[next].atUs > clockUs) clockUs = timers[next].atUs;
+    clockUs += timerLatencyUs;         // callbacks run one after another on a single task
+    timers[next].armed = false;
+    timers[next].fn(timers[next].ctx);
+  }
+  if (target > clockUs) clockUs = target;
+}
+
+void advanceMs(uint32_t ms) { advanceUs((uint64_t)ms * 1000); }
+void setTimeUs(uint64_t us) { if (us > clockUs) clockUs = us; }
+
+int addTimer(TimerFn fn, void* ctx) {
+  for (int i = 0; i < HOST_MAX_TIMERS; ++i) {
+    if (timers[i].fn) continue;
+    timers[i] = Timer();
+    timers[i].fn  = fn;
+    timers[i].ctx = ctx;
+    return i;
+  }
+  return -1;
+}
+
+void armTimer(int handle, uint64_t atUs) {
+  if (handle < 0 || handle >= HOST_MAX_TIMERS) return;
+  timers[handle].atUs  = atUs;
+  timers[handle].armed = true;
+}
+
+void disarmTimer(int handle)  { if (handle >= 0 && handle < HOST_MAX_TIMERS) timers[handle].armed = false; }
+void removeTimer(int handle)  { if (handle >= 0 && handle < HOST_MAX_TIMERS) timers[handle] = Timer(); }
+void setTimerLatencyUs(uint32_t us) { timerLatencyUs = us; }
+
+uint8_t  pinLevel(uint8_t pin)  { return pin < HOST_PIN_COUNT ? levels[pin] : LOW; }
+uint8_t  pinModeOf(uint8_t pin) { return pin < HOST_PIN_COUNT ? modes[pin] : 0; }
+void     setInput(uint8_t pin, uint8_t level)    { if (pin < HOST_PIN_COUNT) inputs[pin] = level ? HIGH : LOW; }
+void     setAnalog(uint8_t pin, uint16_t value)  { if (pin < HOST_PIN_COUNT) analog[pin] = value; }
+uint32_t ledcDuty(uint8_t pin)     { return pin < HOST_PIN_COUNT ? duty[pin] : 0; }
+bool     ledcAttached(uint8_t pin) { return pin < HOST_PIN_COUNT && ledc[pin]; }
+uint32_t pinWrites(uint8_t pin)    { return pin < HOST_PIN_COUNT ? writes[pin] : 0; }
+void     setPinHook(PinHook fn, void* ctx)   { pinHook = fn;  pinCtx = ctx; }
+void     setDutyHook(DutyHook fn, void* ctx) { dutyHook = fn; dutyCtx = ctx; }
+
+bool interruptAttached(uint8_t pin) { return pin < HOST_PIN_COUNT && isr[pin]; }
+void fireInterrupt(uint8_t pin)     { if (pin < HOST_PIN_COUNT && isr[pin]) isr[pin](isrArg[pin]); }
+uint32_t strayDetaches()            { return strayDetachCount; }
+
+void         captureSerial(bool on)     { capture = on; }
+std::string& serialOutput()             { return captured; }
+void         feedSerial(const char* in) { serialIn += in; }
+
+} // namespace host
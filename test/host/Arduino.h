@@ -0,0 +1,203 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <algorithm>
+#include <string>
+
+/**
+ * Host stand-in for the Arduino-ESP32 core (3.x API), enough to build the sketch's
+ * modules on a desktop and drive them from tests.
+ * - Virtual clock: millis()/micros() only move when a test advances them (host::advanceUs),
+ *   delay() advances it too. Timers registered through host::addTimer() fire in order
+ *   as the clock passes their deadline.
+ * - Pins: output levels, input levels and LEDC duty per pin; every output change can be
+ *   observed through host::setPinHook() (valve models, duty timelines).
+ * - Interrupts: attachInterruptArg() records the handler, host::fireInterrupt() runs it.
+ * - Serial prints to stdout, or into host::serialOutput() when captured.
+ * - Continuous ADC (esp32-hal-adc.h) replays recorded captures per pin.
+ */
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define PULLUP       0x04
+#define INPUT_PULLUP 0x05
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define DEC 10
+#define HEX 16
+
+#define IRAM_ATTR
+#define F(s) (s)
+
+#define ESP_ARDUINO_VERSION_MAJOR 3
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define digitalPinToInterrupt(p) ((uint8_t)(p) < HOST_PIN_COUNT ? (int)(p) : -1)
+
+#define HOST_PIN_COUNT 64
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int  digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+
+void attachInterruptArg(uint8_t pin, void (*fn)(void*), void* arg, int mode);
+void attachInterrupt(uint8_t pin, void (*fn)(void), int mode);
+void detachInterrupt(uint8_t pin);
+void noInterrupts();
+void interrupts();
+
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+
+// --- String --------------------------------------------------------------------
+
+class String {
+public:
+  String(const char* s = "") : s(s ? s : "") {}
+  String(const std::string& str) : s(str) {}
+  String(char c) : s(1, c) {}
+  String(int v);
+  String(unsigned v);
+  String(long v);
+  String(unsigned long v);
+
+  unsigned    length() const { return (unsigned)s.size(); }
+  const char* c_str()  const { return s.c_str(); }
+  void        remove(unsigned index) { if (index < s.size()) s.erase(index); }
+  void        remove(unsigned index, unsigned count) { if (index < s.size()) s.erase(index, count); }
+  String      substring(unsigned from) const { return from < s.size() ? String(s.substr(from)) : String(); }
+  String      substring(unsigned from, unsigned to) const;
+  int         indexOf(char c) const { size_t p = s.find(c); return p == std::string::npos ? -1 : (int)p; }
+  char        charAt(unsigned i) const { return i < s.size() ? s[i] : 0; }
+  char        operator[](unsigned i) const { return charAt(i); }
+
+  String& operator+=(const String& o) { s += o.s; return *this; }
+  String& operator+=(const char* o)   { s += o; return *this; }
+  String& operator+=(char c)          { s += c; return *this; }
+  String  operator+(const String& o) const { return String(s + o.s); }
+  friend String operator+(const char* a, const String& b) { return String(std::string(a) + b.s); }
+  bool operator==(const String& o) const { return s == o.s; }
+  bool operator!=(const String& o) const { return s != o.s; }
+  bool operator==(const char* o)   const { return s == o; }
+
+private:
+  std::string s;
+};
+
+// --- Print -----------------------------------------------------------------------
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+  size_t print(const char* s);
+  size_t print(const String& s) { return print(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC);
+  size_t print(unsigned long v, int base = DEC);
+  size_t print(long long v, int base = DEC);
+  size_t print(unsigned long long v, int base = DEC);
+  size_t print(double v, int digits = 2);
+
+  template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  template <typename T> size_t println(const T& v, int base) { size_t n = print(v, base); return n + println(); }
+  size_t println() { return write((const uint8_t*)"\r\n", 2); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class HardwareSerial : public Print {
+public:
+  void   begin(unsigned long baud) { (void)baud; }
+  void   end() {}
+  explicit operator bool() const { return true; }
+  int    available();
+  int    read();
+  size_t write(uint8_t c) override;
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// --- test controls -----------------------------------------------------------------
+
+namespace host {
+
+  typedef void (*PinHook)(void* ctx, uint8_t pin, uint8_t level);      // output level changed
+  typedef void (*DutyHook)(void* ctx, uint8_t pin, uint32_t duty);     // LEDC duty written
+  typedef void (*TimerFn)(void* ctx);
+
+  void     reset();                         // clock to 0, pins, LEDC, interrupts and timers cleared
+  uint64_t nowUs();
+  void     advanceUs(uint64_t us);          // fires due timers in deadline order on the way
+  void     advanceMs(uint32_t ms);
+  void     setTimeUs(uint64_t us);          // jump (no timers fired); only forward
+
+  // Timers (esp_timer / hardware timer stand-ins)
+  int      addTimer(TimerFn fn, void* ctx); // handle, -1 when full
+  void     armTimer(int handle, uint64_t atUs);
+  void     disarmTimer(int handle);
+  void     removeTimer(int handle);
+  void     setTimerLatencyUs(uint32_t us);  // dispatch cost per callback (one timer task)
+
+  // Pins
+  uint8_t  pinLevel(uint8_t pin);           // last level written (output)
+  uint8_t  pinModeOf(uint8_t pin);
+  void     setInput(uint8_t pin, uint8_t level);
+  void     setAnalog(uint8_t pin, uint16_t value);
+  uint32_t ledcDuty(uint8_t pin);
+  bool     ledcAttached(uint8_t pin);
+  uint32_t pinWrites(uint8_t pin);          // digitalWrite() calls on that pin since reset()
+  void     setPinHook(PinHook fn, void* ctx);
+  void     setDutyHook(DutyHook fn, void* ctx);
+
+  // Interrupts
+  bool     interruptAttached(uint8_t pin);
+  void     fireInterrupt(uint8_t pin);
+  uint32_t strayDetaches();                 // detachInterrupt() on a pin with nothing attached
+
+  // Serial
+  void               captureSerial(bool capture);
+  std::string&       serialOutput();
+  void               feedSerial(const char* input);
+
+} // namespace host
+
+#include "esp32-hal-adc.h"
+
+#endif // HOST_ARDUINO_H
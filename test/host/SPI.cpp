@@ -0,0 +1,33 @@
+#include "SPI.h"
+
+SPIClass SPI;
+
+void SPIClass::begin(int8_t sck, int8_t miso, int8_t mosi, int8_t ss) {
+  (void)sck;
+  (void)miso;
+  (void)mosi;
+  (void)ss;
+}
+
+void SPIClass::beginTransaction(SPISettings settings) {
+  (void)settings;
+  inTransaction = true;
+  lastSize = 0;
+}
+
+void SPIClass::endTransaction() {
+  if (inTransaction) transactions++;
+  inTransaction = false;
+}
+
+void SPIClass::writeBytes(const uint8_t* data, uint32_t size) {
+  for (uint32_t i = 0; i < size; ++i) {
+    if (lastSize < sizeof(last)) last[lastSize++] = data[i];
+  }
+  bytes += size;
+}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  writeBytes(&data, 1);
+  return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0
+
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+    : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+  uint32_t clock;
+  uint8_t  bitOrder;
+  uint8_t  dataMode;
+};
+
+/** Host stand-in for SPIClass: counts transactions and bytes, keeps the last burst. */
+class SPIClass {
+public:
+  void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1);
+  void end() {}
+  void beginTransaction(SPISettings settings);
+  void endTransaction();
+  void writeBytes(const uint8_t* data, uint32_t size);
+  uint8_t transfer(uint8_t data);
+
+  // --- test side ---
+  void     resetCounters() { transactions = 0; bytes = 0; }
+  uint32_t getTransactionCount() const { return transactions; }
+  uint32_t getBytesWritten()     const { return bytes; }
+  const uint8_t* getLastBurst()  const { return last; }
+  uint32_t getLastBurstSize()    const { return lastSize; }
+
+private:
+  bool     inTransaction = false;
+  uint32_t transactions  = 0;
+  uint32_t bytes         = 0;
+  uint8_t  last[64];
+  uint32_t lastSize      = 0;
+};
+
+extern SPIClass SPI;
+
+#endif // HOST_SPI_H
@@ -0,0 +1,112 @@
+#include "Ssd1306Panel.h"
+
+Ssd1306Panel::Ssd1306Panel(uint8_t a, uint8_t height) : addr(a), pages(uint8_t(height / 8)) {
+  memset(ram, 0, sizeof(ram));
+}
+
+void Ssd1306Panel::attach(TwoWire& wire) { wire.attachDevice(&Ssd1306Panel::onWrite, this); }
+
+void Ssd1306Panel::onWrite(void* ctx, uint8_t a, const uint8_t* d, size_t len) {
+  Ssd1306Panel* self = static_cast<Ssd1306Panel*>(ctx);
+  if (a == self->addr) self->write(d, len);
+}
+
+void Ssd1306Panel::write(const uint8_t* d, size_t len) {
+  size_t i = 0;
+  while (i < len) {
+    const uint8_t ctrl = d[i++];
+    const bool    isData = ctrl & 0x40;
+    if (ctrl & 0x80) {                    // Co = 1: one byte, then another control byte
+      if (i < len) isData ? data(d[i++]) : command(d[i++]);
+    } else {                              // Co = 0: the rest of the transmission
+      while (i < len) isData ? data(d[i++]) : command(d[i++]);
+    }
+  }
+}
+
+static uint8_t argumentCount(uint8_t c) {
+  switch (c) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5:
+    case 0xD9: case 0xDA: case 0xDB:                 return 1;
+    case 0x21: case 0x22: case 0xA3:                 return 2;
+    case 0x29: case 0x2A:                            return 5;
+    case 0x26: case 0x27:                            return 6;
+    default:                                         return 0;
+  }
+}
+
+void Ssd1306Panel::command(uint8_t b) {
+  if (pendingLen == 0) pendingNeed = argumentCount(b);
+  pending[pendingLen++] = b;
+  if (pendingLen > pendingNeed) {
+    execute();
+    pendingLen = 0;
+  }
+}
+
+void Ssd1306Panel::execute() {
+  const uint8_t c = pending[0];
+  commands++;
+  if (c <= 0x0F)                { col = uint8_t((col & 0xF0) | c);                return; }
+  if (c >= 0x10 && c <= 0x1F)   { col = uint8_t((col & 0x0F) | ((c & 0x0F) << 4)); return; }
+  if (c >= 0x40 && c <= 0x7F)   return;                          // start line
+  if (c >= 0xB0 && c <= 0xB7)   { page = uint8_t(c & 0x07);      return; }
+  switch (c) {
+    case 0x20: memoryMode = uint8_t(pending[1] & 0x03); break;
+    case 0x21: colStart  = uint8_t(pending[1] & 0x7F); colEnd  = uint8_t(pending[2] & 0x7F); col  = colStart;  break;
+    case 0x22: pageStart = uint8_t(pending[1] & 0x07); pageEnd = uint8_t(pending[2] & 0x07); page = pageStart; break;
+    case 0x81: contrast = pending[1]; break;
+    case 0xAE: on = false; break;
+    case 0xAF: on = true;  break;
+    case 0x2E: scrolling = false; break;
+    case 0x2F: scrolling = true;  break;
+    case 0x26: case 0x27: case 0x29: case 0x2A: case 0xA3:
+    case 0x8D: case 0xA0: case 0xA1: case 0xA4: case 0xA5: case 0xA6: case 0xA7: case 0xA8:
+    case 0xC0: case 0xC8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xE3:
+      break;
+    default: unknown++; break;
+  }
+}
+
+void Ssd1306Panel::data(uint8_t b) {
+  dataBytes++;
+  ram[page * WIDTH + col] = b;
+  if (memoryMode == 0) {                   // horizontal: wrap inside the window
+    if (col >= colEnd) {
+      col = colStart;
+      page = (page >= pageEnd) ? pageStart : uint8_t(page + 1);
+    } else {
+      col++;
+    }
+  } else if (memoryMode == 1) {            // vertical
+    if (page >= pageEnd) {
+      page = pageStart;
+      col = (col >= colEnd) ? colStart : uint8_t(col + 1);
+    } else {
+      page++;
+    }
+  } else {                                 // page mode: column only
+    col = uint8_t((col + 1) & 0x7F);
+  }
+}
+
+bool Ssd1306Panel::pixel(uint8_t x, uint8_t y) const {
+  if (x >= WIDTH || y >= pages * 8) return false;
+  return ram[(y / 8) * WIDTH + x] & (1 << (y & 7));
+}
+
+bool Ssd1306Panel::matches(const uint8_t* pageMajor) const {
+  return memcmp(ram, pageMajor, size_t(WIDTH) * pages) == 0;
+}
+
+void Ssd1306Panel::dumpPBM(Print& out) const {
+  out.print("P4\n");
+  out.print(WIDTH); out.print(" "); out.print(pages * 8); out.print("\n");
+  for (uint8_t y = 0; y < pages * 8; ++y) {
+    for (uint8_t x = 0; x < WIDTH; x += 8) {
+      uint8_t packed = 0;
+      for (uint8_t b = 0; b < 8; ++b) if (!pixel(uint8_t(x + b), y)) packed |= uint8_t(0x80 >> b);
+      out.write(packed);
+    }
+  }
+}
@@ -0,0 +1,64 @@
+#ifndef HOST_SSD1306_PANEL_H
+#define HOST_SSD1306_PANEL_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+/**
+ * SSD1306 controller model on a host TwoWire: parses what reaches the address the way the
+ * chip does and keeps its own GDDRAM, so tests compare what the panel would show, not what
+ * the sketch meant to send.
+ * - Control bytes: Co/DC as in the datasheet (0x00 command stream, 0x80 one command,
+ *   0x40 data stream, 0xC0 one data byte).
+ * - Addressing: horizontal and page modes, COLUMNADDR/PAGEADDR windows, B0..B7 and
+ *   low/high column nibbles. Arguments may straddle transactions.
+ * - Display on/off, contrast and scroll activation are tracked; scrolling itself is not run.
+ */
+class Ssd1306Panel {
+public:
+  static const uint8_t WIDTH = 128;
+  static const uint8_t PAGES = 8;
+
+  explicit Ssd1306Panel(uint8_t addr = 0x3C, uint8_t height = 64);
+  void attach(TwoWire& wire);
+  void write(const uint8_t* data, size_t len);  // one address-framed transmission
+
+  bool           pixel(uint8_t x, uint8_t y) const;
+  const uint8_t* gddram() const { return ram; }
+  bool           matches(const uint8_t* pageMajor) const; // same bytes as a W x H/8 buffer
+  void           dumpPBM(Print& out) const;            // P4, 1 = unlit, as Menu::dumpFramePBM()
+
+  bool     isOn() const          { return on; }
+  uint8_t  getContrast() const   { return contrast; }
+  bool     isScrolling() const   { return scrolling; }
+  uint8_t  getMemoryMode() const { return memoryMode; }
+  uint32_t getCommandCount() const { return commands; }
+  uint32_t getDataBytes() const    { return dataBytes; }
+  uint32_t getUnknownCommands() const { return unknown; }
+
+private:
+  static void onWrite(void* ctx, uint8_t addr, const uint8_t* data, size_t len);
+  void command(uint8_t b);
+  void execute();
+  void data(uint8_t b);
+
+  uint8_t  addr;
+  uint8_t  pages;
+  uint8_t  ram[WIDTH * PAGES];
+
+  uint8_t  pending[8];          // command byte + arguments collected so far
+  uint8_t  pendingLen  = 0;
+  uint8_t  pendingNeed = 0;
+
+  uint8_t  memoryMode = 2;      // reset default: page addressing
+  uint8_t  colStart = 0, colEnd = WIDTH - 1, col = 0;
+  uint8_t  pageStart = 0, pageEnd = PAGES - 1, page = 0;
+  bool     on        = false;
+  uint8_t  contrast  = 0x7F;
+  bool     scrolling = false;
+  uint32_t commands  = 0;
+  uint32_t dataBytes = 0;
+  uint32_t unknown   = 0;
+};
+
+#endif // HOST_SSD1306_PANEL_H
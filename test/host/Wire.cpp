@@ -0,0 +1,57 @@
+#include "Wire.h"
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+  (void)sda;
+  (void)scl;
+  if (frequency) clockHz = frequency;
+  begun = true;
+  return true;
+}
+
+void TwoWire::beginTransmission(uint8_t a) {
+  addr     = a;
+  length   = 0;
+  overflow = false;
+}
+
+size_t TwoWire::write(uint8_t b) {
+  if (length >= I2C_BUFFER_LENGTH) { overflow = true; return 0; }
+  buffer[length++] = b;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t len) {
+  size_t n = 0;
+  while (len--) n += write(*data++);
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  if (!begun) { strayWrites++; return 4; }     // "other error", as the core reports it
+  if (overflow) return 1;                      // data too long for the buffer
+
+  const uint32_t clocks = 9u * uint32_t(length + 1) + (open ? 1 : 2) + (sendStop ? 1 : 0); // bytes + (repeated) START + STOP
+  busNs += (uint64_t)clocks * 1000000000ULL / clockHz;
+  bytes += uint32_t(length + 1);
+  writes++;
+  if (device) device(deviceCtx, addr, buffer, length);
+
+  open = !sendStop;
+  if (sendStop) transactions++;
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t a, uint8_t len, bool sendStop) {
+  (void)a;
+  (void)len;
+  if (sendStop) { transactions++; open = false; }
+  return 0;
+}
+
+void TwoWire::resetCounters() {
+  transactions = writes = bytes = strayWrites = 0;
+  busNs = 0;
+}
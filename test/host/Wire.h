@@ -0,0 +1,68 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+#define I2C_BUFFER_LENGTH 128       // arduino-esp32 default
+
+/**
+ * Host stand-in for TwoWire. Nothing goes on a wire; every write is counted and can be
+ * handed to a device model.
+ * - A transaction is START..STOP; endTransmission(false) keeps the bus (repeated START)
+ *   and the next write joins the same transaction.
+ * - Bytes include the address byte, as on the bus.
+ * - getBusTimeUs() adds up 9 clocks per byte plus START/STOP at the clock in force.
+ * - writesWithoutBegin() counts transmissions on a bus nobody has begun.
+ */
+class TwoWire {
+public:
+  typedef void (*DeviceFn)(void* ctx, uint8_t addr, const uint8_t* data, size_t len);
+
+  explicit TwoWire(uint8_t bus = 0) : busNum(bus) {}
+
+  bool    begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+  void    end() { begun = false; }
+  void    setClock(uint32_t hz) { clockHz = hz; }
+  uint32_t getClock() const { return clockHz; }
+
+  void    beginTransmission(uint8_t addr);
+  uint8_t endTransmission(bool sendStop = true);
+  size_t  write(uint8_t b);
+  size_t  write(const uint8_t* data, size_t len);
+  uint8_t requestFrom(uint8_t addr, uint8_t len, bool sendStop = true);
+  int     available() { return 0; }
+  int     read() { return -1; }
+
+  // --- test side ---
+  void     attachDevice(DeviceFn fn, void* ctx) { device = fn; deviceCtx = ctx; } // sees each address-framed write
+  void     resetCounters();
+  uint32_t getTransactionCount() const { return transactions; }   // STOPs sent
+  uint32_t getWriteCount()       const { return writes; }         // address-framed writes (incl. repeated START)
+  uint32_t getBytesWritten()     const { return bytes; }
+  uint64_t getBusTimeUs()        const { return busNs / 1000; }
+  uint32_t writesWithoutBegin()  const { return strayWrites; }
+  bool     isBegun()             const { return begun; }
+
+private:
+  uint8_t  busNum;
+  bool     begun    = false;
+  bool     open     = false;          // START sent, no STOP yet
+  uint32_t clockHz  = 100000;
+  uint8_t  addr     = 0;
+  uint8_t  buffer[I2C_BUFFER_LENGTH];
+  size_t   length   = 0;
+  bool     overflow = false;
+
+  DeviceFn device    = nullptr;
+  void*    deviceCtx = nullptr;
+  uint32_t transactions = 0;
+  uint32_t writes       = 0;
+  uint32_t bytes        = 0;
+  uint64_t busNs        = 0;
+  uint32_t strayWrites  = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // HOST_WIRE_H
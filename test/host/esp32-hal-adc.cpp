@@ -0,0 +1,138 @@
+#include <Arduino.h>
+#include <vector>
+
+#define ADC_MAX_PINS   8
+#define ADC_POOL_DEPTH 2
+
+namespace {
+  std::vector<uint16_t> capture[HOST_PIN_COUNT];
+  size_t   position[HOST_PIN_COUNT];
+
+  uint8_t  pins[ADC_MAX_PINS];
+  uint8_t  pinCount     = 0;
+  uint32_t conversions  = 0;
+  uint32_t periodUs     = 0;
+  void   (*userFn)(void) = nullptr;
+  int      timer        = -1;
+  bool     running      = false;
+
+  adc_continuous_data_t pool[ADC_POOL_DEPTH][ADC_MAX_PINS];
+  uint8_t  poolHead     = 0;
+  uint8_t  poolCount    = 0;
+  adc_continuous_data_t out[ADC_MAX_PINS];
+  uint32_t converted    = 0;
+  uint32_t dropped      = 0;
+
+  uint16_t nextSample(uint8_t pin) {
+    std::vector<uint16_t>& c = capture[pin];
+    if (c.empty()) return 0;
+    const uint16_t v = c[position[pin]];
+    position[pin] = (position[pin] + 1) % c.size();
+    return v;
+  }
+
+  void onFrameDone(void*) {
+    if (!running) return;
+    host::armTimer(timer, host::nowUs() + periodUs);
+    converted++;
+    adc_continuous_data_t frame[ADC_MAX_PINS];
+    for (uint8_t i = 0; i < pinCount; ++i) {
+      uint32_t sum = 0;
+      for (uint32_t n = 0; n < conversions; ++n) sum += nextSample(pins[i]);
+      frame[i].pin          = pins[i];
+      frame[i].channel      = i;
+      frame[i].avg_read_mv  = int(sum / conversions);
+      frame[i].avg_read_raw = frame[i].avg_read_mv * 4095 / 3300;
+    }
+    if (poolCount == ADC_POOL_DEPTH) { dropped++; return; }
+    memcpy(pool[(poolHead + poolCount) % ADC_POOL_DEPTH], frame, sizeof(frame));
+    poolCount++;
+    if (userFn) userFn();
+  }
+}
+
+bool analogContinuous(const uint8_t p[], size_t count, uint32_t conversionsPerPin, uint32_t hz, void (*fn)(void)) {
+  if (!count || count > ADC_MAX_PINS || !conversionsPerPin ||
+      hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW || hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) return false;
+  for (size_t i = 0; i < count; ++i) {
+    if (p[i] >= HOST_PIN_COUNT) return false;
+    pins[i] = p[i];
+  }
+  pinCount    = uint8_t(count);
+  conversions = conversionsPerPin;
+  periodUs    = uint32_t(1000000ULL * conversionsPerPin * count / hz);
+  userFn      = fn;
+  if (timer < 0) timer = host::addTimer(&onFrameDone, nullptr);
+  return timer >= 0;
+}
+
+bool analogContinuousStart() {
+  if (timer < 0 || running) return false;
+  running = true;
+  host::armTimer(timer, host::nowUs() + periodUs);
+  return true;
+}
+
+bool analogContinuousStop() {
+  if (!running) return false;
+  running = false;
+  host::disarmTimer(timer);
+  return true;
+}
+
+bool analogContinuousDeinit() {
+  analogContinuousStop();
+  if (timer >= 0) host::removeTimer(timer);
+  timer     = -1;
+  pinCount  = 0;
+  poolCount = 0;
+  return true;
+}
+
+bool analogContinuousRead(adc_continuous_data_t** buffer, uint32_t timeout_ms) {
+  (void)timeout_ms;                       // nothing happens while the caller would wait
+  if (!poolCount) return false;
+  memcpy(out, pool[poolHead], sizeof(out));
+  poolHead = (poolHead + 1) % ADC_POOL_DEPTH;
+  poolCount--;
+  *buffer = out;
+  return true;
+}
+
+namespace host {
+
+bool loadAdcCapture(uint8_t pin, const char* path) {
+  if (pin >= HOST_PIN_COUNT) return false;
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  std::vector<uint16_t> samples;
+  char line[64];
+  while (fgets(line, sizeof(line), f)) {
+    if (line[0] == '#' || line[0] == '\n') continue;
+    samples.push_back((uint16_t)strtoul(line, nullptr, 10));
+  }
+  fclose(f);
+  setAdcCapture(pin, samples.data(), samples.size());
+  return !samples.empty();
+}
+
+void setAdcCapture(uint8_t pin, const uint16_t* samples, size_t count) {
+  if (pin >= HOST_PIN_COUNT) return;
+  capture[pin].assign(samples, samples + count);
+  position[pin] = 0;
+}
+
+uint32_t adcFramesConverted() { return converted; }
+uint32_t adcFramesDropped()   { return dropped; }
+
+void resetAdc() {
+  for (uint8_t i = 0; i < HOST_PIN_COUNT; ++i) { capture[i].clear(); position[i] = 0; }
+  running   = false;
+  timer     = -1;                         // the timer table is cleared with it
+  pinCount  = 0;
+  poolHead  = poolCount = 0;
+  userFn    = nullptr;
+  converted = dropped = 0;
+}
+
+} // namespace host
@@ -0,0 +1,45 @@
+#ifndef HOST_ESP32_HAL_ADC_H
+#define HOST_ESP32_HAL_ADC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Host stand-in for the core's continuous (DMA) ADC API, fed from recorded captures.
+ * - Each pin replays its own capture (mV, one sample per conversion at the per-pin rate),
+ *   looping at the end; a pin without one reads 0.
+ * - Frames complete on the virtual clock every conversions_per_pin x pins conversions,
+ *   each result being the average of its conversions, and call the user callback.
+ * - The pool holds two frames, as the core sizes the driver's: a frame that finds it
+ *   full is dropped and counted (host::adcFramesDropped()).
+ */
+
+#define SOC_ADC_DMA_SUPPORTED          1
+#define SOC_ADC_SAMPLE_FREQ_THRES_LOW  611     // ESP32-S3 driver limits
+#define SOC_ADC_SAMPLE_FREQ_THRES_HIGH 83333
+
+typedef struct {
+  uint8_t pin;
+  uint8_t channel;
+  int     avg_read_raw;
+  int     avg_read_mv;
+} adc_continuous_data_t;
+
+bool analogContinuous(const uint8_t pins[], size_t pins_count, uint32_t conversions_per_pin,
+                      uint32_t sampling_freq_hz, void (*userFunc)(void));
+bool analogContinuousRead(adc_continuous_data_t** buffer, uint32_t timeout_ms);
+bool analogContinuousStart();
+bool analogContinuousStop();
+bool analogContinuousDeinit();
+
+namespace host {
+
+  bool     loadAdcCapture(uint8_t pin, const char* path); // text: one mV value per line, '#' comments
+  void     setAdcCapture(uint8_t pin, const uint16_t* samples, size_t count);
+  uint32_t adcFramesConverted();
+  uint32_t adcFramesDropped();
+  void     resetAdc();                                    // part of host::reset()
+
+} // namespace host
+
+#endif // HOST_ESP32_HAL_ADC_H
@@ -0,0 +1,32 @@
+#include "esp_timer.h"
+
+// Handles are host timer slots + 1, so a null handle stays invalid
+static int slotOf(esp_timer_handle_t timer) { return (int)(intptr_t)timer - 1; }
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+  if (!args || !args->callback || !out) return ESP_FAIL;
+  const int slot = host::addTimer(args->callback, args->arg);
+  if (slot < 0) return ESP_FAIL;
+  *out = (esp_timer_handle_t)(intptr_t)(slot + 1);
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+  if (!timer) return ESP_FAIL;
+  host::armTimer(slotOf(timer), host::nowUs() + timeout_us);
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  if (!timer) return ESP_FAIL;
+  host::disarmTimer(slotOf(timer));
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+  if (!timer) return ESP_FAIL;
+  host::removeTimer(slotOf(timer));
+  return ESP_OK;
+}
+
+int64_t esp_timer_get_time() { return (int64_t)host::nowUs(); }
@@ -0,0 +1,35 @@
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the esp_timer one-shot API on the virtual clock: callbacks run from
+ * host::advanceUs() in deadline order, one after another like the esp_timer task, each
+ * delayed by host::setTimerLatencyUs().
+ */
+typedef int esp_err_t;
+#ifndef ESP_OK
+  #define ESP_OK   0
+  #define ESP_FAIL -1
+#endif
+
+typedef struct host_esp_timer* esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void* arg);
+typedef enum { ESP_TIMER_TASK, ESP_TIMER_ISR } esp_timer_dispatch_t;
+
+typedef struct {
+  esp_timer_cb_t       callback;
+  void*                arg;
+  esp_timer_dispatch_t dispatch_method;
+  const char*          name;
+  bool                 skip_unhandled_events;
+} esp_timer_create_args_t;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
+int64_t   esp_timer_get_time();
+
+#endif // HOST_ESP_TIMER_H
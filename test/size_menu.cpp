@@ -0,0 +1,42 @@
+// The sketch's menu, runtime Menu vs FixedMenu, for `make -C test sizes`: built twice with
+// unused sections dropped so size/nm see only what each type pulls in. Host x86-64 numbers:
+// compare the two builds with each other, not with an ESP32 image.
+#include "MenuHarness.h"
+
+static const char* const items[] = { "Valve 1 Open", "Valve 1 Close", "Valve 2 Open", "Valve 2 Close",
+                                     "Open time", "Closed time", "Delay", "Flow meter has a long label" };
+
+#ifdef SIZE_FIXED_MENU
+FixedMenu<128, 64, 3, 2, false, true> mainMenu(-1, 0x3C, 21, 22);
+static const char* variant = "FixedMenu<128,64,3,2,false,true>";
+#else
+Menu mainMenu(128, 64, -1, 0x3C, 21, 22);
+static const char* variant = "Menu";
+#endif
+
+int main() {
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  mainMenu.initializeDisplay();
+  mainMenu.borrowMenuItems(items, sizeof(items) / sizeof(items[0]));
+  mainMenu.setMenuTitle("Valve Timer", 1);
+#ifndef SIZE_FIXED_MENU
+  mainMenu.setMenuColumns(2);
+  mainMenu.setMenuRows(3);
+#endif
+  mainMenu.setColumnNumberOfCharacters(14);
+  mainMenu.setMarqueeEnabled(true);
+  mainMenu.setMarqueeMode(Menu::MarqueeMode::AllOverflow);
+  mainMenu.setSmoothScrollEnabled(true);
+  mainMenu.setPageTransition(Menu::TransitionType::Slide, 280);
+  mainMenu.setPrerenderEnabled(true);
+  mainMenu.showMenu();
+  runFrames(mainMenu, 200);
+  for (uint8_t i = 0; i < 6; ++i) mainMenu.nextItem();   // onto the next page
+  runFrames(mainMenu, 200);
+
+  const Menu::MemoryUsage m = mainMenu.getMemoryUsage();
+  printf("%-34s object %5u B  buffers %5u B  heap %5u B\n", variant, (unsigned)sizeof(mainMenu),
+         (unsigned)m.total(), (unsigned)m.heap);
+  return 0;
+}
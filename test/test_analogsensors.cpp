@@ -0,0 +1,87 @@
+// DMA-sampled analog sensors against the host continuous ADC, replaying captures.
+#include "HostTest.h"
+#include "AnalogSensors.h"
+
+static const uint8_t PRESSURE_PIN = 4;
+
+struct LevelEvent { uint32_t ms; AnalogSensors::Level level; };
+static LevelEvent events[8];
+static uint8_t    eventCount;
+
+static void onLevel(void*, uint8_t, AnalogSensors::Level level) {
+  if (eventCount < 8) events[eventCount++] = { uint32_t(millis()), level };
+}
+
+// service() every periodMs, the way the sketch's valve task calls it
+static uint16_t runService(AnalogSensors& sensors, uint32_t ms, uint32_t periodMs, uint32_t untilMsPeak = 0) {
+  uint16_t peak = 0;
+  for (uint32_t t = 0; t < ms; t += periodMs) {
+    host::advanceMs(periodMs);
+    sensors.service();
+    if (millis() < untilMsPeak) peak = max(peak, sensors.getValue(0));
+  }
+  return peak;
+}
+
+static void setFlat(uint16_t mv) {
+  static uint16_t flat[64];
+  for (uint8_t i = 0; i < 64; ++i) flat[i] = mv;
+  host::setAdcCapture(PRESSURE_PIN, flat, 64);
+}
+
+TEST(drainsEveryFrameAtTheSketchPeriod) {
+  host::reset();
+  setFlat(1000);
+  AnalogSensors sensors;
+  sensors.addChannel(PRESSURE_PIN, 1300, 1600);
+  CHECK(sensors.begin(2000));                   // 8 ms frames, serviced every 10 ms
+  CHECK(sensors.usesDma());
+  runService(sensors, 2000, 10);
+
+  CHECK_EQ(host::adcFramesConverted(), 250u);
+  CHECK_EQ(host::adcFramesDropped(), 0u);
+  CHECK_EQ(sensors.getOverruns(0), 0u);
+  CHECK_EQ(sensors.getValue(0), 1000);
+  CHECK(sensors.getLevel(0) == AnalogSensors::Level::Low);
+  sensors.end();
+}
+
+TEST(lateServiceCountsDroppedFrames) {
+  host::reset();
+  setFlat(1000);
+  AnalogSensors sensors;
+  sensors.addChannel(PRESSURE_PIN, 1300, 1600);
+  CHECK(sensors.begin(2000));
+  runService(sensors, 1968, 48);                // 6 frames per call, the driver keeps 2
+
+  CHECK_EQ(host::adcFramesDropped(), 4u * 41);
+  CHECK_EQ(sensors.getOverruns(0), host::adcFramesDropped());
+  CHECK_EQ(sensors.getValue(0), 1000);
+  sensors.end();
+}
+
+TEST(replaysPumpStartCapture) {
+  host::reset();
+  CHECK(host::loadAdcCapture(PRESSURE_PIN, "captures/pump_start_1khz.txt"));
+  AnalogSensors sensors;
+  sensors.addChannel(PRESSURE_PIN, 1300, 1600);
+  sensors.setEventHandler(&onLevel, nullptr);
+  eventCount = 0;
+  CHECK(sensors.begin(1000));                   // capture rate: 16 ms frames
+  const uint16_t idlePeak = runService(sensors, 2900, 10, 1000);
+
+  CHECK_EQ(host::adcFramesDropped(), 0u);
+  CHECK_EQ(sensors.getOverruns(0), 0u);
+  CHECK(idlePeak < 850);                        // switching spikes never reach the filter
+  CHECK_EQ(eventCount, 1);                      // the first reading is not an event
+  if (eventCount) {
+    CHECK(events[0].level == AnalogSensors::Level::High);
+    CHECK(events[0].ms > 1300 && events[0].ms < 1800); // ramp ends at 1.3 s; 80 ms batches, IIR 1/8 per batch
+  }
+  CHECK_NEAR(sensors.getValue(0), 2200, 100);    // still closing in on the plateau
+  printf("  pump start: High at %u ms, idle peak %u mV, settled at %u mV\n",
+         eventCount ? events[0].ms : 0, idlePeak, sensors.getValue(0));
+  sensors.end();
+}
+
+HOST_TEST_MAIN("analogsensors")
@@ -0,0 +1,138 @@
+// Display transports: panel init off Wire, Wire fallback, and framing overhead on the mock bus.
+#include "HostTest.h"
+#include "MenuHarness.h"
+#include "DisplayTransport.h"
+
+/**
+ * Stands in for IdfI2cDisplayTransport: no payload limit, every transmit() is one
+ * START..STOP into its own panel model, bus time kept at its clock like host Wire does.
+ */
+class PanelTransport : public DisplayTransport {
+public:
+  PanelTransport(Ssd1306Panel& panel, uint32_t hz = DISPLAY_TRANSPORT_MAX_HZ, bool usable = true)
+    : DisplayTransport(0), panel(panel), clockHz(hz), usable(usable) {}
+  bool     begin(uint8_t a) override { addr = a; return usable; }
+  uint64_t getBusTimeUs() const { return busNs / 1000; }
+
+protected:
+  bool transmit(const DisplaySpan* segments, uint8_t count) override {
+    std::string bytes;
+    for (uint8_t i = 0; i < count; ++i) bytes.append((const char*)segments[i].data, segments[i].len);
+    panel.write((const uint8_t*)bytes.data(), bytes.size());
+    busNs += (9ULL * (bytes.size() + 1) + 2) * 1000000000ULL / clockHz; // + address, START/STOP
+    return true;
+  }
+
+private:
+  Ssd1306Panel& panel;
+  uint32_t      clockHz;
+  bool          usable;
+  uint64_t      busNs = 0;
+};
+
+static const char* const items[] = { "Device Status", "Adjust time", "Open Valve", "Close Valve" };
+
+static void bringUp(Menu& menu) {
+  menu.initializeDisplay();
+  menu.setMenuItems(items, 4);
+  menu.setMenuTitle("Valve Timer", 1);
+  menu.showMenu();
+  runFrames(menu, 3);
+}
+
+TEST(transportInitNeverTouchesWire) {
+  Ssd1306Panel wirePanel, panel;
+  startDisplayBus(wirePanel);
+  PanelTransport transport(panel);
+  Menu menu;
+  menu.setDisplayTransport(&transport);
+  bringUp(menu);
+
+  CHECK(menu.getDisplayError().length() == 0);
+  CHECK(&menu.getDisplayTransport() == &transport);
+  CHECK_EQ(Wire.getWriteCount(), 0u);           // display.begin() would send its init here
+  CHECK_EQ(Wire.writesWithoutBegin(), 0u);
+  CHECK(!Wire.isBegun());
+  CHECK(!wirePanel.isOn());
+
+  CHECK(panel.isOn());
+  CHECK_EQ(panel.getMemoryMode(), 0);           // horizontal, as sendWindow() expects
+  CHECK_EQ(panel.getContrast(), 0xCF);
+  CHECK_EQ(panel.getUnknownCommands(), 0u);
+  CHECK(framePBM(menu) == panelPBM(panel));
+}
+
+TEST(unusableTransportFallsBackToWire) {
+  Ssd1306Panel wirePanel, panel;
+  startDisplayBus(wirePanel);
+  PanelTransport transport(panel, DISPLAY_TRANSPORT_MAX_HZ, false);
+  Menu menu;
+  menu.setDisplayTransport(&transport);
+  bringUp(menu);
+
+  CHECK(&menu.getDisplayTransport() != &transport);
+  CHECK(Wire.isBegun());
+  CHECK_EQ(Wire.writesWithoutBegin(), 0u);
+  CHECK(wirePanel.isOn());
+  CHECK(!panel.isOn());
+  CHECK(framePBM(menu) == panelPBM(wirePanel));
+}
+
+// Full 1 KB frame through each transport, counted on the mock buses
+TEST(fullFrameOverheadMeasured) {
+  struct Row { const char* name; uint32_t transactions, bytes; uint64_t busUs; };
+  Row rows[3];
+
+  {
+    Ssd1306Panel panel;
+    startDisplayBus(panel);
+    Menu menu;
+    bringUp(menu);
+    Wire.resetCounters();
+    menu.getDisplayTransport().resetCounters();
+    menu.updateDisplay();
+    rows[0] = { "Wire, 128 B buffer, 400k", Wire.getTransactionCount(), Wire.getBytesWritten(), Wire.getBusTimeUs() };
+    CHECK_EQ(menu.getDisplayTransport().getTransactionCount(), rows[0].transactions);
+    CHECK_EQ(menu.getDisplayTransport().getBytesWritten(), rows[0].bytes);
+    CHECK(framePBM(menu) == panelPBM(panel));
+  }
+  {
+    Ssd1306Panel panel;
+    startDisplayBus(panel);
+    CountingDisplayTransport transport(32);     // AVR-sized Wire buffer
+    Menu menu;
+    menu.setDisplayTransport(&transport);
+    bringUp(menu);
+    transport.resetCounters();
+    menu.updateDisplay();
+    const uint64_t clocks = 9ULL * transport.getBytesWritten() + 3ULL * transport.getTransactionCount();
+    rows[1] = { "32 B buffer, 400k", transport.getTransactionCount(), transport.getBytesWritten(), clocks * 1000000 / 400000 };
+  }
+  {
+    Ssd1306Panel wirePanel, panel;
+    startDisplayBus(wirePanel);
+    PanelTransport transport(panel);
+    Menu menu;
+    menu.setDisplayTransport(&transport);
+    bringUp(menu);
+    transport.resetCounters();
+    const uint64_t before = transport.getBusTimeUs();
+    menu.updateDisplay();
+    rows[2] = { "one transaction, 1 MHz", transport.getTransactionCount(), transport.getBytesWritten(), transport.getBusTimeUs() - before };
+    CHECK(framePBM(menu) == panelPBM(panel));
+  }
+
+  for (uint8_t i = 0; i < 3; ++i) {
+    printf("  %-26s %3u transactions %5u bytes %6llu us on the bus\n",
+           rows[i].name, rows[i].transactions, rows[i].bytes, (unsigned long long)rows[i].busUs);
+  }
+  CHECK_EQ(rows[0].transactions, 10u);
+  CHECK_EQ(rows[0].bytes, 1050u);
+  CHECK_EQ(rows[1].transactions, 35u);
+  CHECK_EQ(rows[1].bytes, 1100u);
+  CHECK_EQ(rows[2].transactions, 1u);
+  CHECK_EQ(rows[2].bytes, 1038u);
+  CHECK(rows[2].busUs * 2 < rows[0].busUs);
+}
+
+HOST_TEST_MAIN("display_transport")
@@ -0,0 +1,81 @@
+// Flow meter on the GPIO-interrupt path, driven by a simulated 10 kHz pulse train.
+#include "HostTest.h"
+#include "FlowMeter.h"
+#include "Valve.h"
+
+static const uint8_t METER_PIN = 27, OPEN_PIN = 12, CLOSE_PIN = 13, LED_PIN = 2;
+
+// Pulses every periodUs for durationMs; service() and valve->update() once per ms
+static void runPulses(FlowMeter& meter, Valve* valve, uint32_t periodUs, uint32_t durationMs) {
+  uint32_t sinceEdge = 0;
+  for (uint32_t ms = 0; ms < durationMs; ++ms) {
+    for (uint32_t us = 0; us < 1000; us += 10) {
+      host::advanceUs(10);
+      sinceEdge += 10;
+      if (sinceEdge >= periodUs) { sinceEdge = 0; host::fireInterrupt(METER_PIN); }
+    }
+    meter.service();
+    if (valve) valve->update();
+  }
+}
+
+TEST(countsEveryPulseAt10kHz) {
+  host::reset();
+  FlowMeter meter(METER_PIN, 450);
+  CHECK(meter.begin());
+  CHECK(!meter.usesHardwareCounter());
+  CHECK(host::interruptAttached(METER_PIN));
+
+  runPulses(meter, nullptr, 100, 10000);
+  CHECK_EQ(meter.getPulseCount(), 100000);
+  CHECK_EQ(meter.getMillilitres(), 100000ULL * 1000 / 450);
+  CHECK_NEAR(meter.getFlowRate(), 10000.0 * 60 * 1000 / 450, 2000); // mL/min, EWMA settled
+}
+
+TEST(rateDropsToZeroWhenFlowStops) {
+  host::reset();
+  FlowMeter meter(METER_PIN, 450);
+  meter.begin();
+  runPulses(meter, nullptr, 100, 3000);
+  runPulses(meter, nullptr, 0xFFFFFFFF, 2100);
+  CHECK_EQ(meter.getFlowRate(), 0);
+}
+
+static uint32_t pulsesAtClose = 0;
+static void onTransition(void* ctx, Valve& valve) {
+  if (!valve.getState() && valve.isInTransition()) pulsesAtClose = static_cast<FlowMeter*>(ctx)->getPulseCount();
+}
+
+TEST(valveClosesOnVolume) {
+  host::reset();
+  FlowMeter meter(METER_PIN, 450);
+  meter.begin();
+  Valve valve(1, 1, 50, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  valve.setFlowMeter(&meter, 2000);             // 900 pulses
+  valve.setAutoCycle(false);
+  valve.requestOpen();
+  valve.setAutoCycle(true);                     // volume close is part of the auto cycle
+  valve.setTransitionHandler(&onTransition, &meter);
+
+  runPulses(meter, &valve, 100, 200);           // 50 ms drive pulse, then flow until the close
+  CHECK(!valve.getState());
+  CHECK(pulsesAtClose >= 900);
+  CHECK(pulsesAtClose <= 900 + 10);             // closed within one 1 ms service pass
+}
+
+TEST(destructorOnlyDetachesWhatBeginAttached) {
+  host::reset();
+  {
+    FlowMeter unused(METER_PIN);
+  }
+  CHECK_EQ(host::strayDetaches(), 0);
+  {
+    FlowMeter meter(METER_PIN);
+    meter.begin();
+    meter.begin();                              // second begin() must not stack handlers
+  }
+  CHECK(!host::interruptAttached(METER_PIN));
+  CHECK_EQ(host::strayDetaches(), 0);
+}
+
+HOST_TEST_MAIN("flowmeter")
@@ -0,0 +1,107 @@
+// Vertical-counter debounce: driven through setMockInputs(), one scan at a time.
+#include "HostTest.h"
+#include "InputScanner.h"
+
+static const uint8_t BUTTON = 0, LIMIT = 4, HIGH_BANK = 35;
+
+// Active-low pins idle HIGH: raw word with the given pins pulled LOW
+static uint32_t lowPins(uint32_t mask) { return ~mask; }
+
+TEST(firstScanAdoptsLevelsWithoutEdges) {
+  InputScanner inputs;
+  inputs.addInput(BUTTON);
+  inputs.addInput(LIMIT);
+  inputs.setMockInputs(lowPins(1UL << LIMIT));  // valve already at its stop at boot
+  inputs.scan();
+  CHECK(!inputs.isActive(BUTTON));
+  CHECK(inputs.isActive(LIMIT));
+  CHECK_EQ(inputs.getRisingMask(), 0ULL);
+  CHECK_EQ(inputs.getFallingMask(), 0ULL);
+  CHECK_EQ(inputs.getInputMask(), (1ULL << BUTTON) | (1ULL << LIMIT));
+}
+
+TEST(flipsAfterFourAgreeingScans) {
+  InputScanner inputs;
+  inputs.addInput(BUTTON);
+  inputs.setMockInputs(lowPins(0));
+  inputs.scan();
+
+  inputs.setMockInputs(lowPins(1UL << BUTTON));
+  for (uint8_t i = 0; i < 3; ++i) {
+    inputs.scan();
+    CHECK(!inputs.isActive(BUTTON));
+    CHECK(!inputs.pressed(BUTTON));
+  }
+  inputs.scan();                                // 4th scan: debounced
+  CHECK(inputs.isActive(BUTTON));
+  CHECK(inputs.pressed(BUTTON));
+  CHECK_EQ(inputs.getRisingMask(), 1ULL << BUTTON);
+  CHECK_EQ(inputs.getFallingMask(), 0ULL);
+
+  inputs.scan();                                // edge lasts one scan
+  CHECK(inputs.isActive(BUTTON));
+  CHECK(!inputs.pressed(BUTTON));
+  CHECK_EQ(inputs.getRisingMask(), 0ULL);
+
+  inputs.setMockInputs(lowPins(0));
+  for (uint8_t i = 0; i < 3; ++i) inputs.scan();
+  CHECK(inputs.isActive(BUTTON));
+  inputs.scan();
+  CHECK(!inputs.isActive(BUTTON));
+  CHECK(inputs.released(BUTTON));
+  CHECK_EQ(inputs.getFallingMask(), 1ULL << BUTTON);
+}
+
+TEST(bounceRestartsTheCount) {
+  InputScanner inputs;
+  inputs.addInput(BUTTON);
+  inputs.setMockInputs(lowPins(0));
+  inputs.scan();
+
+  // Contact bounce: 3 scans closed, 1 open, repeatedly; never 4 in a row
+  for (uint8_t cycle = 0; cycle < 10; ++cycle) {
+    inputs.setMockInputs(lowPins(1UL << BUTTON));
+    for (uint8_t i = 0; i < 3; ++i) inputs.scan();
+    inputs.setMockInputs(lowPins(0));
+    inputs.scan();
+    CHECK(!inputs.isActive(BUTTON));
+    CHECK_EQ(inputs.getRisingMask(), 0ULL);
+  }
+  // Then it settles
+  inputs.setMockInputs(lowPins(1UL << BUTTON));
+  for (uint8_t i = 0; i < 4; ++i) inputs.scan();
+  CHECK(inputs.pressed(BUTTON));
+}
+
+TEST(pinsCountIndependentlyAcrossBanks) {
+  InputScanner inputs;
+  inputs.addInput(BUTTON);
+  inputs.addInput(LIMIT, false, false);         // active high, external pull-down
+  inputs.addInput(HIGH_BANK);
+  const uint32_t idle0 = lowPins(1UL << LIMIT); // button released, limit open
+  inputs.setMockInputs(idle0, lowPins(0));
+  inputs.scan();
+  CHECK_EQ(inputs.getActiveMask(), 0ULL);
+
+  // Button goes down two scans before the limit and the bank 1 pin
+  inputs.setMockInputs(idle0 & ~(1UL << BUTTON), lowPins(0));
+  inputs.scan();
+  inputs.scan();
+  inputs.setMockInputs((idle0 & ~(1UL << BUTTON)) | (1UL << LIMIT), lowPins(1UL << (HIGH_BANK - 32)));
+  inputs.scan();
+  inputs.scan();
+  CHECK_EQ(inputs.getRisingMask(), 1ULL << BUTTON);
+  inputs.scan();
+  CHECK_EQ(inputs.getRisingMask(), 0ULL);
+  inputs.scan();
+  CHECK_EQ(inputs.getRisingMask(), (1ULL << LIMIT) | (1ULL << HIGH_BANK));
+  CHECK_EQ(inputs.getActiveMask(), (1ULL << BUTTON) | (1ULL << LIMIT) | (1ULL << HIGH_BANK));
+
+  // All lines low: active-low pins stay active, the active-high limit drops; unregistered pins never show
+  inputs.setMockInputs(0, 0);
+  for (uint8_t i = 0; i < 4; ++i) inputs.scan();
+  CHECK_EQ(inputs.getFallingMask(), 1ULL << LIMIT);
+  CHECK_EQ(inputs.getActiveMask(), (1ULL << BUTTON) | (1ULL << HIGH_BANK));
+}
+
+HOST_TEST_MAIN("inputscanner")
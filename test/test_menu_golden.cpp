@@ -0,0 +1,144 @@
+// Menu frames compared against golden PBMs, and the panel model against the frame buffer.
+#include "HostTest.h"
+#include "MenuHarness.h"
+
+static const char* const sketchItems[] = {
+  "Device Status", "Adjust time", "Open Valve", "Close Valve", "Diagnostics", "Trends"
+};
+
+// Same setup as ValveTimer.ino
+static void configureLikeSketch(MenuBase& menu) {
+  menu.initializeDisplay();
+  menu.borrowMenuItems(sketchItems, 6);
+  menu.setMenuTitle("Valve Timer", 1);
+  menu.setMenuSubtitle("Valve Countdown.", 1);
+  menu.setColumnNumberOfCharacters(14);
+  menu.setMenuItemScrolling(true);
+  menu.setMarqueeEnabled(true);
+  menu.setMarqueeMode(Menu::MarqueeMode::AllOverflow);
+  menu.setMarqueeSpeed(60);
+  menu.setSmoothScrollEnabled(true);
+  menu.setScrollSpeed(120);
+  menu.setPageTransition(Menu::TransitionType::Slide, 280);
+}
+
+static void checkFrame(const char* golden, const MenuBase& menu, const Ssd1306Panel& panel) {
+  const std::string frame = framePBM(menu);
+  CHECK(matchesGolden(golden, frame));
+  CHECK(frame == panelPBM(panel));    // every changed pixel reached the panel
+}
+
+TEST(sketchMainPage) {
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  FixedMenu<128, 64, 3, 2, false, true> menu;
+  configureLikeSketch(menu);
+  menu.setPrerenderEnabled(true);
+  menu.showMenu();
+  CHECK(panel.isOn());
+  CHECK_EQ(panel.getUnknownCommands(), 0);
+  checkFrame("sketch_main", menu, panel);
+
+  menu.nextItem();
+  runFrames(menu, 20);
+  checkFrame("sketch_main_item1", menu, panel);
+
+  // Frame buffer, canvases and the borrowed item table are not on the heap: only the titles are
+  const uint32_t titles = uint32_t(strlen("Valve Timer") + strlen("Valve Countdown."));
+  Menu::MemoryUsage m = menu.getMemoryUsage();
+  CHECK_EQ(m.frameBuffer, 1024u);
+  CHECK_EQ(m.heap, titles);
+
+  // setMenuItems() copies the table, as on Menu
+  menu.setMenuItems(sketchItems, 6);
+  m = menu.getMemoryUsage();
+  CHECK_EQ(m.heap, uint32_t(titles + 6 * sizeof(const char*)));
+}
+
+TEST(invertedSelectionSingleColumn) {
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  Menu menu;
+  configureLikeSketch(menu);
+  menu.setMenuColumns(1);
+  menu.setMenuRows(5);
+  menu.setColumnNumberOfCharacters(21);
+  menu.setSelectedItemInverted(true);
+  menu.setCurrentItemIndex(2);
+  menu.showMenu();
+  runFrames(menu, 2);
+  checkFrame("inverted_1col", menu, panel);
+}
+
+TEST(marqueeAfterTwoSeconds) {
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  NumberedRows rows(40);
+  Menu menu;
+  configureLikeSketch(menu);
+  menu.setMenuItems(&rows);
+  menu.setMenuColumns(1);
+  menu.setMenuRows(5);
+  menu.setCurrentItemIndex(4);        // the long row
+  menu.showMenu();
+  runFrames(menu, 100);               // 2 s of 20 ms frames: past the edge pause
+  checkFrame("marquee_2s", menu, panel);
+}
+
+TEST(slideAndFadeMidFrames) {
+  const Menu::TransitionType types[] = { Menu::TransitionType::Slide, Menu::TransitionType::Fade };
+  const char* names[] = { "slide_mid", "fade_mid" };
+  for (uint8_t t = 0; t < 2; ++t) {
+    Ssd1306Panel panel;
+    startDisplayBus(panel);
+    NumberedRows rows(40);
+    Menu menu;
+    configureLikeSketch(menu);
+    menu.setMenuItems(&rows);
+    menu.setMenuColumns(1);
+    menu.setMenuRows(5);
+    menu.setPageTransition(types[t], 300);
+    menu.setCurrentItemIndex(4);
+    menu.showMenu();
+    runFrames(menu, 2);
+    menu.nextItem();                  // row 5: next page
+    runFrames(menu, 8);               // 160 ms into 300
+    checkFrame(names[t], menu, panel);
+    runFrames(menu, 20);
+    checkFrame(t ? "fade_end" : "slide_end", menu, panel);
+  }
+}
+
+static uint32_t secondsLeft(void*) { return 754; }
+static bool     isOpen(void*)      { return true; }
+static int32_t  heapKb(void*)      { return 187; }
+
+TEST(widgetPage) {
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  Menu menu;
+  configureLikeSketch(menu);
+  CountdownWidget countdown(0, 16, 12, "V1 next", secondsLeft, nullptr);
+  IndicatorWidget state(78, 16, 8, "", isOpen, nullptr, "OPEN", "CLOSED");
+  NumberWidget    heap(0, 32, 21, "Heap free", heapKb, nullptr, " KB");
+  MenuWidget* const widgets[] = { &countdown, &state, &heap };
+  menu.showMenu();
+  menu.setWidgets(widgets, 3);
+  runFrames(menu, 2);
+  checkFrame("widgets", menu, panel);
+
+  menu.clearWidgets();
+  runFrames(menu, 2);
+  checkFrame("widgets_cleared", menu, panel);
+}
+
+TEST(statusBarLayout) {
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  FixedMenu<128, 64, 4, 2, true> menu;
+  configureLikeSketch(menu);
+  menu.showMenu();
+  checkFrame("status_bar", menu, panel);
+}
+
+HOST_TEST_MAIN("menu_golden")
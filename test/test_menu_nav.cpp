@@ -0,0 +1,169 @@
+// Navigation during animations: presses merge into one move, press-to-pixel latency within a frame.
+#include "HostTest.h"
+#include "MenuHarness.h"
+#include "Scheduler.h"
+
+typedef FixedMenu<128, 64, 3, 2, false, true> SketchMenu;   // ValveTimer.ino's mainMenu
+
+static const uint32_t FRAME_US = 20000;   // ui/flush period in the sketch
+static const uint16_t SLIDE_MS = 280;
+
+// The sketch's layout on 30 numbered rows (5 pages of 6); no marquee so frames compare exactly
+static void configure(SketchMenu& menu, NumberedRows& rows) {
+  menu.initializeDisplay();
+  menu.setBusClock(1000000);                // IDF driver speed in the sketch
+  menu.setMenuItems(&rows);
+  menu.setMenuTitle("Valve Timer", 1);
+  menu.setColumnNumberOfCharacters(14);
+  menu.setMenuItemScrolling(true);
+  menu.setSmoothScrollEnabled(true);
+  menu.setPageTransition(Menu::TransitionType::Slide, SLIDE_MS);
+  menu.setPrerenderEnabled(true);
+  menu.showMenu();
+}
+
+static uint32_t pageChanges(const MenuBase& menu) {
+  const Menu::RenderStats& r = menu.getRenderStats();
+  return r.prerenderHits + r.prerenderMisses;
+}
+
+// The frame a menu settled on the same item draws, for comparison
+static std::string settledFrame(uint16_t index) {
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  NumberedRows rows(30);
+  SketchMenu menu;
+  configure(menu, rows);
+  menu.setCurrentItemIndex(index);
+  runFrames(menu, 2);
+  return framePBM(menu);
+}
+
+TEST(pressesDuringSlideMergeIntoOneMove) {
+  const std::string expected = settledFrame(20);
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  NumberedRows rows(30);
+  SketchMenu menu;
+  configure(menu, rows);
+  menu.setCurrentItemIndex(5);
+  runFrames(menu, 2);
+  menu.resetRenderStats();
+
+  menu.nextItem();                          // 5 -> 6: slide to page 1
+  runFrames(menu, 3);
+  CHECK_EQ(pageChanges(menu), 1u);
+  for (uint8_t i = 0; i < 13; ++i) menu.nextItem();   // mid-slide: queued, not restarted
+  CHECK_EQ(menu.getCurrentItemIndex(), 6);
+  CHECK_EQ(pageChanges(menu), 1u);
+  runFrames(menu, 2);                       // one short slide straight to page 3
+  CHECK_EQ(menu.getCurrentItemIndex(), 19);
+  CHECK_EQ(pageChanges(menu), 2u);
+  menu.nextItem();
+  menu.nextItem();
+  menu.previousItem();                      // during that slide too: net +1, same page
+  runFrames(menu, 1);
+  CHECK_EQ(menu.getCurrentItemIndex(), 20); // 5 + 1 + 13 + 2 - 1
+  CHECK_EQ(pageChanges(menu), 2u);
+
+  runFrames(menu, 20);
+  CHECK_EQ(menu.getCurrentItemIndex(), 20);
+  CHECK_EQ(pageChanges(menu), 2u);          // three pages crossed, two slides in all
+  CHECK(framePBM(menu) == expected);
+  CHECK(framePBM(menu) == panelPBM(panel));
+  CHECK(menu.getRenderStats().navLatencyMaxUs <= FRAME_US);
+}
+
+// Each flushed frame closes the latency of the presses it shows; one that came after its render waits
+TEST(latencyRunsFromThePressTheFrameShows) {
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  NumberedRows rows(30);
+  SketchMenu menu;
+  configure(menu, rows);
+  menu.setCurrentItemIndex(5);
+  runFrames(menu, 2);
+  menu.nextItem();                          // slide to page 1
+  runFrames(menu, 2);
+  menu.resetRenderStats();
+
+  menu.nextItem();                          // A, queued behind the slide
+  host::advanceMs(3);
+  menu.tick();
+  menu.renderMenu();
+  menu.nextItem();                          // B, after the render: not in this frame
+  host::advanceMs(4);
+  menu.flushDisplay();
+  CHECK_EQ(menu.getRenderStats().navLatencyLastUs, 7000u);
+  host::advanceMs(13);
+  menu.tick();
+  menu.renderMenu();
+  menu.flushDisplay();
+  CHECK_EQ(menu.getRenderStats().navLatencyLastUs, 17000u);   // from B
+  CHECK_EQ(menu.getRenderStats().navLatencyMaxUs, 17000u);
+  CHECK_EQ(menu.getCurrentItemIndex(), 8);
+}
+
+// --- the sketch's loop: a press wakes ui, ui wakes flush, flush sends 2 pages per slice ---
+static SketchMenu* navMenu = nullptr;
+static Scheduler*  sched   = nullptr;
+static int8_t      uiId = -1, flushId = -1;
+
+static void serviceUi(void*) {
+  navMenu->tick();
+  navMenu->renderMenu();
+  sched->wake(uint8_t(flushId));
+}
+
+// A slice holds the loop for as long as its bytes take on the bus
+static void serviceFlush(void*) {
+  const uint64_t busUs = Wire.getBusTimeUs();
+  const bool done = navMenu->flushDisplay(2);
+  host::advanceUs(uint32_t(Wire.getBusTimeUs() - busUs));
+  if (!done) sched->wake(uint8_t(flushId));
+}
+
+static void loopUntil(uint64_t us) {
+  while (host::nowUs() < us) {
+    sched->run();
+    host::advanceUs(100);
+  }
+}
+
+TEST(slicedFlushKeepsLatencyWithinAFrame) {
+  const std::string expected = settledFrame(12);
+  Ssd1306Panel panel;
+  startDisplayBus(panel);
+  NumberedRows rows(30);
+  SketchMenu menu;
+  configure(menu, rows);
+  menu.setCurrentItemIndex(5);
+  Scheduler s;
+  navMenu = &menu;
+  sched   = &s;
+  uiId    = s.addTask("ui", serviceUi, nullptr, 2, FRAME_US, 4000);
+  flushId = s.addTask("flush", serviceFlush, nullptr, 3, FRAME_US, 6000, true);
+  loopUntil(100000);
+  menu.resetRenderStats();
+
+  // Presses 7 ms apart, landing anywhere in the frame and the slices: +1 x9, -1 x2 while slides run
+  const int8_t presses[] = { +1, +1, +1, +1, -1, +1, +1, +1, +1, -1, +1 };
+  int16_t net = 0;
+  for (uint8_t i = 0; i < sizeof(presses); ++i) {
+    if (presses[i] > 0) menu.nextItem();
+    else                menu.previousItem();
+    s.wake(uint8_t(uiId));                  // as handleButtons() does
+    net += presses[i];
+    loopUntil(host::nowUs() + 7000);
+  }
+  loopUntil(host::nowUs() + 500000);
+
+  CHECK_EQ(menu.getCurrentItemIndex(), 5 + net);
+  CHECK(framePBM(menu) == expected);
+  CHECK(framePBM(menu) == panelPBM(panel));
+  const Menu::RenderStats& r = menu.getRenderStats();
+  CHECK(r.navLatencyMaxUs > 0);             // measured to the last slice, not the render
+  CHECK(r.navLatencyMaxUs <= FRAME_US);
+}
+
+HOST_TEST_MAIN("menu_nav")
@@ -0,0 +1,199 @@
+// Output drivers: one bus transaction per commit, counted on the host Wire/SPI stand-ins, and
+// the GPIO register stores of FixedGpioOutputDriver as GpioOutputRegs sees them.
+#include "HostTest.h"
+#include <SPI.h>
+#include <Wire.h>
+#include "OutputDriver.h"
+#include "Valve.h"
+
+struct Frame { uint8_t addr; uint8_t bytes[4]; size_t len; };
+static Frame frames[16];
+static size_t frameCount = 0;
+
+static void recordFrame(void*, uint8_t addr, const uint8_t* data, size_t len) {
+  if (frameCount >= 16) return;
+  Frame& f = frames[frameCount++];
+  f.addr = addr;
+  f.len  = len;
+  memcpy(f.bytes, data, len < 4 ? len : 4);
+}
+
+static void startBus() {
+  host::reset();
+  Wire.begin();
+  Wire.attachDevice(&recordFrame, nullptr);
+  Wire.resetCounters();
+  frameCount = 0;
+}
+
+TEST(mcpCommitIsOneTransaction) {
+  startBus();
+  Mcp23017Driver driver(4);
+  driver.begin();
+  Wire.resetCounters();
+  driver.resetCounters();
+  frameCount = 0;
+
+  driver.write(0, HIGH);          // chip 0, port A
+  driver.write(17, HIGH);         // chip 1, port A
+  driver.write(63, HIGH);         // chip 3, port B
+  driver.commit();
+
+  CHECK_EQ(Wire.getTransactionCount(), 1);   // one STOP
+  CHECK_EQ(Wire.getWriteCount(), 3);         // chips joined by repeated STARTs
+  CHECK_EQ(Wire.getBytesWritten(), 3 * 4);   // address + OLATA + two latches each
+  CHECK_EQ(driver.getTransactionCount(), 1);
+  CHECK_EQ(driver.getBytesWritten(), 9);
+  CHECK_EQ(frameCount, 3);
+  CHECK_EQ(frames[0].addr, 0x20);
+  CHECK_EQ(frames[0].bytes[1], 0x01);
+  CHECK_EQ(frames[1].addr, 0x21);
+  CHECK_EQ(frames[1].bytes[1], 0x02);
+  CHECK_EQ(frames[2].addr, 0x23);
+  CHECK_EQ(frames[2].bytes[2], 0x80);
+  CHECK_EQ(Wire.writesWithoutBegin(), 0);
+}
+
+TEST(mcpUnchangedCommitIsFree) {
+  startBus();
+  Mcp23017Driver driver(2);
+  driver.begin();
+  driver.write(3, HIGH);
+  driver.commit();
+  Wire.resetCounters();
+
+  driver.write(3, HIGH);          // same level: nothing staged
+  driver.commit();
+  CHECK_EQ(Wire.getTransactionCount(), 0);
+  CHECK_EQ(Wire.getWriteCount(), 0);
+}
+
+// A commit the bus rejects keeps its bytes dirty: counted once, resent by the next commit
+TEST(mcpFailedCommitIsRetried) {
+  startBus();
+  Mcp23017Driver driver(2);
+  driver.begin();
+  driver.resetCounters();
+  Wire.end();                     // endTransmission() now fails as on an unbegun bus
+  frameCount = 0;
+
+  driver.write(9, HIGH);          // chip 0, port B
+  driver.commit();
+  CHECK_EQ(driver.getFailureCount(), 1);
+  CHECK_EQ(frameCount, 0);
+
+  Wire.begin();
+  driver.commit();                // nothing new staged: the failed bytes go out
+  CHECK_EQ(driver.getFailureCount(), 1);
+  CHECK_EQ(frameCount, 1);
+  CHECK_EQ(frames[0].addr, 0x20);
+  CHECK_EQ(frames[0].bytes[2], 0x02);
+  driver.commit();                // sent: clean again
+  CHECK_EQ(frameCount, 1);
+}
+
+TEST(shiftRegister64ValvesOneBurst) {
+  host::reset();
+  ShiftRegisterDriver driver(23, 18, 5, 24);
+  driver.begin();
+  SPI.resetCounters();
+  driver.resetCounters();
+
+  Valve* valves[64];
+  for (uint8_t i = 0; i < 64; ++i) {
+    valves[i] = new Valve(1, 1, 3000, driver, uint8_t(i * 3), uint8_t(i * 3 + 1), uint8_t(i * 3 + 2));
+    valves[i]->setAutoCycle(false);
+  }
+  driver.commit();
+  SPI.resetCounters();
+
+  for (uint8_t i = 0; i < 64; ++i) valves[i]->requestOpen();  // one service pass
+  driver.commit();
+
+  CHECK_EQ(SPI.getTransactionCount(), 1);
+  CHECK_EQ(SPI.getBytesWritten(), 24);
+  // Open + LED set for every valve: 0b101 repeating, last chip shifted out first
+  const uint8_t* burst = SPI.getLastBurst();
+  CHECK_EQ(burst[23], 0x6D);      // image[0]: channels 0..7 = open0, close0, led0, open1, ...
+  CHECK_EQ(burst[0], 0xB6);       // image[23]
+  for (uint8_t i = 0; i < 64; ++i) delete valves[i];
+}
+
+struct Store { uint8_t bank; uint32_t set; uint32_t clear; };
+static Store stores[16];
+static size_t storeCount = 0;
+
+static void recordStore(uint8_t bank, uint32_t setMask, uint32_t clearMask) {
+  if (storeCount >= 16) return;
+  stores[storeCount++] = Store{ bank, setMask, clearMask };
+}
+
+static void startStores() {
+  GpioOutputRegs::onStore = &recordStore;
+  storeCount = 0;
+}
+
+// Open, pulse end, close, pulse end on a valve with all three pins in bank 0
+TEST(fixedValveStoreSequence) {
+  host::reset();
+  FixedValve<12, 13, 2> valve(1, 1, 3000);
+  valve.setAutoCycle(false);
+  valve.update();                   // first service configures the pins
+  startStores();
+
+  valve.requestOpen();              // drive + LED on: one w1ts
+  CHECK_EQ(storeCount, 1);
+  CHECK_EQ(stores[0].bank, 0);
+  CHECK_EQ(stores[0].set, (1UL << 12) | (1UL << 2));
+  CHECK_EQ(stores[0].clear, 0u);
+
+  host::advanceMs(3000);
+  valve.update();                   // pulse over: one w1tc of the drive pin, LED stays on
+  CHECK_EQ(storeCount, 2);
+  CHECK_EQ(stores[1].set, 0u);
+  CHECK_EQ(stores[1].clear, 1UL << 12);
+
+  valve.requestClose();             // close pin on, LED off: w1ts then w1tc
+  CHECK_EQ(storeCount, 4);
+  CHECK_EQ(stores[2].set, 1UL << 13);
+  CHECK_EQ(stores[2].clear, 0u);
+  CHECK_EQ(stores[3].set, 0u);
+  CHECK_EQ(stores[3].clear, 1UL << 2);
+
+  host::advanceMs(3000);
+  valve.update();
+  CHECK_EQ(storeCount, 5);
+  CHECK_EQ(stores[4].clear, 1UL << 13);
+  CHECK_EQ(GpioOutputRegs::latch[0] & ((1UL << 12) | (1UL << 13) | (1UL << 2)), 0u);
+  GpioOutputRegs::onStore = nullptr;
+}
+
+// LED in bank 1: one store per bank, never a read-modify-write of the other bank
+TEST(fixedValveLedInUpperBank) {
+  host::reset();
+  FixedValve<14, 15, 33> valve(1, 1, 3000);
+  valve.setAutoCycle(false);
+  valve.update();                   // first service configures the pins
+  startStores();
+
+  valve.requestOpen();
+  CHECK_EQ(storeCount, 2);
+  CHECK_EQ(stores[0].bank, 0);
+  CHECK_EQ(stores[0].set, 1UL << 14);
+  CHECK_EQ(stores[1].bank, 1);
+  CHECK_EQ(stores[1].set, 1UL << 1);
+  CHECK(GpioOutputRegs::latch[1] & (1UL << 1));
+
+  host::advanceMs(3000);
+  valve.update();
+  valve.requestClose();
+  CHECK_EQ(storeCount, 5);          // + drive clear, close set (bank 0), LED clear (bank 1)
+  CHECK_EQ(stores[3].bank, 0);
+  CHECK_EQ(stores[3].set, 1UL << 15);
+  CHECK_EQ(stores[4].bank, 1);
+  CHECK_EQ(stores[4].clear, 1UL << 1);
+  CHECK_EQ(GpioOutputRegs::latch[1] & (1UL << 1), 0u);
+  GpioOutputRegs::onStore = nullptr;
+}
+
+HOST_TEST_MAIN("outputs")
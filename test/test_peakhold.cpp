@@ -0,0 +1,114 @@
+// Peak-and-hold solenoid drive: LEDC duty timeline against the virtual clock.
+#include "HostTest.h"
+#include "Valve.h"
+
+struct DutyEvent { uint32_t ms; uint8_t pin; uint32_t duty; };
+
+static DutyEvent events[16];
+static uint8_t   eventCount;
+
+static void onDuty(void*, uint8_t pin, uint32_t duty) {
+  if (eventCount < 16) events[eventCount++] = { uint32_t(millis()), pin, duty };
+}
+
+static void startTimeline() {
+  host::reset();
+  host::setDutyHook(&onDuty, nullptr);
+  eventCount = 0;
+}
+
+static void runMs(Valve& valve, uint32_t ms) {
+  for (uint32_t i = 0; i < ms; ++i) { host::advanceMs(1); valve.update(); }
+}
+
+static void checkEvent(uint8_t i, uint32_t ms, uint8_t pin, uint32_t duty) {
+  CHECK(i < eventCount);
+  if (i >= eventCount) return;
+  CHECK_EQ(events[i].ms, ms);
+  CHECK_EQ(events[i].pin, pin);
+  CHECK_EQ(events[i].duty, duty);
+}
+
+// Each case uses its own coil pin: the shared GPIO driver remembers which pins it attached to LEDC
+
+TEST(pullInThenHoldThenRelease) {
+  const uint8_t COIL = 16, LED = 2;
+  startTimeline();
+  Valve valve(1, 1, 500, COIL, VALVE_NO_PIN, LED);
+  valve.setAutoCycle(false);
+  valve.setDriveMode(Valve::DriveMode::PeakHold, 150, 77);
+  checkEvent(0, 0, COIL, 0);                    // closed: coil off in the new mode
+
+  host::advanceMs(1000);
+  valve.requestOpen();
+  checkEvent(1, 1000, COIL, 255);               // full duty for the pull-in
+  CHECK_EQ(host::pinLevel(LED), HIGH);
+  runMs(valve, 149);
+  CHECK_EQ(eventCount, 2);
+  CHECK_EQ(host::ledcDuty(COIL), 255u);
+  runMs(valve, 1);
+  checkEvent(2, 1150, COIL, 77);                // then hold
+  runMs(valve, 5000);
+  CHECK_EQ(eventCount, 3);                      // hold is written once, not every update()
+
+  valve.requestClose();
+  checkEvent(3, 6150, COIL, 0);                 // release on close
+  CHECK_EQ(host::pinLevel(LED), LOW);
+  runMs(valve, 500);
+  CHECK_EQ(eventCount, 4);
+  CHECK(!valve.isInTransition());
+}
+
+TEST(closeDuringPullInSkipsHold) {
+  const uint8_t COIL = 17;
+  startTimeline();
+  Valve valve(1, 1, 500, COIL, VALVE_NO_PIN, VALVE_NO_PIN);
+  valve.setAutoCycle(false);
+  valve.setDriveMode(Valve::DriveMode::PeakHold, 150, 77);
+  eventCount = 0;
+
+  valve.requestOpen();
+  runMs(valve, 100);
+  valve.requestClose();
+  runMs(valve, 500);
+  CHECK_EQ(eventCount, 2);
+  checkEvent(0, 0, COIL, 255);
+  checkEvent(1, 100, COIL, 0);                  // no late hold write re-energises the coil
+  CHECK_EQ(host::ledcDuty(COIL), 0u);
+}
+
+TEST(autoCycleRepeatsTheTimeline) {
+  const uint8_t COIL = 18;
+  startTimeline();
+  Valve valve(1, 1, 500, COIL, VALVE_NO_PIN, VALVE_NO_PIN);  // 1 min open, 1 min closed
+  valve.setDriveMode(Valve::DriveMode::PeakHold, 200, 64);
+  eventCount = 0;
+
+  runMs(valve, 4 * 60000UL);
+  CHECK_EQ(eventCount, 6);                      // two cycles of 255, 64, 0
+  for (uint8_t c = 0; c < 2 && eventCount >= 6; ++c) {
+    const uint32_t t0 = events[3 * c].ms;
+    checkEvent(3 * c,     t0,         COIL, 255);
+    checkEvent(3 * c + 1, t0 + 200,   COIL, 64);
+    checkEvent(3 * c + 2, t0 + 60000, COIL, 0);
+  }
+}
+
+TEST(restoreWhileOpenPullsInAgain) {
+  const uint8_t COIL = 19;
+  startTimeline();
+  Valve valve(1, 1, 500, COIL, VALVE_NO_PIN, VALVE_NO_PIN);
+  valve.setAutoCycle(false);
+  valve.setDriveMode(Valve::DriveMode::PeakHold, 150, 77);
+  Valve::Snapshot snapshot = valve.getSnapshot();
+  snapshot.flags = Valve::SNAPSHOT_OPEN;
+  eventCount = 0;
+
+  valve.restoreSnapshot(snapshot, 0);
+  runMs(valve, 200);
+  CHECK_EQ(eventCount, 2);
+  checkEvent(0, 0, COIL, 255);                  // a hold duty alone would not pull the armature in
+  checkEvent(1, 150, COIL, 77);
+}
+
+HOST_TEST_MAIN("peakhold")
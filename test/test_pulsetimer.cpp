@@ -0,0 +1,93 @@
+// Pulse-width error of timer-ended valve pulses across 32 valves, against loop timing.
+#include "HostTest.h"
+#include "Valve.h"
+
+static const uint8_t  VALVES        = 32;
+static const uint16_t CYCLE_MS      = 500;
+static const uint32_t LATENCY_US    = 25;   // esp_timer task dispatch per callback
+static const uint32_t SERVICE_MS    = 10;   // serviceValves period in the sketch
+
+static uint64_t startUs[64];
+static uint64_t endUs[64];
+
+static void onStore(uint8_t bank, uint32_t, uint32_t clearMask) {
+  for (uint8_t b = 0; b < 32; ++b) if (clearMask & (1UL << b)) endUs[bank * 32 + b] = host::nowUs();
+}
+static void onPin(void*, uint8_t pin, uint8_t level) {
+  if (level == HIGH) startUs[pin] = host::nowUs();
+  else if (!endUs[pin]) endUs[pin] = host::nowUs();
+}
+
+struct Stats { int32_t minUs, maxUs; double avgUs; };
+
+static Stats widthErrors() {
+  Stats s = { INT32_MAX, INT32_MIN, 0 };
+  for (uint8_t v = 0; v < VALVES; ++v) {
+    const int32_t err = int32_t(int64_t(endUs[v] - startUs[v]) - CYCLE_MS * 1000LL);
+    s.minUs = min(s.minUs, err);
+    s.maxUs = max(s.maxUs, err);
+    s.avgUs += double(err) / VALVES;
+  }
+  return s;
+}
+
+// All valves opened in one service pass; update() every SERVICE_MS until every pulse is over
+static Stats runBank(bool hardwareTiming, bool staggered) {
+  host::reset();
+  host::setTimerLatencyUs(LATENCY_US);
+  host::setPinHook(&onPin, nullptr);
+  GpioOutputRegs::onStore = &onStore;
+  memset(startUs, 0, sizeof(startUs));
+  memset(endUs, 0, sizeof(endUs));
+
+  Valve* valves[VALVES];
+  for (uint8_t v = 0; v < VALVES; ++v) {
+    valves[v] = new Valve(1, 1, CYCLE_MS, uint8_t(v), uint8_t(32 + v), VALVE_NO_PIN);
+    valves[v]->setAutoCycle(false);
+    valves[v]->setHardwarePulseTiming(hardwareTiming);
+  }
+  for (uint8_t v = 0; v < VALVES; ++v) {
+    valves[v]->requestOpen();
+    if (staggered) host::advanceUs(1000 + 37 * v);  // no two pulses end together
+  }
+  for (uint32_t ms = 0; ms < CYCLE_MS + 200; ms += SERVICE_MS) {
+    host::advanceMs(SERVICE_MS);
+    for (uint8_t v = 0; v < VALVES; ++v) valves[v]->update();
+  }
+  bool allDone = true;
+  for (uint8_t v = 0; v < VALVES; ++v) allDone &= !valves[v]->isInTransition() && host::pinLevel(v) == LOW;
+  CHECK(allDone);
+  if (hardwareTiming) {
+    for (uint8_t v = 0; v < VALVES; ++v) CHECK_EQ(valves[v]->getLastPulseErrorUs(), int32_t(int64_t(endUs[v] - startUs[v]) - CYCLE_MS * 1000LL));
+  }
+  for (uint8_t v = 0; v < VALVES; ++v) delete valves[v];
+  GpioOutputRegs::onStore = nullptr;
+  return widthErrors();
+}
+
+static void report(const char* mode, const Stats& s) {
+  printf("  %-26s width error min %6d us  avg %7.1f us  max %6d us\n", mode, s.minUs, s.avgUs, s.maxUs);
+}
+
+TEST(timerEndsEachPulseAfterDispatchLatency) {
+  const Stats s = runBank(true, true);
+  report("esp_timer, staggered", s);
+  CHECK_EQ(s.minUs, (int32_t)LATENCY_US);
+  CHECK_EQ(s.maxUs, (int32_t)LATENCY_US);
+}
+
+TEST(simultaneousExpiriesQueueOnTheTimerTask) {
+  const Stats s = runBank(true, false);
+  report("esp_timer, all at once", s);
+  CHECK_EQ(s.minUs, (int32_t)LATENCY_US);
+  CHECK_EQ(s.maxUs, (int32_t)(VALVES * LATENCY_US));   // the 32nd callback waits for the 31 before it
+}
+
+TEST(loopTimingIsBoundByTheServicePeriod) {
+  const Stats s = runBank(false, true);
+  report("update() every 10 ms", s);
+  CHECK(s.maxUs - s.minUs > (int32_t)(20 * LATENCY_US));   // loop jitter dwarfs the timer's
+  CHECK(s.maxUs <= (int32_t)(SERVICE_MS * 1000));
+}
+
+HOST_TEST_MAIN("pulsetimer")
@@ -0,0 +1,70 @@
+// Cooperative scheduler on the virtual clock: split work via wake(), start-latency bounds.
+#include "HostTest.h"
+#include "Scheduler.h"
+
+static Scheduler* sched = nullptr;
+
+// Frame flush in 4 slices of 1 ms, waking itself until the frame is out (like serviceFlush)
+struct SlicedTask {
+  int8_t   id = -1;
+  uint8_t  slice = 0;
+  uint32_t startUs[16];
+  uint8_t  starts = 0;
+};
+
+static void runSlice(void* ctx) {
+  SlicedTask& t = *static_cast<SlicedTask*>(ctx);
+  if (t.starts < 16) t.startUs[t.starts++] = micros();
+  host::advanceUs(1000);
+  if (++t.slice < 4) sched->wake(uint8_t(t.id));
+  else t.slice = 0;
+}
+
+// Loop with 100 us of other work per pass
+static void loopFor(Scheduler& s, uint32_t us) {
+  const uint64_t end = host::nowUs() + us;
+  while (host::nowUs() < end) {
+    s.run();
+    host::advanceUs(100);
+  }
+}
+
+TEST(selfWakeRunsOnTheNextPass) {
+  host::reset();
+  Scheduler s;
+  sched = &s;
+  SlicedTask flush;
+  flush.id = s.addTask("flush", runSlice, &flush, 2, 20000, 1000);
+  loopFor(s, 30000);
+
+  CHECK_EQ(flush.starts, 8);                 // two frames of 4 slices
+  for (uint8_t i = 1; i < 4; ++i) CHECK_NEAR(flush.startUs[i] - flush.startUs[i - 1], 1100, 1); // next pass
+  CHECK(flush.startUs[3] < 4000);            // whole frame out within 4 ms, not 60
+  CHECK_NEAR(flush.startUs[4], flush.startUs[3] + 20000, 100); // period restarts from the last wake
+  for (uint8_t i = 5; i < 8; ++i) CHECK_NEAR(flush.startUs[i] - flush.startUs[i - 1], 1100, 1);
+  CHECK(s.getStats(uint8_t(flush.id)).maxLatencyUs <= 100);
+}
+
+// Burn the task's budget on the virtual clock
+static void spin(void* ctx) { host::advanceUs(*static_cast<uint32_t*>(ctx)); }
+
+TEST(latencyBoundCountsEqualPriorityAhead) {
+  host::reset();
+  Scheduler s;
+  uint32_t valvesUs = 500, seqUs = 200, uiUs = 3000;
+  const int8_t valves = s.addTask("valves", spin, &valvesUs, 0, 10000, valvesUs);
+  const int8_t seq    = s.addTask("seq",    spin, &seqUs,    0, 10000, seqUs);
+  const int8_t ui     = s.addTask("ui",     spin, &uiUs,     1, 10000, uiUs);
+
+  CHECK_EQ(s.getLatencyBoundUs(uint8_t(valves)), uiUs);                  // ui may be running
+  CHECK_EQ(s.getLatencyBoundUs(uint8_t(seq)), uiUs + valvesUs);          // valves ranks ahead
+  CHECK_EQ(s.getLatencyBoundUs(uint8_t(ui)), valvesUs + valvesUs + seqUs);
+
+  // All due together: seq starts after valves, within its bound
+  s.run();
+  CHECK_EQ(s.getStats(uint8_t(seq)).maxLatencyUs, valvesUs);
+  CHECK(s.getStats(uint8_t(seq)).maxLatencyUs <= s.getLatencyBoundUs(uint8_t(seq)));
+  CHECK(s.getStats(uint8_t(ui)).maxLatencyUs <= s.getLatencyBoundUs(uint8_t(ui)));
+}
+
+HOST_TEST_MAIN("scheduler")
@@ -0,0 +1,176 @@
+// Coroutine valve sequences on the virtual clock (built as C++20, see Makefile).
+#include "HostTest.h"
+#include "Sequence.h"
+
+using namespace std::chrono_literals;
+
+static const uint16_t CYCLE_MS = 3500;
+
+struct Move { uint32_t ms; uint8_t zone; bool open; };
+
+static Move    moves[32];
+static uint8_t moveCount;
+
+static void onTransition(void* ctx, Valve& valve) {
+  // Called at move start and at pulse end: keep the starts only
+  if (valve.isInTransition() && moveCount < 32) moves[moveCount++] = { uint32_t(millis()), uint8_t((uintptr_t)ctx), valve.getState() };
+}
+
+static Sequence zoneProgram(Valve& zone1, Valve& zone2) {
+  co_await seq::open(zone1);
+  co_await seq::sleep_for(10min);
+  co_await seq::close(zone1);
+  co_await seq::sleep_for(2s);
+  co_await seq::open(zone2);
+  co_await seq::sleep_for(5min);
+  co_await seq::close(zone2);
+}
+
+static Sequence waitForever() {
+  co_await seq::sleep_for(24h);
+}
+
+// The sketch's loop: valves and executor serviced every 10 ms
+static void runMs(SequenceExecutor& executor, Valve& a, Valve& b, uint32_t ms) {
+  for (uint32_t t = 0; t < ms; t += 10) {
+    host::advanceMs(10);
+    a.update();
+    b.update();
+    executor.run(millis());
+  }
+}
+
+static void setUp(Valve& a, Valve& b) {
+  moveCount = 0;
+  a.setAutoCycle(false);
+  b.setAutoCycle(false);
+  a.setTransitionHandler(&onTransition, (void*)1);
+  b.setTransitionHandler(&onTransition, (void*)2);
+}
+
+static void checkMove(uint8_t i, uint32_t ms, uint8_t zone, bool open) {
+  CHECK(i < moveCount);
+  if (i >= moveCount) return;
+  CHECK_EQ(moves[i].ms, ms);
+  CHECK_EQ(moves[i].zone, zone);
+  CHECK_EQ(moves[i].open, open);
+}
+
+TEST(zoneProgramTimeline) {
+  host::reset();
+  Valve zone1(1, 1, CYCLE_MS, 12, 13, VALVE_NO_PIN);
+  Valve zone2(1, 1, CYCLE_MS, 14, 15, VALVE_NO_PIN);
+  setUp(zone1, zone2);
+  SequenceExecutor executor;
+
+  CHECK(executor.start(zoneProgram(zone1, zone2)));
+  CHECK_EQ(SequencePool::getInUse(), 1);
+  runMs(executor, zone1, zone2, 20 * 60000UL);
+
+  // Each await resumes on the first pass after the move ends (3.5 s) or the sleep expires
+  CHECK_EQ(moveCount, 4);
+  checkMove(0, 10, 1, true);
+  checkMove(1, 10 + CYCLE_MS + 600000, 1, false);
+  checkMove(2, 10 + 2 * CYCLE_MS + 602000, 2, true);
+  checkMove(3, 10 + 3 * CYCLE_MS + 902000, 2, false);
+  CHECK_EQ(executor.getActiveCount(), 0);
+  CHECK_EQ(executor.getCompletedCount(), 1u);
+  CHECK_EQ(SequencePool::getInUse(), 0);
+  CHECK(!zone1.getState() && !zone2.getState());
+}
+
+TEST(busyValveIsRequestedAgainAfterItsMove) {
+  host::reset();
+  Valve zone1(1, 1, CYCLE_MS, 12, 13, VALVE_NO_PIN);
+  Valve zone2(1, 1, CYCLE_MS, 14, 15, VALVE_NO_PIN);
+  setUp(zone1, zone2);
+  SequenceExecutor executor;
+
+  zone1.requestOpen();                          // e.g. from the menu: zone 1 is mid-move
+  host::advanceMs(1000);
+  CHECK(executor.start(zoneProgram(zone1, zone2)));
+  runMs(executor, zone1, zone2, 5000);
+
+  // Opening an open valve is accepted at once, so the await ends with that move
+  CHECK_EQ(moveCount, 1);
+  checkMove(0, 0, 1, true);
+  CHECK(zone1.getState() && !zone1.isInTransition());
+
+  zone1.requestClose();                         // now busy the other way round
+  const uint32_t busyUntil = millis() + CYCLE_MS;
+  executor.cancelAll();
+  CHECK(executor.start(zoneProgram(zone1, zone2)));
+  runMs(executor, zone1, zone2, 10000);
+  CHECK_EQ(moveCount, 3);
+  CHECK(moves[2].ms >= busyUntil && moves[2].ms <= busyUntil + 20);  // retried on the pass after the close ended
+  CHECK_EQ(moves[2].open, true);
+  executor.cancelAll();
+}
+
+TEST(readinessCheckDoesNotActuate) {
+  host::reset();
+  Valve zone1(1, 1, CYCLE_MS, 12, 13, VALVE_NO_PIN);
+  Valve zone2(1, 1, CYCLE_MS, 14, 15, VALVE_NO_PIN);
+  setUp(zone1, zone2);
+  SequenceExecutor executor;
+
+  zone1.requestOpen();
+  CHECK(executor.start(zoneProgram(zone1, zone2)));
+  executor.run(millis());                       // first await: valve busy, request refused
+  CHECK_EQ(moveCount, 1);
+  host::advanceMs(CYCLE_MS);
+  zone1.update();                               // move over; only run() may issue the retry
+  CHECK(!zone1.isInTransition());
+  CHECK_EQ(moveCount, 1);
+  executor.run(millis());
+  CHECK_EQ(moveCount, 1);                       // already open: accepted, nothing to move
+  executor.cancelAll();
+}
+
+TEST(poolRefusesWhenFullAndFreesOnCancel) {
+  host::reset();
+  SequenceExecutor executor;
+  const uint32_t failuresBefore = SequencePool::getFailures();
+
+  for (int i = 0; i < SEQUENCE_MAX_FRAMES; ++i) CHECK(executor.start(waitForever()));
+  CHECK_EQ(SequencePool::getInUse(), SEQUENCE_MAX_FRAMES);
+  CHECK(!executor.start(waitForever()));
+  CHECK_EQ(SequencePool::getFailures(), failuresBefore + 1);
+  CHECK(SequencePool::getLargestRequest() <= SEQUENCE_FRAME_BYTES);
+
+  executor.run(0);
+  executor.cancelAll();
+  CHECK_EQ(SequencePool::getInUse(), 0);
+  CHECK_EQ(executor.getActiveCount(), 0);
+  CHECK(executor.start(waitForever()));         // slots are reusable
+  executor.cancelAll();
+}
+
+static Sequence child(int* ran) {
+  ++*ran;
+  co_return;
+}
+
+static Sequence parent(SequenceExecutor& executor, int* ran) {
+  executor.start(child(ran));
+  co_return;
+}
+
+// The head sequence starts another and finishes in the same resume: the new one stays linked
+TEST(startFromFinishingHeadKeepsTheNewSequence) {
+  host::reset();
+  SequenceExecutor executor;
+  const uint32_t completedBefore = executor.getCompletedCount();
+  int ran = 0;
+  CHECK(executor.start(parent(executor, &ran)));
+  executor.run(0);
+  CHECK_EQ(ran, 0);                              // waits for the next pass
+  CHECK_EQ(executor.getActiveCount(), 1);
+  executor.run(10);
+  CHECK_EQ(ran, 1);
+  CHECK_EQ(executor.getActiveCount(), 0);
+  CHECK_EQ(executor.getCompletedCount(), completedBefore + 2);
+  CHECK_EQ(SequencePool::getInUse(), 0);         // both frames back in the pool
+}
+
+HOST_TEST_MAIN("sequence")
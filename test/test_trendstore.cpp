@@ -0,0 +1,112 @@
+// Trend tiers: minutes roll into hours and days, gaps keep age = time.
+#include "HostTest.h"
+#include "TrendStore.h"
+
+static const uint32_t MINUTE_MS = 60000UL, HOUR_MS = 60 * MINUTE_MS, DAY_MS = 24 * HOUR_MS;
+
+static TrendStore::Bucket bucket(const TrendStore& store, TrendStore::Tier tier, uint8_t age) {
+  TrendStore::Bucket b = { 0, 0, 0, 0xFFFF };
+  CHECK(store.getBucket(tier, age, b));
+  return b;
+}
+
+// One sample every 10 s for a day, value = hour of day: each tier sees whole hours
+TEST(rollsMinutesIntoHoursAndDays) {
+  TrendStore store;
+  store.begin(0);
+  for (uint32_t t = 0; t < DAY_MS; t += 10000) store.add(int32_t(t / HOUR_MS), t);
+
+  CHECK_EQ(store.getCount(TrendStore::Tier::Raw), TREND_RAW_SAMPLES);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Minute), TREND_MINUTES);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Hour), 23);  // 23:00 still open
+  CHECK_EQ(store.getCount(TrendStore::Tier::Day), 0);
+  TrendStore::Bucket b = bucket(store, TrendStore::Tier::Minute, 0);  // 23:58
+  CHECK_EQ(b.count, 6);
+  CHECK_EQ(b.mean, 23);
+  CHECK_EQ(store.getOpen(TrendStore::Tier::Hour).count, 59 * 6 + 6);
+
+  store.add(0, DAY_MS);                                  // closes 23:59, 23:00 and the day
+  CHECK_EQ(store.getCount(TrendStore::Tier::Hour), 24);
+  b = bucket(store, TrendStore::Tier::Hour, 5);          // 18:00
+  CHECK_EQ(b.count, 360);
+  CHECK_EQ(b.min, 18);
+  CHECK_EQ(b.max, 18);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Day), 1);
+  b = bucket(store, TrendStore::Tier::Day, 0);
+  CHECK_EQ(b.count, 24 * 360);
+  CHECK_EQ(b.min, 0);
+  CHECK_EQ(b.max, 23);
+  CHECK_EQ(b.mean, 12);                                  // 11.5 rounded away from zero
+  CHECK_EQ(store.getOpen(TrendStore::Tier::Day).count, 1);
+}
+
+// 2.5 h without samples: the sample's hour is where the clock says, the open hour is half done
+TEST(gapWithinADay) {
+  TrendStore store;
+  store.begin(0);
+  for (uint32_t t = 0; t < MINUTE_MS; t += 10000) store.add(10, t);
+  const uint32_t minuteRev = store.getRevision(TrendStore::Tier::Minute);
+  store.add(20, 150 * MINUTE_MS + 1000);
+
+  CHECK_EQ(store.getRevision(TrendStore::Tier::Minute), minuteRev + 150);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Minute), TREND_MINUTES);
+  for (uint8_t age = 0; age < TREND_MINUTES; ++age) CHECK_EQ(bucket(store, TrendStore::Tier::Minute, age).count, 0);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Hour), 2);
+  CHECK_EQ(bucket(store, TrendStore::Tier::Hour, 0).count, 0);   // 01:00
+  TrendStore::Bucket b = bucket(store, TrendStore::Tier::Hour, 1); // 00:00
+  CHECK_EQ(b.count, 6);
+  CHECK_EQ(b.mean, 10);
+  CHECK_EQ(store.getOpen(TrendStore::Tier::Hour).count, 1);
+
+  store.add(30, 3 * HOUR_MS);                            // closes 02:00 after 30 more minutes
+  CHECK_EQ(store.getCount(TrendStore::Tier::Hour), 3);
+  b = bucket(store, TrendStore::Tier::Hour, 0);
+  CHECK_EQ(b.count, 1);
+  CHECK_EQ(b.mean, 20);
+}
+
+// 3 days 5.5 h without samples: every tier moves by the gap (it used to stop at one day)
+TEST(gapOfSeveralDays) {
+  TrendStore store;
+  store.begin(0);
+  store.add(5, 0);
+  const uint32_t hourRev = store.getRevision(TrendStore::Tier::Hour);
+  const uint32_t dayRev  = store.getRevision(TrendStore::Tier::Day);
+  store.add(7, 3 * DAY_MS + 5 * HOUR_MS + 30 * MINUTE_MS);
+
+  CHECK_EQ(store.getRevision(TrendStore::Tier::Hour), hourRev + 3 * 24 + 5);
+  CHECK_EQ(store.getRevision(TrendStore::Tier::Day), dayRev + 3);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Hour), TREND_HOURS);
+  for (uint8_t age = 0; age < TREND_HOURS; ++age) CHECK_EQ(bucket(store, TrendStore::Tier::Hour, age).count, 0);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Day), 3);
+  CHECK_EQ(bucket(store, TrendStore::Tier::Day, 0).count, 0);
+  CHECK_EQ(bucket(store, TrendStore::Tier::Day, 1).count, 0);
+  TrendStore::Bucket b = bucket(store, TrendStore::Tier::Day, 2);
+  CHECK_EQ(b.count, 1);
+  CHECK_EQ(b.mean, 5);
+
+  // The open day is 5.5 h in: 18.5 h more closes it with just the new sample
+  store.add(9, 4 * DAY_MS);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Day), 4);
+  b = bucket(store, TrendStore::Tier::Day, 0);
+  CHECK_EQ(b.count, 1);
+  CHECK_EQ(b.mean, 7);
+  CHECK_EQ(bucket(store, TrendStore::Tier::Hour, 18).count, 1);   // 05:00 of day 3, 19 hours back
+}
+
+// Longer than the day ring: only the last TREND_DAYS empty days are kept, the ring stays aligned
+TEST(gapLongerThanEveryRing) {
+  TrendStore store;
+  store.begin(0);
+  store.add(1, 0);
+  store.add(2, 45 * DAY_MS + 10);
+  CHECK_EQ(store.getCount(TrendStore::Tier::Day), TREND_DAYS);
+  for (uint8_t age = 0; age < TREND_DAYS; ++age) CHECK_EQ(bucket(store, TrendStore::Tier::Day, age).count, 0);
+  store.add(3, 46 * DAY_MS);
+  TrendStore::Bucket b = bucket(store, TrendStore::Tier::Day, 0);
+  CHECK_EQ(b.count, 1);
+  CHECK_EQ(b.mean, 2);
+  CHECK_EQ(bucket(store, TrendStore::Tier::Day, 1).count, 0);
+}
+
+HOST_TEST_MAIN("trendstore")
@@ -0,0 +1,158 @@
+// Travel learning and supervision against a simulated motorised valve.
+#include "HostTest.h"
+#include "ValveModel.h"
+
+static const uint8_t OPEN_PIN = 12, CLOSE_PIN = 13, LED_PIN = 2, OPEN_LIMIT = 34, CLOSED_LIMIT = 35;
+
+static void cycle(Valve& valve, ValveModel& model) {
+  valve.requestOpen();
+  runMove(valve, model);
+  valve.requestClose();
+  runMove(valve, model);
+}
+
+TEST(learnsTravelFromLimits) {
+  host::reset();
+  Valve valve(1, 1, 5000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  valve.setLimitPins(OPEN_LIMIT, CLOSED_LIMIT);
+  valve.setAutoCycle(false);
+  ValveModel model(OPEN_PIN, CLOSE_PIN, OPEN_LIMIT, CLOSED_LIMIT, 2000);
+
+  cycle(valve, model);
+  CHECK(model.isFullyClosed());
+  CHECK_NEAR(valve.getLearnedTravelTime(true), 2000, 5);
+  CHECK_NEAR(valve.getLearnedTravelTime(false), 2000, 5);
+  CHECK(valve.getFault() == Valve::Fault::None);
+  CHECK_EQ(host::pinLevel(OPEN_PIN), LOW);
+  CHECK_EQ(host::pinLevel(CLOSE_PIN), LOW);
+}
+
+TEST(alreadyAtStopIsNotLearned) {
+  host::reset();
+  Valve valve(1, 1, 5000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  valve.setLimitPins(OPEN_LIMIT, CLOSED_LIMIT);
+  valve.setAutoCycle(false);
+  ValveModel model(OPEN_PIN, CLOSE_PIN, OPEN_LIMIT, CLOSED_LIMIT, 2000);
+  model.placeOpen();              // cold boot: the valve was left open, the sketch thinks closed
+
+  valve.requestOpen();
+  CHECK(runMove(valve, model) < 5);
+  CHECK_EQ(valve.getLearnedTravelTime(true), 0);
+
+  for (int i = 0; i < 3; ++i) cycle(valve, model);
+  CHECK_NEAR(valve.getLearnedTravelTime(true), 2000, 5);
+  CHECK_NEAR(valve.getLearnedTravelTime(false), 2000, 5);
+  CHECK(valve.getFault() == Valve::Fault::None);
+}
+
+TEST(chatterBelowFloorIsNotLearned) {
+  host::reset();
+  Valve valve(1, 1, 5000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  valve.setLimitPins(OPEN_LIMIT, CLOSED_LIMIT);
+  valve.setAutoCycle(false);
+  ValveModel model(OPEN_PIN, CLOSE_PIN, OPEN_LIMIT, CLOSED_LIMIT, 2000);
+
+  valve.requestOpen();
+  for (int ms = 0; ms < 10; ++ms) { host::advanceMs(1); model.step(1000); valve.update(); }
+  host::setInput(OPEN_LIMIT, LOW);  // switch bounce 10 ms into the move
+  host::advanceMs(1);
+  valve.update();
+  CHECK(!valve.isInTransition());
+  CHECK_EQ(valve.getLearnedTravelTime(true), 0);
+}
+
+TEST(slowerValveIsRelearned) {
+  host::reset();
+  Valve valve(1, 1, 8000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  valve.setLimitPins(OPEN_LIMIT, CLOSED_LIMIT);
+  valve.setAutoCycle(false);
+  ValveModel model(OPEN_PIN, CLOSE_PIN, OPEN_LIMIT, CLOSED_LIMIT, 2000);
+  cycle(valve, model);
+  CHECK_NEAR(valve.getLearnedTravelTime(true), 2000, 5);
+
+  model.setTravelMs(4000);          // gearbox wear: twice as slow from now on
+  cycle(valve, model);
+  CHECK(valve.getFault() == Valve::Fault::Slow);
+  CHECK(valve.getLearnedTravelTime(true) > 2000);
+  CHECK(valve.getLearnedTravelTime(true) <= 2000 + 2000 / 8 + 1);
+
+  for (int i = 0; i < 20; ++i) cycle(valve, model);
+  CHECK_NEAR(valve.getLearnedTravelTime(true), 4000, 150);
+  CHECK_NEAR(valve.getLearnedTravelTime(false), 4000, 150);
+
+  valve.clearFault();
+  cycle(valve, model);
+  CHECK(valve.getFault() == Valve::Fault::None);
+}
+
+TEST(stuckValveEndsAtCycleTime) {
+  host::reset();
+  Valve valve(1, 1, 3000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  valve.setLimitPins(OPEN_LIMIT, CLOSED_LIMIT);
+  valve.setAutoCycle(false);
+  ValveModel model(OPEN_PIN, CLOSE_PIN, OPEN_LIMIT, CLOSED_LIMIT, 60000);
+
+  valve.requestOpen();
+  CHECK_NEAR(runMove(valve, model), 3000, 2);
+  CHECK(valve.getFault() == Valve::Fault::Stuck);
+  CHECK_EQ(valve.getLearnedTravelTime(true), 0);
+  CHECK_EQ(host::pinLevel(OPEN_PIN), LOW);
+}
+
+// The sketch's input task: limits sampled into the scanner, scanned every 12.5 ms
+static const uint32_t SCAN_US = 12500;
+
+static uint32_t runScannedMove(Valve& valve, ValveModel& model, InputScanner& inputs, uint32_t glitchAtMs = 0) {
+  uint32_t ms = 0, sinceScanUs = 0;
+  do {
+    host::advanceMs(1);
+    model.step(1000);
+    if (glitchAtMs && ms >= glitchAtMs && ms < glitchAtMs + 3) host::setInput(OPEN_LIMIT, LOW); // motor noise
+    uint32_t bank1 = 0xFFFFFFFF;
+    if (digitalRead(OPEN_LIMIT) == LOW)   bank1 &= ~(1UL << (OPEN_LIMIT - 32));
+    if (digitalRead(CLOSED_LIMIT) == LOW) bank1 &= ~(1UL << (CLOSED_LIMIT - 32));
+    inputs.setMockInputs(0xFFFFFFFF, bank1);
+    if ((sinceScanUs += 1000) >= SCAN_US) { inputs.scan(); sinceScanUs -= SCAN_US; }
+    valve.update();
+  } while (valve.isInTransition() && ++ms < 10000);
+  return ms;
+}
+
+TEST(debouncedLimitsIgnoreGlitches) {
+  host::reset();
+  InputScanner inputs;
+  Valve valve(1, 1, 5000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  valve.setLimitPins(inputs, OPEN_LIMIT, CLOSED_LIMIT);
+  valve.setAutoCycle(false);
+  ValveModel model(OPEN_PIN, CLOSE_PIN, OPEN_LIMIT, CLOSED_LIMIT, 2000);
+  CHECK(inputs.getInputMask() == ((1ULL << OPEN_LIMIT) | (1ULL << CLOSED_LIMIT)));
+  runScannedMove(valve, model, inputs);         // first scans adopt the closed stop
+
+  valve.requestOpen();
+  const uint32_t ms = runScannedMove(valve, model, inputs, 800);
+  CHECK(model.isFullyOpen());                   // a 3 ms blip mid-travel did not end the pulse
+  CHECK(ms >= 2000 && ms <= 2000 + 5 * SCAN_US / 1000);   // stop seen 4 scans after contact
+  CHECK(valve.getFault() == Valve::Fault::None);
+  CHECK_NEAR(valve.getLearnedTravelTime(true), 2000 + 2 * SCAN_US / 1000, 3 * SCAN_US / 1000);
+  CHECK_EQ(host::pinLevel(OPEN_PIN), LOW);
+
+  valve.requestClose();
+  runScannedMove(valve, model, inputs);
+  CHECK(model.isFullyClosed());
+  CHECK(inputs.isActive(CLOSED_LIMIT) && !inputs.isActive(OPEN_LIMIT));
+}
+
+TEST(rawLimitsEndOnAGlitch) {
+  host::reset();
+  InputScanner unused;
+  Valve valve(1, 1, 5000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  valve.setLimitPins(OPEN_LIMIT, CLOSED_LIMIT);  // digitalRead(): what the scanner is for
+  valve.setAutoCycle(false);
+  ValveModel model(OPEN_PIN, CLOSE_PIN, OPEN_LIMIT, CLOSED_LIMIT, 2000);
+
+  valve.requestOpen();
+  CHECK(runScannedMove(valve, model, unused, 800) < 1000);
+  CHECK(!model.isFullyOpen());
+}
+
+HOST_TEST_MAIN("valve")
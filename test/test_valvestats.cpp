@@ -0,0 +1,80 @@
+// Rolling valve statistics: hourly buckets, open periods split at the hour, gaps past the window.
+#include "HostTest.h"
+#include "ValveStats.h"
+
+static const uint32_t MINUTE_MS = 60000UL, HOUR_MS = 60 * MINUTE_MS;
+
+// Open 00:50..01:10: ten minutes in each hour; the cycle stays with the hour it opened in
+TEST(openPeriodAcrossAnHour) {
+  ValveStats stats;
+  stats.begin(0);
+  stats.recordOpen(50 * MINUTE_MS);
+  CHECK_EQ(stats.getOpenSecondsLast24h(65 * MINUTE_MS), 15u * 60);   // live, across the boundary
+  stats.recordClose(70 * MINUTE_MS);
+
+  CHECK_EQ(stats.getOpenSecondsLast24h(80 * MINUTE_MS), 20u * 60);
+  CHECK_EQ(stats.getCyclesLast24h(80 * MINUTE_MS), 1);
+  CHECK_EQ(stats.getTotalOpenMinutes(80 * MINUTE_MS), 20u);
+
+  // 24:30: the window is 01:00..24:30, hour 00 and its cycle have left, 01:00's ten minutes stay
+  CHECK_EQ(stats.getOpenSecondsLast24h(24 * HOUR_MS + 30 * MINUTE_MS), 10u * 60);
+  CHECK_EQ(stats.getCyclesLast24h(24 * HOUR_MS + 30 * MINUTE_MS), 0);
+  CHECK_EQ(stats.getOpenSecondsLast24h(25 * HOUR_MS), 0u);
+  CHECK_EQ(stats.getTotalOpenMinutes(25 * HOUR_MS), 20u);
+  CHECK_EQ(stats.getTotalCycles(), 1u);
+}
+
+// 30 h with no transition while open: the hours before the window are booked in one go
+TEST(openThroughAGapLongerThanTheWindow) {
+  ValveStats stats;
+  stats.begin(0);
+  stats.recordOpen(30 * MINUTE_MS);
+  const uint32_t now = 30 * HOUR_MS + 15 * MINUTE_MS;
+
+  CHECK_EQ(stats.getOpenSecondsLast24h(now), 23u * 3600 + 15 * 60);  // 23 full hours + 15 min
+  CHECK_EQ(stats.getDutyPercentLast24h(now), 100);
+  CHECK_EQ(stats.getCyclesLast24h(now), 0);
+  CHECK_EQ(stats.getTotalOpenMinutes(now), 29u * 60 + 45);
+  CHECK_EQ(stats.getLifetimeDutyPercent(now), 98);                  // 29:45 of 30:15
+
+  stats.recordClose(now);
+  CHECK_EQ(stats.getOpenSecondsLast24h(now + 24 * HOUR_MS), 0u);
+  CHECK_EQ(stats.getTotalOpenMinutes(now + 24 * HOUR_MS), 29u * 60 + 45);
+}
+
+// Closed through the gap: nothing left in the window, the lifetime totals keep the old hour
+TEST(closedThroughAGapLongerThanTheWindow) {
+  ValveStats stats;
+  stats.begin(0);
+  stats.recordOpen(0);
+  stats.recordClose(30 * MINUTE_MS);
+  const uint32_t now = 50 * HOUR_MS;
+
+  CHECK_EQ(stats.getOpenSecondsLast24h(now), 0u);
+  CHECK_EQ(stats.getCyclesLast24h(now), 0);
+  CHECK_EQ(stats.getDutyPercentLast24h(now), 0);
+  CHECK_EQ(stats.getTotalOpenMinutes(now), 30u);
+  CHECK_EQ(stats.getLifetimeDutyPercent(now), 1);                   // 30 min of 50 h
+  stats.recordOpen(now);
+  CHECK_EQ(stats.getCyclesLast24h(now + MINUTE_MS), 1);
+  CHECK_EQ(stats.getTotalCycles(), 2u);
+}
+
+// Duty counts the running open period over the span tracked so far
+TEST(dutyWhileOpen) {
+  ValveStats stats;
+  stats.begin(0);
+  stats.recordOpen(0);
+  CHECK_EQ(stats.getDutyPercentLast24h(30 * MINUTE_MS), 100);
+  stats.recordClose(30 * MINUTE_MS);
+  CHECK_EQ(stats.getDutyPercentLast24h(60 * MINUTE_MS), 50);
+  stats.recordOpen(60 * MINUTE_MS);
+  CHECK_EQ(stats.getDutyPercentLast24h(90 * MINUTE_MS), 66);          // 30 + 30 live of 90
+  CHECK_EQ(stats.getLifetimeDutyPercent(90 * MINUTE_MS), 66);
+
+  // A full day later, still open: the window is full and open throughout
+  CHECK_EQ(stats.getDutyPercentLast24h(25 * HOUR_MS + 30 * MINUTE_MS), 100);
+  CHECK_EQ(stats.getOpenSecondsLast24h(25 * HOUR_MS + 30 * MINUTE_MS), 23u * 3600 + 30 * 60);
+}
+
+HOST_TEST_MAIN("valvestats")
@@ -0,0 +1,95 @@
+// Warm restart through the host's WARM_STATE_FILE: save on one "boot", restore on the next.
+#include <stdio.h>
+#include "HostTest.h"
+#include "FlowMeter.h"
+#include "WarmState.h"
+
+static const uint8_t OPEN_PIN = 12, CLOSE_PIN = 13, LED_PIN = 2, METER_PIN = 27;
+
+static void meterPulses(uint32_t count) {
+  for (uint32_t i = 0; i < count; ++i) host::fireInterrupt(METER_PIN);
+}
+
+// First boot: cold start, valve opens after its closed time, 2 L flow, checkpoint, reset
+static void firstBoot() {
+  remove(WARM_STATE_FILE);
+  host::reset();
+  Valve valve(2, 1, 3000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  FlowMeter meter(METER_PIN, 450);
+  meter.begin();
+  valve.setFlowMeter(&meter, 3000);
+  WarmState warmState;
+  warmState.track(valve);
+  CHECK(!warmState.restore());
+
+  valve.update();
+  host::advanceMs(60000);
+  valve.update();                       // closed time over: opens
+  host::advanceMs(3000);
+  valve.update();                       // pulse over
+  CHECK(valve.getState());
+  CHECK(!valve.isInTransition());
+  meterPulses(900);                     // 2 L
+  warmState.save();
+  CHECK_EQ(valve.getDispensedVolume(), 2000u);
+}
+
+TEST(roundTripResumesOpenValve) {
+  firstBoot();
+
+  // Second boot: globals constructed before setup(), then restore() in setup()
+  host::reset();
+  Valve valve(2, 1, 3000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  FlowMeter meter(METER_PIN, 450);
+  WarmState warmState;
+  CHECK_EQ(host::pinWrites(LED_PIN), 0);   // construction leaves the pins alone
+  CHECK_EQ(host::pinWrites(OPEN_PIN), 0);
+
+  meter.begin();
+  valve.setFlowMeter(&meter, 3000);
+  warmState.track(valve);
+  CHECK(warmState.restore());
+
+  CHECK(valve.getState());
+  CHECK(!valve.isInTransition());       // open latching valve: not pulsed again
+  CHECK_EQ(host::pinModeOf(LED_PIN), OUTPUT);
+  CHECK_EQ(host::pinLevel(LED_PIN), HIGH);
+  CHECK_EQ(host::pinWrites(LED_PIN), 1);   // straight to HIGH, no LOW first
+  CHECK_EQ(host::pinLevel(OPEN_PIN), LOW);
+  CHECK_EQ(host::pinModeOf(OPEN_PIN), OUTPUT);
+  CHECK_EQ(valve.getDispensedVolume(), 2000u);  // meter restarted at 0, volume carried over
+  CHECK_NEAR(valve.getRemainingTime(), 117, 2); // 3 s into the 2 min open phase (+ real downtime)
+
+  // 1 L more reaches the 3 L close volume
+  meterPulses(450);
+  valve.update();
+  CHECK(!valve.getState());
+  CHECK(valve.isInTransition());
+  CHECK_EQ(host::pinLevel(CLOSE_PIN), HIGH);
+  CHECK_EQ(host::pinLevel(LED_PIN), LOW);
+}
+
+TEST(damagedFileIsAColdStart) {
+  firstBoot();
+  if (FILE* f = fopen(WARM_STATE_FILE, "r+b")) {   // flip a bit inside the block
+    fseek(f, 8, SEEK_SET);
+    const int c = fgetc(f);
+    fseek(f, 8, SEEK_SET);
+    fputc(c ^ 0x01, f);
+    fclose(f);
+  }
+
+  host::reset();
+  Valve valve(2, 1, 3000, OPEN_PIN, CLOSE_PIN, LED_PIN);
+  WarmState warmState;
+  warmState.track(valve);
+  CHECK(!warmState.restore());
+  CHECK(!valve.getState());
+  CHECK_EQ(warmState.getMenuIndex(), 0);
+  valve.update();                       // first service configures the pins, LED off
+  CHECK_EQ(host::pinModeOf(LED_PIN), OUTPUT);
+  CHECK_EQ(host::pinLevel(LED_PIN), LOW);
+  remove(WARM_STATE_FILE);
+}
+
+HOST_TEST_MAIN("warmstate")